@@ -0,0 +1,560 @@
+/**
+ * @file bplus_tree.hpp
+ * @author Ivan Penev
+ * @brief Page based on-disk B+-tree ordered set
+ * @date 2026-10-18
+ *
+ * Same surface as ds::BST (insert / remove / contains), but the nodes are
+ * fixed-size pages of a local file cached by a BufferPool, so the set can be
+ * larger than memory and is available again right after reopening the file.
+ *
+ * File layout: page 0 holds the meta data, every other page is a node.
+ *   leaf:  header | keys[LEAF_CAPACITY]                    , next = right sibling
+ *   inner: header | keys[INNER_CAPACITY] | children[INNER_CAPACITY + 1]
+ * Child i of an inner node holds the keys in [keys[i - 1], keys[i]).
+ *
+ * Removal does not merge underfull nodes (empty leaves simply stay in the leaf
+ * chain); a bulkLoad() into a fresh file rebuilds a compact tree.
+ */
+
+#ifndef BPLUS_TREE_HPP_GUARD_
+#define BPLUS_TREE_HPP_GUARD_
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>   // Exception handling
+#include <string>
+#include <type_traits> // Keys are stored as raw bytes
+#include <vector>
+
+#include "buffer_pool.hpp"
+
+namespace ds
+{
+    template <typename KeyType>
+    class BPlusTree
+    {
+        static_assert(std::is_trivially_copyable<KeyType>::value,
+                      "BPlusTree: keys are stored as raw bytes and must be trivially copyable");
+
+    private:
+        static const uint64_t MAGIC = 0x45455254534b5344ull; // "DSKSTREE"
+        static const uint32_t NO_PAGE = 0;                   // page 0 is the meta page
+
+        struct Meta
+        {
+            uint64_t magic;
+            uint32_t keySize;
+            uint32_t root;
+            uint32_t height; // 0 - empty tree, 1 - root is a leaf
+            uint32_t firstLeaf;
+            uint64_t count;
+        };
+
+        struct Header
+        {
+            uint16_t leaf;
+            uint16_t count;
+            uint32_t next;
+        };
+
+        static const size_t PAGE_SIZE = BufferPool::PAGE_SIZE;
+        static const size_t HEADER_SIZE = sizeof(Header);
+
+    public:
+        static const size_t LEAF_CAPACITY = (PAGE_SIZE - HEADER_SIZE) / sizeof(KeyType);
+        static const size_t INNER_CAPACITY = (PAGE_SIZE - HEADER_SIZE - sizeof(uint32_t)) / (sizeof(KeyType) + sizeof(uint32_t));
+
+        static_assert(INNER_CAPACITY >= 3, "BPlusTree: key type is too large for a page");
+
+        /**
+         * @brief Opens the tree stored in the file or creates an empty one
+         *
+         * @param path - local file
+         * @param cachedPages - size of the buffer pool in pages
+         * @throws std::runtime_error when the file holds something else
+         */
+        explicit BPlusTree(const std::string &path, size_t cachedPages = 1024)
+            : pool(path, std::max<size_t>(cachedPages, 16))
+        {
+            if (pool.pageCount() == 0)
+            {
+                pool.allocate(); // the meta page
+                meta = Meta{MAGIC, (uint32_t)sizeof(KeyType), NO_PAGE, 0, NO_PAGE, 0};
+                writeMeta();
+            }
+            else
+            {
+                BufferPool::PageHandle page = pool.fetch(0);
+                std::memcpy(&meta, page.data(), sizeof(Meta));
+
+                if (meta.magic != MAGIC || meta.keySize != sizeof(KeyType))
+                {
+                    throw std::runtime_error("BPlusTree: " + path + " is not a tree with this key type!");
+                }
+            }
+        }
+
+        BPlusTree(const BPlusTree &) = delete;
+        BPlusTree &operator=(const BPlusTree &) = delete;
+
+        ~BPlusTree()
+        {
+            try
+            {
+                writeMeta();
+            }
+            catch (...)
+            {
+                // The pool flushes what it can on its own
+            }
+        }
+
+        /**
+         * @brief Inserts a key
+         * @note Time complexity: O(logN) page accesses
+         * @throws std::logic_error if the key is already in the tree
+         */
+        void insert(const KeyType &key)
+        {
+            if (meta.height == 0)
+            {
+                BufferPool::PageHandle leaf = newNode(true);
+                setKey(leaf, 0, key);
+                header(leaf).count = 1;
+
+                meta.root = meta.firstLeaf = leaf.id();
+                meta.height = 1;
+                meta.count = 1;
+                return;
+            }
+
+            KeyType separator;
+            uint32_t right;
+            if (insert(meta.root, key, separator, right))
+            {
+                // The root was split - grow by one level
+                BufferPool::PageHandle root = newNode(false);
+                setKey(root, 0, separator);
+                setChild(root, 0, meta.root);
+                setChild(root, 1, right);
+                header(root).count = 1;
+
+                meta.root = root.id();
+                ++meta.height;
+            }
+
+            ++meta.count;
+        }
+
+        /**
+         * @brief Removes a key
+         * @note Time complexity: O(logN) page accesses
+         * @throws std::logic_error if the key is not in the tree
+         */
+        void remove(const KeyType &key)
+        {
+            if (meta.height == 0)
+            {
+                throw std::logic_error("BPlusTree: The key is not in the tree!");
+            }
+
+            BufferPool::PageHandle leaf = findLeaf(key);
+            size_t n = header(leaf).count;
+            size_t pos = lowerBound(leaf, n, key);
+
+            if (pos == n || !equal(getKey(leaf, pos), key))
+            {
+                throw std::logic_error("BPlusTree: The key is not in the tree!");
+            }
+
+            std::memmove(keyAddress(leaf, pos), keyAddress(leaf, pos + 1), (n - pos - 1) * sizeof(KeyType));
+            header(leaf).count = (uint16_t)(n - 1);
+            leaf.markDirty();
+
+            --meta.count;
+        }
+
+        /**
+         * @brief Checks whether the key is in the tree
+         * @note Time complexity: O(logN) page accesses
+         */
+        bool contains(const KeyType &key)
+        {
+            if (meta.height == 0)
+                return false;
+
+            BufferPool::PageHandle leaf = findLeaf(key);
+            size_t n = header(leaf).count;
+            size_t pos = lowerBound(leaf, n, key);
+
+            return pos < n && equal(getKey(leaf, pos), key);
+        }
+
+        /**
+         * @brief Visits the keys in [from, to] in ascending order by walking
+         * the leaf chain
+         * @note Time complexity: O(logN + M / LEAF_CAPACITY) page accesses for M keys
+         *
+         * @param visit - called with every key; returning false stops the scan
+         */
+        template <typename Visitor>
+        void scan(const KeyType &from, const KeyType &to, Visitor visit)
+        {
+            if (meta.height == 0)
+                return;
+
+            BufferPool::PageHandle leaf = findLeaf(from);
+            size_t pos = lowerBound(leaf, header(leaf).count, from);
+
+            for (;;)
+            {
+                size_t n = header(leaf).count;
+                for (; pos < n; pos++)
+                {
+                    KeyType key = getKey(leaf, pos);
+                    if (to < key || !visit(key))
+                        return;
+                }
+
+                uint32_t next = header(leaf).next;
+                if (next == NO_PAGE)
+                    return;
+
+                leaf = pool.fetch(next);
+                pos = 0;
+            }
+        }
+
+        /**
+         * @brief Builds the tree bottom-up from sorted keys. Nodes are filled
+         * completely and written sequentially.
+         * @note Time complexity: O(N)
+         * @throws std::logic_error if the tree is not empty or the keys are
+         * not strictly ascending
+         */
+        void bulkLoad(const std::vector<KeyType> &sorted)
+        {
+            if (meta.count != 0 || meta.height != 0)
+            {
+                throw std::logic_error("BPlusTree: Bulk load requires an empty tree!");
+            }
+
+            for (size_t i = 1; i < sorted.size(); i++)
+            {
+                if (!(sorted[i - 1] < sorted[i]))
+                {
+                    throw std::logic_error("BPlusTree: Bulk load requires strictly ascending keys!");
+                }
+            }
+
+            if (sorted.empty())
+                return;
+
+            // (first key, page) of every node of the level being built
+            std::vector<std::pair<KeyType, uint32_t>> level;
+
+            size_t leaves = (sorted.size() + LEAF_CAPACITY - 1) / LEAF_CAPACITY;
+            uint32_t previous = NO_PAGE;
+            for (size_t i = 0, at = 0; i < leaves; i++)
+            {
+                size_t take = share(sorted.size(), leaves, i);
+
+                BufferPool::PageHandle leaf = newNode(true);
+                std::memcpy(keyAddress(leaf, 0), &sorted[at], take * sizeof(KeyType));
+                header(leaf).count = (uint16_t)take;
+                level.push_back({sorted[at], leaf.id()});
+                at += take;
+
+                if (previous == NO_PAGE)
+                    meta.firstLeaf = leaf.id();
+                else
+                    linkLeaf(previous, leaf.id());
+                previous = leaf.id();
+            }
+            meta.height = 1;
+
+            while (level.size() > 1)
+            {
+                std::vector<std::pair<KeyType, uint32_t>> upper;
+                size_t nodes = (level.size() + INNER_CAPACITY) / (INNER_CAPACITY + 1);
+
+                for (size_t i = 0, at = 0; i < nodes; i++)
+                {
+                    size_t take = share(level.size(), nodes, i);
+
+                    BufferPool::PageHandle inner = newNode(false);
+                    for (size_t c = 0; c < take; c++)
+                    {
+                        setChild(inner, c, level[at + c].second);
+                        if (c > 0)
+                            setKey(inner, c - 1, level[at + c].first);
+                    }
+                    header(inner).count = (uint16_t)(take - 1);
+                    upper.push_back({level[at].first, inner.id()});
+                    at += take;
+                }
+
+                level.swap(upper);
+                ++meta.height;
+            }
+
+            meta.root = level.front().second;
+            meta.count = sorted.size();
+        }
+
+        /**
+         * @brief Writes the meta data and every dirty page to disk
+         */
+        void flush()
+        {
+            writeMeta();
+            pool.flush();
+        }
+
+        /**
+         * @brief Returns the number of keys in the tree
+         */
+        size_t size() const { return meta.count; }
+
+        /**
+         * @brief Checks if the tree is empty
+         */
+        bool isEmpty() const { return meta.count == 0; }
+
+        /**
+         * @brief Returns the number of levels (0 for an empty tree)
+         */
+        size_t height() const { return meta.height; }
+
+        //
+        /* Helpers */
+    private:
+        /**
+         * @brief Inserts into the subtree rooted at pageId
+         * @return true if the node was split; separator and right then
+         * describe the new right sibling
+         */
+        bool insert(uint32_t pageId, const KeyType &key, KeyType &separator, uint32_t &right)
+        {
+            BufferPool::PageHandle node = pool.fetch(pageId);
+            size_t n = header(node).count;
+
+            if (header(node).leaf)
+            {
+                size_t pos = lowerBound(node, n, key);
+                if (pos < n && equal(getKey(node, pos), key))
+                {
+                    throw std::logic_error("BPlusTree: This key is already inserted!");
+                }
+
+                if (n < LEAF_CAPACITY)
+                {
+                    insertKey(node, n, pos, key);
+                    return false;
+                }
+
+                // Split in halves, the upper half moves to a new right sibling
+                BufferPool::PageHandle sibling = newNode(true);
+                size_t keep = (n + 1) / 2;
+                std::memcpy(keyAddress(sibling, 0), keyAddress(node, keep), (n - keep) * sizeof(KeyType));
+                header(sibling).count = (uint16_t)(n - keep);
+                header(sibling).next = header(node).next;
+                header(node).count = (uint16_t)keep;
+                header(node).next = sibling.id();
+                node.markDirty();
+
+                if (pos <= keep)
+                    insertKey(node, keep, pos, key);
+                else
+                    insertKey(sibling, n - keep, pos - keep, key);
+
+                separator = getKey(sibling, 0);
+                right = sibling.id();
+                return true;
+            }
+
+            size_t idx = upperBound(node, n, key);
+            KeyType childSeparator;
+            uint32_t childRight;
+            if (!insert(getChild(node, idx), key, childSeparator, childRight))
+                return false;
+
+            if (n < INNER_CAPACITY)
+            {
+                insertSeparator(node, n, idx, childSeparator, childRight);
+                return false;
+            }
+
+            // Full inner node: lay out all n + 1 keys and n + 2 children, keep
+            // the lower half, push the middle key up, move the rest right
+            std::vector<KeyType> keys(n + 1);
+            std::vector<uint32_t> children(n + 2);
+            for (size_t i = 0, j = 0; i < n + 1; i++)
+                keys[i] = i == idx ? childSeparator : getKey(node, j++);
+            for (size_t i = 0, j = 0; i < n + 2; i++)
+                children[i] = i == idx + 1 ? childRight : getChild(node, j++);
+
+            size_t mid = (n + 1) / 2;
+            BufferPool::PageHandle sibling = newNode(false);
+
+            for (size_t i = 0; i < mid; i++)
+                setKey(node, i, keys[i]);
+            for (size_t i = 0; i <= mid; i++)
+                setChild(node, i, children[i]);
+            header(node).count = (uint16_t)mid;
+            node.markDirty();
+
+            for (size_t i = mid + 1; i < n + 1; i++)
+                setKey(sibling, i - mid - 1, keys[i]);
+            for (size_t i = mid + 1; i < n + 2; i++)
+                setChild(sibling, i - mid - 1, children[i]);
+            header(sibling).count = (uint16_t)(n - mid);
+
+            separator = keys[mid];
+            right = sibling.id();
+            return true;
+        }
+
+        // Descends to the leaf which may hold the key
+        BufferPool::PageHandle findLeaf(const KeyType &key)
+        {
+            BufferPool::PageHandle node = pool.fetch(meta.root);
+            for (uint32_t level = 1; level < meta.height; level++)
+            {
+                size_t idx = upperBound(node, header(node).count, key);
+                node = pool.fetch(getChild(node, idx));
+            }
+
+            return node;
+        }
+
+        BufferPool::PageHandle newNode(bool leaf)
+        {
+            BufferPool::PageHandle node = pool.allocate();
+            header(node).leaf = leaf;
+            return node;
+        }
+
+        void linkLeaf(uint32_t left, uint32_t right)
+        {
+            BufferPool::PageHandle leaf = pool.fetch(left);
+            header(leaf).next = right;
+            leaf.markDirty();
+        }
+
+        void insertKey(BufferPool::PageHandle &leaf, size_t n, size_t pos, const KeyType &key)
+        {
+            std::memmove(keyAddress(leaf, pos + 1), keyAddress(leaf, pos), (n - pos) * sizeof(KeyType));
+            setKey(leaf, pos, key);
+            header(leaf).count = (uint16_t)(n + 1);
+            leaf.markDirty();
+        }
+
+        void insertSeparator(BufferPool::PageHandle &inner, size_t n, size_t idx, const KeyType &key, uint32_t child)
+        {
+            std::memmove(keyAddress(inner, idx + 1), keyAddress(inner, idx), (n - idx) * sizeof(KeyType));
+            std::memmove(childAddress(inner, idx + 2), childAddress(inner, idx + 1), (n - idx) * sizeof(uint32_t));
+            setKey(inner, idx, key);
+            setChild(inner, idx + 1, child);
+            header(inner).count = (uint16_t)(n + 1);
+            inner.markDirty();
+        }
+
+        // Number of items the i-th of `parts` nodes gets when `total` items are spread evenly
+        static size_t share(size_t total, size_t parts, size_t i)
+        {
+            return total / parts + (i < total % parts ? 1 : 0);
+        }
+
+        // First position whose key is not less than key
+        size_t lowerBound(BufferPool::PageHandle &node, size_t n, const KeyType &key)
+        {
+            size_t lo = 0, hi = n;
+            while (lo < hi)
+            {
+                size_t mid = (lo + hi) / 2;
+                if (getKey(node, mid) < key)
+                    lo = mid + 1;
+                else
+                    hi = mid;
+            }
+            return lo;
+        }
+
+        // First position whose key is greater than key - the child to descend into
+        size_t upperBound(BufferPool::PageHandle &node, size_t n, const KeyType &key)
+        {
+            size_t lo = 0, hi = n;
+            while (lo < hi)
+            {
+                size_t mid = (lo + hi) / 2;
+                if (key < getKey(node, mid))
+                    hi = mid;
+                else
+                    lo = mid + 1;
+            }
+            return lo;
+        }
+
+        static bool equal(const KeyType &lhs, const KeyType &rhs)
+        {
+            return !(lhs < rhs) && !(rhs < lhs);
+        }
+
+        void writeMeta()
+        {
+            BufferPool::PageHandle page = pool.fetch(0);
+            std::memcpy(page.data(), &meta, sizeof(Meta));
+            page.markDirty();
+        }
+
+        // Keys and children are accessed with memcpy - no alignment assumptions.
+        // The header sits at the start of the (cache line aligned) frame.
+
+        static Header &header(BufferPool::PageHandle &node)
+        {
+            return *reinterpret_cast<Header *>(node.data());
+        }
+
+        static unsigned char *keyAddress(BufferPool::PageHandle &node, size_t i)
+        {
+            return node.data() + HEADER_SIZE + i * sizeof(KeyType);
+        }
+
+        static unsigned char *childAddress(BufferPool::PageHandle &node, size_t i)
+        {
+            return node.data() + HEADER_SIZE + INNER_CAPACITY * sizeof(KeyType) + i * sizeof(uint32_t);
+        }
+
+        static KeyType getKey(BufferPool::PageHandle &node, size_t i)
+        {
+            KeyType key;
+            std::memcpy(&key, keyAddress(node, i), sizeof(KeyType));
+            return key;
+        }
+
+        static void setKey(BufferPool::PageHandle &node, size_t i, const KeyType &key)
+        {
+            std::memcpy(keyAddress(node, i), &key, sizeof(KeyType));
+        }
+
+        static uint32_t getChild(BufferPool::PageHandle &node, size_t i)
+        {
+            uint32_t child;
+            std::memcpy(&child, childAddress(node, i), sizeof(uint32_t));
+            return child;
+        }
+
+        static void setChild(BufferPool::PageHandle &node, size_t i, uint32_t child)
+        {
+            std::memcpy(childAddress(node, i), &child, sizeof(uint32_t));
+        }
+
+        BufferPool pool;
+        Meta meta;
+    };
+} // namespace ds
+
+#endif // BPLUS_TREE_HPP_GUARD_
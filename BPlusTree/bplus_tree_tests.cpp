@@ -0,0 +1,151 @@
+#define CATCH_CONFIG_MAIN
+#include "../Catch2/catch.hpp"
+#include "bplus_tree.hpp"
+
+#include <cstdio>
+#include <filesystem>
+#include <random>
+#include <set>
+#include <vector>
+
+using namespace ds;
+
+// Fresh file in the temp directory, removed at the end of the test
+struct TempFile
+{
+    std::string path;
+
+    explicit TempFile(const std::string &name)
+        : path((std::filesystem::temp_directory_path() / name).string())
+    {
+        std::remove(path.c_str());
+    }
+
+    ~TempFile() { std::remove(path.c_str()); }
+};
+
+TEST_CASE("BASIC OPERATIONS", "[INSERT][REMOVE][CONTAINS]")
+{
+    TempFile file("ds_bplus_basic.db");
+    BPlusTree<int> tree(file.path);
+
+    SECTION("EMPTY")
+    {
+        REQUIRE(tree.isEmpty());
+        REQUIRE(tree.height() == 0);
+        REQUIRE_FALSE(tree.contains(1));
+        REQUIRE_THROWS(tree.remove(1));
+    }
+
+    SECTION("INSERT / REMOVE")
+    {
+        tree.insert(10);
+        tree.insert(5);
+        tree.insert(20);
+
+        REQUIRE(tree.size() == 3);
+        REQUIRE(tree.contains(5));
+        REQUIRE_FALSE(tree.contains(6));
+        REQUIRE_THROWS(tree.insert(10));
+
+        tree.remove(5);
+        REQUIRE_FALSE(tree.contains(5));
+        REQUIRE(tree.size() == 2);
+        REQUIRE_THROWS(tree.remove(5));
+    }
+}
+
+TEST_CASE("MATCHES STD::SET", "[INSERT][REMOVE][CONTAINS][SCAN]")
+{
+    TempFile file("ds_bplus_random.db");
+
+    // A tiny cache forces constant eviction
+    BPlusTree<int> tree(file.path, 16);
+    std::set<int> reference;
+
+    std::mt19937 rng(1);
+    std::uniform_int_distribution<int> dist(0, 200000);
+
+    for (int i = 0; i < 100000; i++)
+    {
+        int key = dist(rng);
+        if (reference.insert(key).second)
+            tree.insert(key);
+    }
+    for (int i = 0; i < 30000; i++)
+    {
+        int key = dist(rng);
+        if (reference.erase(key))
+            tree.remove(key);
+    }
+
+    REQUIRE(tree.size() == reference.size());
+    REQUIRE(tree.height() >= 2);
+
+    for (int i = 0; i < 20000; i++)
+    {
+        int key = dist(rng);
+        REQUIRE(tree.contains(key) == (reference.count(key) == 1));
+    }
+
+    std::vector<int> scanned;
+    tree.scan(1000, 50000, [&scanned](int key)
+              {
+                  scanned.push_back(key);
+                  return true; });
+
+    std::vector<int> expected(reference.lower_bound(1000), reference.upper_bound(50000));
+    REQUIRE(scanned == expected);
+}
+
+TEST_CASE("PERSISTENCE", "[REOPEN][BULK LOAD]")
+{
+    TempFile file("ds_bplus_persist.db");
+    const int N = 50000;
+
+    SECTION("REOPEN")
+    {
+        {
+            BPlusTree<long long> tree(file.path);
+            for (long long i = 0; i < N; i++)
+                tree.insert(i * 3);
+        }
+
+        BPlusTree<long long> reopened(file.path);
+        REQUIRE(reopened.size() == N);
+        REQUIRE(reopened.contains(3 * (N - 1)));
+        REQUIRE_FALSE(reopened.contains(1));
+
+        // Wrong key type
+        REQUIRE_THROWS(BPlusTree<int>(file.path));
+    }
+
+    SECTION("BULK LOAD")
+    {
+        std::vector<int> sorted;
+        for (int i = 0; i < N; i++)
+            sorted.push_back(2 * i);
+
+        {
+            BPlusTree<int> tree(file.path);
+            REQUIRE_THROWS(tree.bulkLoad({3, 2, 1}));
+
+            tree.bulkLoad(sorted);
+            REQUIRE(tree.size() == N);
+            REQUIRE_THROWS(tree.bulkLoad(sorted));
+
+            // Regular inserts still work on a bulk loaded tree
+            tree.insert(7);
+        }
+
+        BPlusTree<int> tree(file.path);
+        REQUIRE(tree.size() == N + 1);
+        for (int i = 0; i < 2 * N; i++)
+            REQUIRE(tree.contains(i) == (i % 2 == 0 || i == 7));
+
+        int visited = 0;
+        tree.scan(0, 2 * N, [&visited](int)
+                  { return ++visited < 100; });
+        REQUIRE(visited == 100);
+    }
+}
@@ -0,0 +1,279 @@
+/**
+ * @file buffer_pool.hpp
+ * @author Ivan Penev
+ * @brief Fixed-size page cache over a local file with clock eviction
+ * @date 2026-10-18
+ *
+ * Pages are read and written with pread/pwrite. A fixed number of frames is
+ * kept in memory; when a frame is needed the clock hand sweeps the frames,
+ * giving recently used pages a second chance and skipping pinned ones.
+ */
+
+#ifndef BUFFER_POOL_HPP_GUARD_
+#define BUFFER_POOL_HPP_GUARD_
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept> // Exception handling
+#include <string>
+#include <unordered_map> // Page table
+#include <vector>
+
+#include <fcntl.h>  // open
+#include <unistd.h> // pread, pwrite, fsync, close
+
+namespace ds
+{
+    class BufferPool
+    {
+    public:
+        static const size_t PAGE_SIZE = 4096;
+
+    private:
+        struct Frame
+        {
+            alignas(64) unsigned char data[PAGE_SIZE];
+            uint32_t pageId = 0;
+            bool used = false; // holds a page
+            bool dirty = false;
+            bool referenced = false; // clock bit
+            unsigned pins = 0;
+        };
+
+    public:
+        /**
+         * @brief RAII pin of a cached page. While a handle is alive the page
+         * stays in its frame.
+         */
+        class PageHandle
+        {
+        public:
+            PageHandle(PageHandle &&other) noexcept : frame(other.frame) { other.frame = nullptr; }
+            PageHandle(const PageHandle &) = delete;
+
+            // Re-pointing a handle releases the previous page
+            PageHandle &operator=(PageHandle &&other) noexcept
+            {
+                if (this != &other)
+                {
+                    if (frame)
+                        --frame->pins;
+                    frame = other.frame;
+                    other.frame = nullptr;
+                }
+                return *this;
+            }
+
+            ~PageHandle()
+            {
+                if (frame)
+                    --frame->pins;
+            }
+
+            unsigned char *data() { return frame->data; }
+            const unsigned char *data() const { return frame->data; }
+
+            uint32_t id() const { return frame->pageId; }
+
+            /**
+             * @brief Must be called after the page was modified
+             */
+            void markDirty() { frame->dirty = true; }
+
+        private:
+            friend BufferPool;
+            explicit PageHandle(Frame *frame) : frame(frame) { ++frame->pins; }
+
+            Frame *frame;
+        };
+
+        /**
+         * @brief Opens (or creates) the file behind the pool
+         *
+         * @param path - local file
+         * @param frameCount - number of pages kept in memory
+         * @throws std::invalid_argument when frameCount is 0
+         * @throws std::runtime_error when the file cannot be opened
+         */
+        BufferPool(const std::string &path, size_t frameCount)
+            : frames(frameCount)
+        {
+            if (frameCount == 0)
+            {
+                throw std::invalid_argument("BufferPool: Invalid frame count!");
+            }
+
+            fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+            if (fd < 0)
+            {
+                throw std::runtime_error("BufferPool: Cannot open " + path + ": " + std::strerror(errno));
+            }
+
+            off_t end = ::lseek(fd, 0, SEEK_END);
+            pages = end > 0 ? (uint32_t)(end / PAGE_SIZE) : 0;
+        }
+
+        BufferPool(const BufferPool &) = delete;
+        BufferPool &operator=(const BufferPool &) = delete;
+
+        ~BufferPool()
+        {
+            try
+            {
+                flush();
+            }
+            catch (...)
+            {
+                // Nothing sensible to do in a destructor
+            }
+            ::close(fd);
+        }
+
+        /**
+         * @brief Pins an existing page, reading it from disk if needed
+         * @throws std::out_of_range for a page past the end of the file
+         */
+        PageHandle fetch(uint32_t pageId)
+        {
+            if (pageId >= pages)
+            {
+                throw std::out_of_range("BufferPool: Invalid page id!");
+            }
+
+            auto found = table.find(pageId);
+            if (found != table.end())
+            {
+                Frame &frame = frames[found->second];
+                frame.referenced = true;
+                return PageHandle(&frame);
+            }
+
+            size_t slot = victim();
+            Frame &frame = frames[slot];
+            readPage(pageId, frame.data);
+            install(slot, pageId);
+
+            return PageHandle(&frame);
+        }
+
+        /**
+         * @brief Appends a zeroed page to the file and pins it
+         */
+        PageHandle allocate()
+        {
+            size_t slot = victim();
+            Frame &frame = frames[slot];
+            std::memset(frame.data, 0, PAGE_SIZE);
+
+            install(slot, pages++);
+            frame.dirty = true;
+
+            return PageHandle(&frame);
+        }
+
+        /**
+         * @brief Writes every dirty page back and syncs the file
+         */
+        void flush()
+        {
+            for (Frame &frame : frames)
+                writeBack(frame);
+
+            if (::fsync(fd) != 0)
+            {
+                throw std::runtime_error(std::string("BufferPool: fsync failed: ") + std::strerror(errno));
+            }
+        }
+
+        /**
+         * @brief Returns the number of pages in the file
+         */
+        uint32_t pageCount() const { return pages; }
+
+        /**
+         * @brief Returns the number of pages read from disk so far
+         */
+        size_t reads() const { return diskReads; }
+
+        //
+        /* Helpers */
+    private:
+        // Picks a frame with the clock algorithm, writing its page back if dirty
+        size_t victim()
+        {
+            // Two full sweeps clear every reference bit
+            for (size_t step = 0; step < 2 * frames.size() + 1; step++)
+            {
+                size_t slot = hand;
+                hand = (hand + 1) % frames.size();
+
+                Frame &frame = frames[slot];
+                if (!frame.used)
+                    return slot;
+                if (frame.pins > 0)
+                    continue;
+
+                if (frame.referenced)
+                {
+                    frame.referenced = false;
+                    continue;
+                }
+
+                writeBack(frame);
+                table.erase(frame.pageId);
+                frame.used = false;
+                return slot;
+            }
+
+            throw std::runtime_error("BufferPool: All frames are pinned!");
+        }
+
+        void install(size_t slot, uint32_t pageId)
+        {
+            Frame &frame = frames[slot];
+            frame.pageId = pageId;
+            frame.used = true;
+            frame.dirty = false;
+            frame.referenced = true;
+            table[pageId] = slot;
+        }
+
+        void writeBack(Frame &frame)
+        {
+            if (!frame.used || !frame.dirty)
+                return;
+
+            ssize_t written = ::pwrite(fd, frame.data, PAGE_SIZE, (off_t)frame.pageId * PAGE_SIZE);
+            if (written != (ssize_t)PAGE_SIZE)
+            {
+                throw std::runtime_error("BufferPool: Short write!");
+            }
+            frame.dirty = false;
+        }
+
+        void readPage(uint32_t pageId, unsigned char *out)
+        {
+            ssize_t got = ::pread(fd, out, PAGE_SIZE, (off_t)pageId * PAGE_SIZE);
+            if (got < 0)
+            {
+                throw std::runtime_error(std::string("BufferPool: Read failed: ") + std::strerror(errno));
+            }
+
+            // A page allocated but never written back reads short - it is zeros
+            if ((size_t)got < PAGE_SIZE)
+                std::memset(out + got, 0, PAGE_SIZE - got);
+
+            ++diskReads;
+        }
+
+        int fd;
+        uint32_t pages;
+        std::vector<Frame> frames;
+        std::unordered_map<uint32_t, size_t> table;
+        size_t hand = 0;
+        size_t diskReads = 0;
+    };
+} // namespace ds
+
+#endif // BUFFER_POOL_HPP_GUARD_
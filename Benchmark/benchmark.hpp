@@ -0,0 +1,184 @@
+/**
+ * @file benchmark.hpp
+ * @author Ivan Penev
+ * @brief Minimal benchmark harness: wall time and hardware counters per case,
+ * printed and written as JSON
+ * @date 2026-10-18
+ *
+ *     ds::bench::Benchmark bench("containers", argc, argv);
+ *     bench.run("dynamic_array push_back", N, [&] { for (...) arr.push_back(i); });
+ *     return bench.finish();
+ *
+ * Every case runs its body once between the counter start and stop and is
+ * normalized by the number of operations it declares. The counters come from
+ * perf_counters.hpp; without them a case has wall time only and the JSON has
+ * null for the missing values. `--json FILE` writes the report to FILE,
+ * `--json -` to stdout.
+ */
+
+#ifndef BENCHMARK_HPP_GUARD_
+#define BENCHMARK_HPP_GUARD_
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "perf_counters.hpp"
+
+namespace ds
+{
+    namespace bench
+    {
+        class Benchmark
+        {
+        public:
+            /**
+             * @brief Opens the counters and reads `--json FILE` from the
+             * command line
+             */
+            Benchmark(const std::string &suite, int argc, char **argv) : suite(suite)
+            {
+                for (int i = 1; i + 1 < argc; i++)
+                    if (std::strcmp(argv[i], "--json") == 0)
+                        jsonPath = argv[i + 1];
+
+                std::cout << suite << " (hardware counters: "
+                          << (counters.available() ? "on" : "off") << (counters.reason().empty() ? "" : " - ")
+                          << counters.reason() << ")\n";
+            }
+
+            /**
+             * @brief Runs body, which performs ops operations, and records it
+             */
+            template <typename Body>
+            void run(const std::string &name, uint64_t ops, Body body)
+            {
+                typedef std::chrono::steady_clock Clock;
+
+                counters.start();
+                Clock::time_point start = Clock::now();
+                body();
+                double elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+                PerfCounters::Reading reading = counters.stop();
+
+                cases.push_back(Case{name, ops ? ops : 1, elapsed, reading});
+                print(cases.back());
+            }
+
+            /**
+             * @brief Writes the JSON report, if requested
+             * @return int - 0, or 1 if the report could not be written
+             */
+            int finish() const
+            {
+                if (jsonPath.empty())
+                    return 0;
+
+                std::string json = toJson();
+                if (jsonPath == "-")
+                {
+                    std::cout << json;
+                    return 0;
+                }
+
+                std::ofstream out(jsonPath.c_str());
+                out << json;
+                if (!out)
+                {
+                    std::cerr << "Cannot write " << jsonPath << "\n";
+                    return 1;
+                }
+                return 0;
+            }
+
+        private:
+            struct Case
+            {
+                std::string name;
+                uint64_t ops;
+                double nanoseconds;
+                PerfCounters::Reading counters;
+
+                double perOp(PerfCounters::Event event) const { return double(counters.value[event]) / ops; }
+
+                bool has(PerfCounters::Event event) const { return counters.valid[event]; }
+            };
+
+            static void print(const Case &c)
+            {
+                std::cout << "  " << c.name << ": " << c.nanoseconds / c.ops << " ns/op";
+                if (c.has(PerfCounters::CYCLES) && c.has(PerfCounters::INSTRUCTIONS) && c.counters.value[PerfCounters::CYCLES])
+                    std::cout << ", " << c.perOp(PerfCounters::INSTRUCTIONS) << " instr/op, IPC "
+                              << double(c.counters.value[PerfCounters::INSTRUCTIONS]) / c.counters.value[PerfCounters::CYCLES];
+                if (c.has(PerfCounters::CACHE_MISSES))
+                    std::cout << ", " << c.perOp(PerfCounters::CACHE_MISSES) << " LLC miss/op";
+                if (c.has(PerfCounters::BRANCH_MISSES))
+                    std::cout << ", " << c.perOp(PerfCounters::BRANCH_MISSES) << " branch miss/op";
+                if (c.has(PerfCounters::DTLB_MISSES))
+                    std::cout << ", " << c.perOp(PerfCounters::DTLB_MISSES) << " dTLB miss/op";
+                std::cout << "\n";
+            }
+
+            static std::string quoted(const std::string &text)
+            {
+                std::string out = "\"";
+                for (char c : text)
+                {
+                    if (c == '"' || c == '\\')
+                        out += '\\';
+                    out += c;
+                }
+                return out + "\"";
+            }
+
+            std::string toJson() const
+            {
+                std::ostringstream json;
+                json.precision(6);
+                json << "{\n  \"suite\": " << quoted(suite) << ",\n"
+                     << "  \"counters\": " << (counters.available() ? "true" : "false") << ",\n"
+                     << "  \"counters_note\": " << quoted(counters.reason()) << ",\n"
+                     << "  \"cases\": [";
+
+                for (size_t i = 0; i < cases.size(); i++)
+                {
+                    const Case &c = cases[i];
+                    json << (i ? "," : "") << "\n    {\"name\": " << quoted(c.name) << ", \"ops\": " << c.ops
+                         << ", \"ns_per_op\": " << c.nanoseconds / c.ops;
+
+                    for (int event = 0; event < PerfCounters::EVENTS; event++)
+                    {
+                        json << ", \"" << PerfCounters::name(PerfCounters::Event(event)) << "_per_op\": ";
+                        if (c.has(PerfCounters::Event(event)))
+                            json << c.perOp(PerfCounters::Event(event));
+                        else
+                            json << "null";
+                    }
+
+                    json << ", \"ipc\": ";
+                    if (c.has(PerfCounters::CYCLES) && c.has(PerfCounters::INSTRUCTIONS) && c.counters.value[PerfCounters::CYCLES])
+                        json << double(c.counters.value[PerfCounters::INSTRUCTIONS]) / c.counters.value[PerfCounters::CYCLES];
+                    else
+                        json << "null";
+                    json << "}";
+                }
+
+                json << "\n  ]\n}\n";
+                return json.str();
+            }
+
+            std::string suite;
+            std::string jsonPath;
+            PerfCounters counters;
+            std::vector<Case> cases;
+        };
+    } // namespace bench
+} // namespace ds
+
+#endif // BENCHMARK_HPP_GUARD_
@@ -0,0 +1,123 @@
+// The core operations of dynamic_array, List, Stack, StaticStack, BinaryHeap
+// and BST, with wall time and hardware counters per operation.
+//
+// g++ -std=c++17 -O2 containers_bench.cpp -o containers_bench
+// ./containers_bench --json results.json
+//
+// Without permission for perf_event_open (perf_event_paranoid > 2, most
+// containers) the cases report wall time only and the counters are null.
+
+#include "benchmark.hpp"
+
+#include "../BinarySerachTree/BST.hpp"
+#include "../DoublyLinkedList/list.hpp"
+#include "../DynamicArray/dynamic_array.hpp"
+#include "../Heap/binary_heap.hpp"
+#include "../Stacks/StackLinked/stack_linked.hpp"
+#include "../Stacks/StaticStack/stack_static.hpp"
+
+#include <random>
+
+using namespace ds;
+
+static volatile long sink;
+
+int main(int argc, char **argv)
+{
+    const int N = 1000000;
+    const int KEYS = 200000;
+    bench::Benchmark bench("containers", argc, argv);
+
+    std::mt19937 rng(42);
+    std::vector<int> indices(N), keys(KEYS);
+    for (int &index : indices)
+        index = rng() % N;
+    for (int &key : keys)
+        key = int(rng());
+
+    dynamic_array<int> arr;
+    bench.run("dynamic_array push_back", N, [&] {
+        for (int i = 0; i < N; i++)
+            arr.push_back(i);
+    });
+    bench.run("dynamic_array random access", N, [&] {
+        long sum = 0;
+        for (int i = 0; i < N; i++)
+            sum += arr[indices[i]];
+        sink = sum;
+    });
+
+    List<int> list;
+    bench.run("List push_back", N, [&] {
+        for (int i = 0; i < N; i++)
+            list.push_back(i);
+    });
+    bench.run("List traversal", N, [&] {
+        long sum = 0;
+        for (int value : list)
+            sum += value;
+        sink = sum;
+    });
+    bench.run("List pop_front", N, [&] {
+        for (int i = 0; i < N; i++)
+            list.pop_front();
+    });
+
+    Stack<int> stk;
+    bench.run("Stack push + pop", 2 * N, [&] {
+        for (int i = 0; i < N; i++)
+            stk.push(i);
+        long sum = 0;
+        for (int i = 0; i < N; i++)
+        {
+            sum += stk.top();
+            stk.pop();
+        }
+        sink = sum;
+    });
+
+    static StaticStack<int, 1024> sstk;
+    bench.run("StaticStack push + pop", 2 * N, [&] {
+        long sum = 0;
+        for (int round = 0; round < N / 1000; round++)
+        {
+            for (int i = 0; i < 1000; i++)
+                sstk.push(i);
+            for (int i = 0; i < 1000; i++)
+            {
+                sum += sstk.top();
+                sstk.pop();
+            }
+        }
+        sink = sum;
+    });
+
+    BinaryHeap<int> heap(BinaryHeap<int>::less);
+    bench.run("BinaryHeap push", N, [&] {
+        for (int i = 0; i < N; i++)
+            heap.push(indices[i]);
+    });
+    bench.run("BinaryHeap pop", N, [&] {
+        long sum = 0;
+        for (int i = 0; i < N; i++)
+        {
+            sum += heap.top();
+            heap.pop();
+        }
+        sink = sum;
+    });
+
+    BST<int> tree;
+    bench.run("BST insert", KEYS, [&] {
+        for (int key : keys)
+            tree.try_insert(key); // the random keys may repeat
+    });
+    bench.run("BST contains", KEYS, [&] {
+        long found = 0;
+        for (int key : keys)
+            found += tree.contains(key);
+        sink = found;
+    });
+
+    return bench.finish();
+}
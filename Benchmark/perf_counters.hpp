@@ -0,0 +1,181 @@
+/**
+ * @file perf_counters.hpp
+ * @author Ivan Penev
+ * @brief Hardware performance counters for the benchmarks (Linux perf_event_open)
+ * @date 2026-10-18
+ *
+ * Counts cycles, instructions, cache misses, branch misses and data TLB misses
+ * of the calling thread, user space only. Every event is opened on its own,
+ * so a machine which lacks one (a VM without a virtual PMU, an ARM core
+ * without a TLB event) still gets the others. When perf_event_open is not
+ * permitted (perf_event_paranoid, seccomp, containers) or the platform is not
+ * Linux, nothing is counted and reason() tells why - the benchmarks then
+ * report wall time only.
+ *
+ * When more events are requested than the PMU has counters, the kernel
+ * multiplexes them; the values are scaled by time enabled / time running.
+ */
+
+#ifndef PERF_COUNTERS_HPP_GUARD_
+#define PERF_COUNTERS_HPP_GUARD_
+
+#include <cstdint>
+#include <cstring> // strerror
+#include <string>
+
+#if defined(__linux__)
+#include <cerrno>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace ds
+{
+    namespace bench
+    {
+        class PerfCounters
+        {
+        public:
+            enum Event
+            {
+                CYCLES,
+                INSTRUCTIONS,
+                CACHE_MISSES,  // last level cache
+                BRANCH_MISSES,
+                DTLB_MISSES,   // data TLB load misses
+                EVENTS
+            };
+
+            static const char *name(Event event)
+            {
+                static const char *const NAMES[EVENTS] = {"cycles", "instructions", "cache_misses",
+                                                          "branch_misses", "dtlb_misses"};
+                return NAMES[event];
+            }
+
+            /**
+             * @brief The counts of one measurement; an event which could not
+             * be opened has valid[event] == false
+             */
+            struct Reading
+            {
+                uint64_t value[EVENTS] = {};
+                bool valid[EVENTS] = {};
+            };
+
+            PerfCounters()
+            {
+                for (int &fd : fds)
+                    fd = -1;
+#if defined(__linux__)
+                const uint32_t TYPES[EVENTS] = {PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE,
+                                                PERF_TYPE_HARDWARE, PERF_TYPE_HW_CACHE};
+                const uint64_t CONFIGS[EVENTS] = {
+                    PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES,
+                    PERF_COUNT_HW_BRANCH_MISSES,
+                    PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                        (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)};
+
+                for (int event = 0; event < EVENTS; event++)
+                {
+                    perf_event_attr attr;
+                    std::memset(&attr, 0, sizeof(attr));
+                    attr.size = sizeof(attr);
+                    attr.type = TYPES[event];
+                    attr.config = CONFIGS[event];
+                    attr.disabled = 1;
+                    attr.exclude_kernel = 1; // allowed up to perf_event_paranoid 2
+                    attr.exclude_hv = 1;
+                    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+                    fds[event] = int(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+                    if (fds[event] < 0 && failure.empty())
+                        failure = std::string(name(Event(event))) + ": " + std::strerror(errno);
+                }
+#else
+                failure = "perf_event_open is Linux only";
+#endif
+            }
+
+            PerfCounters(const PerfCounters &) = delete;
+            PerfCounters &operator=(const PerfCounters &) = delete;
+
+            ~PerfCounters()
+            {
+#if defined(__linux__)
+                for (int fd : fds)
+                    if (fd >= 0)
+                        close(fd);
+#endif
+            }
+
+            /**
+             * @brief Checks if at least one event is counted
+             */
+            bool available() const
+            {
+                for (int fd : fds)
+                    if (fd >= 0)
+                        return true;
+                return false;
+            }
+
+            /**
+             * @brief Returns why the first missing event could not be opened,
+             * empty if all are counted
+             */
+            const std::string &reason() const { return failure; }
+
+            /**
+             * @brief Zeroes and starts the counters
+             */
+            void start()
+            {
+#if defined(__linux__)
+                for (int fd : fds)
+                    if (fd >= 0)
+                        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+                for (int fd : fds)
+                    if (fd >= 0)
+                        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+            }
+
+            /**
+             * @brief Stops the counters and returns the counts since start()
+             */
+            Reading stop()
+            {
+                Reading reading;
+#if defined(__linux__)
+                for (int fd : fds)
+                    if (fd >= 0)
+                        ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+
+                for (int event = 0; event < EVENTS; event++)
+                {
+                    uint64_t data[3]; // value, time enabled, time running
+                    if (fds[event] < 0 || ::read(fds[event], data, sizeof(data)) != sizeof(data))
+                        continue;
+
+                    // A counter which never got the PMU has nothing to scale
+                    if (data[2] == 0)
+                        continue;
+
+                    reading.value[event] = data[2] < data[1] ? uint64_t(double(data[0]) * data[1] / data[2]) : data[0];
+                    reading.valid[event] = true;
+                }
+#endif
+                return reading;
+            }
+
+        private:
+            int fds[EVENTS];
+            std::string failure;
+        };
+    } // namespace bench
+} // namespace ds
+
+#endif // PERF_COUNTERS_HPP_GUARD_
@@ -0,0 +1,593 @@
+/**
+ * @file trace.hpp
+ * @author Ivan Penev
+ * @brief Operation traces: a compact file format and recording wrappers for
+ * dynamic_array, List, BinaryHeap and BST
+ * @date 2026-10-18
+ *
+ * A wrapper forwards every call to the container and appends the operation,
+ * its key or index and the container size to a trace file:
+ *
+ *     ds::TraceWriter writer("orders.trace", ds::TraceTarget::heap);
+ *     ds::BinaryHeap<int> heap(ds::BinaryHeap<int>::less);
+ *     ds::TracedHeap<int> traced(heap, writer);
+ *     traced.push(42); // instead of heap.push(42)
+ *
+ * trace_replay.hpp runs a trace against any container; trace_replay.cpp times
+ * it against the ds containers and their standard library counterparts.
+ *
+ * The file is a 6 byte header ("DSTR", version, target) followed by one
+ * record per operation: the operation byte, the key or index as a zigzag
+ * varint (for the operations which have one; insert_at adds the value) and
+ * the change of the size since the previous record, also a zigzag varint.
+ * A push_back of a small key takes 3 bytes, a pop 2.
+ *
+ * Only operations which succeeded are recorded, so a replay never throws.
+ * The keys are integers; record from an empty container, since a replay
+ * starts from one. The ordering of a heap is not stored - only min-heaps
+ * are recorded and replayed.
+ */
+
+#ifndef TRACE_HPP_GUARD_
+#define TRACE_HPP_GUARD_
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "../BinarySerachTree/BST.hpp"
+#include "../DoublyLinkedList/list.hpp"
+#include "../DynamicArray/dynamic_array.hpp"
+#include "../Heap/binary_heap.hpp"
+
+namespace ds
+{
+    /**
+     * @brief The container a trace was recorded from
+     */
+    enum class TraceTarget : uint8_t
+    {
+        array,
+        list,
+        heap,
+        bst,
+    };
+
+    enum class TraceOp : uint8_t
+    {
+        push_back,  // key = value
+        push_front, // key = value
+        pop_back,
+        pop_front,
+        front,
+        back,
+        insert_at, // key = index, value = value
+        erase_at,  // key = index
+        at,        // key = index
+        push,      // key = value
+        pop,
+        top,
+        insert,   // key = value
+        remove,   // key = value
+        contains, // key = value
+    };
+
+    const size_t TRACE_OPS = 15;
+
+    inline const char *describe(TraceTarget target)
+    {
+        static const char *const NAMES[] = {"dynamic_array", "List", "BinaryHeap", "BST"};
+        return NAMES[static_cast<size_t>(target)];
+    }
+
+    inline const char *describe(TraceOp op)
+    {
+        static const char *const NAMES[TRACE_OPS] = {"push_back", "push_front", "pop_back", "pop_front", "front",
+                                                     "back", "insert_at", "erase_at", "at", "push", "pop", "top",
+                                                     "insert", "remove", "contains"};
+        return NAMES[static_cast<size_t>(op)];
+    }
+
+    /**
+     * @brief Checks if op is stored with a key or an index
+     */
+    inline bool hasKey(TraceOp op)
+    {
+        switch (op)
+        {
+        case TraceOp::pop_back:
+        case TraceOp::pop_front:
+        case TraceOp::front:
+        case TraceOp::back:
+        case TraceOp::pop:
+        case TraceOp::top:
+            return false;
+        default:
+            return true;
+        }
+    }
+
+    /**
+     * @brief Returns by how much op changes the size of the container
+     */
+    inline int sizeChange(TraceOp op)
+    {
+        switch (op)
+        {
+        case TraceOp::push_back:
+        case TraceOp::push_front:
+        case TraceOp::insert_at:
+        case TraceOp::push:
+        case TraceOp::insert:
+            return 1;
+        case TraceOp::pop_back:
+        case TraceOp::pop_front:
+        case TraceOp::erase_at:
+        case TraceOp::pop:
+        case TraceOp::remove:
+            return -1;
+        default:
+            return 0;
+        }
+    }
+
+    /**
+     * @brief One operation; size is the size of the container before it
+     */
+    struct TraceRecord
+    {
+        TraceOp op;
+        int64_t key;
+        uint64_t size;
+        int64_t value; // insert_at only
+    };
+
+    /**
+     * @brief A trace read into memory
+     */
+    struct Trace
+    {
+        TraceTarget target;
+        std::vector<TraceRecord> records;
+
+        /**
+         * @brief Returns the size of the container after the last operation
+         */
+        uint64_t finalSize() const
+        {
+            return records.empty() ? 0 : records.back().size + sizeChange(records.back().op);
+        }
+
+        uint64_t peakSize() const
+        {
+            uint64_t peak = 0;
+            for (const TraceRecord &record : records)
+                peak = record.size > peak ? record.size : peak;
+            return peak < finalSize() ? finalSize() : peak;
+        }
+    };
+
+    namespace trace_detail
+    {
+        const unsigned char MAGIC[4] = {'D', 'S', 'T', 'R'};
+        const unsigned char VERSION = 1;
+
+        inline void fail(const std::string &what, const std::string &path)
+        {
+            throw std::runtime_error("Trace: " + what + " " + path + ": " + std::strerror(errno));
+        }
+
+        inline uint64_t zigzag(int64_t value)
+        {
+            return (uint64_t(value) << 1) ^ uint64_t(value >> 63);
+        }
+
+        inline int64_t unzigzag(uint64_t value)
+        {
+            return int64_t(value >> 1) ^ -int64_t(value & 1);
+        }
+
+        inline void putVarint(std::vector<unsigned char> &out, uint64_t value)
+        {
+            while (value >= 0x80)
+            {
+                out.push_back((unsigned char)(value | 0x80));
+                value >>= 7;
+            }
+            out.push_back((unsigned char)value);
+        }
+
+        // Returns false on a truncated or overlong varint
+        inline bool getVarint(const unsigned char *&pos, const unsigned char *end, uint64_t &value)
+        {
+            value = 0;
+            for (unsigned shift = 0; pos < end && shift < 64; shift += 7)
+            {
+                unsigned char byte = *pos++;
+                value |= uint64_t(byte & 0x7f) << shift;
+                if (!(byte & 0x80))
+                    return true;
+            }
+            return false;
+        }
+    } // namespace trace_detail
+
+    /**
+     * @brief Appends records to a trace file, buffered
+     */
+    class TraceWriter
+    {
+    public:
+        /**
+         * @brief Creates (or truncates) the file at path
+         * @throws std::runtime_error when the file cannot be created
+         */
+        TraceWriter(const std::string &path, TraceTarget target)
+            : path(path), file(std::fopen(path.c_str(), "wb")), lastSize(0), records(0)
+        {
+            if (!file)
+                trace_detail::fail("Cannot create", path);
+
+            buffer.reserve(BUFFER + 32);
+            buffer.insert(buffer.end(), trace_detail::MAGIC, trace_detail::MAGIC + 4);
+            buffer.push_back(trace_detail::VERSION);
+            buffer.push_back(static_cast<unsigned char>(target));
+        }
+
+        TraceWriter(const TraceWriter &) = delete;
+        TraceWriter &operator=(const TraceWriter &) = delete;
+
+        /**
+         * @brief Flushes and closes the file; errors are lost, call close()
+         * to see them
+         */
+        ~TraceWriter()
+        {
+            if (file)
+            {
+                std::fwrite(buffer.data(), 1, buffer.size(), file);
+                std::fclose(file);
+            }
+        }
+
+        /**
+         * @brief Appends one record
+         * @note Time complexity: O(1) amortized, a write() per 64 KiB
+         */
+        void write(TraceOp op, int64_t key, uint64_t size, int64_t value = 0)
+        {
+            buffer.push_back(static_cast<unsigned char>(op));
+            if (hasKey(op))
+                trace_detail::putVarint(buffer, trace_detail::zigzag(key));
+            if (op == TraceOp::insert_at)
+                trace_detail::putVarint(buffer, trace_detail::zigzag(value));
+            trace_detail::putVarint(buffer, trace_detail::zigzag(int64_t(size - lastSize)));
+            lastSize = size;
+            ++records;
+
+            if (buffer.size() >= BUFFER)
+                flush();
+        }
+
+        /**
+         * @brief Writes the buffered records to the file
+         * @throws std::runtime_error on a write error
+         */
+        void flush()
+        {
+            if (!file)
+                throw std::logic_error("TraceWriter: Write after close!");
+
+            if (std::fwrite(buffer.data(), 1, buffer.size(), file) != buffer.size() || std::fflush(file) != 0)
+                trace_detail::fail("Cannot write", path);
+            buffer.clear();
+        }
+
+        /**
+         * @brief Flushes and closes the file
+         * @throws std::runtime_error on a write error
+         */
+        void close()
+        {
+            flush();
+            std::FILE *closing = file;
+            file = nullptr;
+            if (std::fclose(closing) != 0)
+                trace_detail::fail("Cannot write", path);
+        }
+
+        uint64_t count() const { return records; }
+
+    private:
+        static const size_t BUFFER = 64 * 1024;
+
+        std::string path;
+        std::FILE *file;
+        std::vector<unsigned char> buffer;
+        uint64_t lastSize;
+        uint64_t records;
+    };
+
+    /**
+     * @brief Reads a whole trace file into memory
+     * @throws std::runtime_error when the file cannot be read or is not a
+     * valid trace
+     */
+    inline Trace readTrace(const std::string &path)
+    {
+        std::FILE *file = std::fopen(path.c_str(), "rb");
+        if (!file)
+            trace_detail::fail("Cannot open", path);
+
+        std::vector<unsigned char> bytes;
+        unsigned char chunk[64 * 1024];
+        size_t got;
+        while ((got = std::fread(chunk, 1, sizeof(chunk), file)) > 0)
+            bytes.insert(bytes.end(), chunk, chunk + got);
+        bool failed = std::ferror(file) != 0;
+        std::fclose(file);
+        if (failed)
+            trace_detail::fail("Cannot read", path);
+
+        if (bytes.size() < 6 || std::memcmp(bytes.data(), trace_detail::MAGIC, 4) != 0)
+            throw std::runtime_error("Trace: " + path + " is not a trace");
+        if (bytes[4] != trace_detail::VERSION || bytes[5] > static_cast<unsigned char>(TraceTarget::bst))
+            throw std::runtime_error("Trace: " + path + " has an unknown version or target");
+
+        Trace trace;
+        trace.target = static_cast<TraceTarget>(bytes[5]);
+
+        const unsigned char *pos = bytes.data() + 6, *end = bytes.data() + bytes.size();
+        uint64_t size = 0;
+        while (pos < end)
+        {
+            TraceRecord record;
+            uint64_t key = 0, value = 0, delta;
+            if (*pos >= TRACE_OPS)
+                throw std::runtime_error("Trace: " + path + " has an unknown operation");
+            record.op = static_cast<TraceOp>(*pos++);
+            if ((hasKey(record.op) && !trace_detail::getVarint(pos, end, key)) ||
+                (record.op == TraceOp::insert_at && !trace_detail::getVarint(pos, end, value)) ||
+                !trace_detail::getVarint(pos, end, delta))
+                throw std::runtime_error("Trace: " + path + " is truncated");
+
+            record.key = trace_detail::unzigzag(key);
+            record.value = trace_detail::unzigzag(value);
+            size += uint64_t(trace_detail::unzigzag(delta));
+            record.size = size;
+            trace.records.push_back(record);
+        }
+        return trace;
+    }
+
+    /**
+     * @brief Records the operations on a dynamic_array
+     */
+    template <typename T>
+    class TracedArray
+    {
+        static_assert(std::is_integral<T>::value, "Traces record integral keys");
+
+    public:
+        TracedArray(dynamic_array<T> &array, TraceWriter &writer) : array(array), writer(writer) {}
+
+        void push_back(const T &value)
+        {
+            unsigned int size = array.size();
+            array.push_back(value);
+            writer.write(TraceOp::push_back, int64_t(value), size);
+        }
+
+        void pop_back()
+        {
+            unsigned int size = array.size();
+            array.pop_back();
+            writer.write(TraceOp::pop_back, 0, size);
+        }
+
+        void insert(unsigned int position, const T &value)
+        {
+            unsigned int size = array.size();
+            array.insert(position, value);
+            writer.write(TraceOp::insert_at, position, size, int64_t(value));
+        }
+
+        void erase(unsigned int position)
+        {
+            unsigned int size = array.size();
+            array.erase(position);
+            writer.write(TraceOp::erase_at, position, size);
+        }
+
+        // Recorded as at(index)
+        T &operator[](unsigned int index) { return at(index); }
+
+        T &at(unsigned int index)
+        {
+            T &value = array.at(index);
+            writer.write(TraceOp::at, index, array.size());
+            return value;
+        }
+
+        T &front()
+        {
+            T &value = array.front();
+            writer.write(TraceOp::front, 0, array.size());
+            return value;
+        }
+
+        T &back()
+        {
+            T &value = array.back();
+            writer.write(TraceOp::back, 0, array.size());
+            return value;
+        }
+
+        unsigned int size() const { return array.size(); }
+        bool empty() const { return array.empty(); }
+
+    private:
+        dynamic_array<T> &array;
+        TraceWriter &writer;
+    };
+
+    /**
+     * @brief Records the operations at the ends of a List
+     *
+     * Positional insert and erase take iterators, whose index the list does
+     * not know, so they are not recorded; use the list directly for them.
+     */
+    template <typename T>
+    class TracedList
+    {
+        static_assert(std::is_integral<T>::value, "Traces record integral keys");
+
+    public:
+        TracedList(List<T> &list, TraceWriter &writer) : list(list), writer(writer) {}
+
+        void push_back(const T &value)
+        {
+            size_t size = list.size();
+            list.push_back(value);
+            writer.write(TraceOp::push_back, int64_t(value), size);
+        }
+
+        void push_front(const T &value)
+        {
+            size_t size = list.size();
+            list.push_front(value);
+            writer.write(TraceOp::push_front, int64_t(value), size);
+        }
+
+        void pop_back()
+        {
+            size_t size = list.size();
+            list.pop_back();
+            writer.write(TraceOp::pop_back, 0, size);
+        }
+
+        void pop_front()
+        {
+            size_t size = list.size();
+            list.pop_front();
+            writer.write(TraceOp::pop_front, 0, size);
+        }
+
+        T &front()
+        {
+            T &value = list.front();
+            writer.write(TraceOp::front, 0, list.size());
+            return value;
+        }
+
+        T &back()
+        {
+            T &value = list.back();
+            writer.write(TraceOp::back, 0, list.size());
+            return value;
+        }
+
+        size_t size() const { return list.size(); }
+        bool empty() const { return list.empty(); }
+
+    private:
+        List<T> &list;
+        TraceWriter &writer;
+    };
+
+    /**
+     * @brief Records the operations on a min-heap (BinaryHeap<T>::less)
+     *
+     * The format does not store the ordering and traces are replayed as
+     * min-heaps, so other heaps cannot be recorded.
+     * @throws std::invalid_argument for a heap built with another comparison
+     */
+    template <typename T>
+    class TracedHeap
+    {
+        static_assert(std::is_integral<T>::value, "Traces record integral keys");
+
+    public:
+        TracedHeap(BinaryHeap<T> &heap, TraceWriter &writer) : heap(heap), writer(writer)
+        {
+            if (heap.comparator() != BinaryHeap<T>::less)
+                throw std::invalid_argument("TracedHeap: Only min-heaps (BinaryHeap<T>::less) can be traced!");
+        }
+
+        void push(const T &value)
+        {
+            size_t size = heap.size();
+            heap.push(value);
+            writer.write(TraceOp::push, int64_t(value), size);
+        }
+
+        void pop()
+        {
+            size_t size = heap.size();
+            heap.pop();
+            writer.write(TraceOp::pop, 0, size);
+        }
+
+        const T &top()
+        {
+            const T &value = heap.top();
+            writer.write(TraceOp::top, 0, heap.size());
+            return value;
+        }
+
+        size_t size() const { return heap.size(); }
+        bool isEmpty() const { return heap.isEmpty(); }
+
+    private:
+        BinaryHeap<T> &heap;
+        TraceWriter &writer;
+    };
+
+    /**
+     * @brief Records the operations on a BST
+     *
+     * The tree does not count its elements, so the wrapper does; wrap an
+     * empty tree.
+     */
+    template <typename T>
+    class TracedBST
+    {
+        static_assert(std::is_integral<T>::value, "Traces record integral keys");
+
+    public:
+        TracedBST(BST<T> &tree, TraceWriter &writer) : tree(tree), writer(writer), count(0) {}
+
+        void insert(const T &key)
+        {
+            tree.insert(key);
+            writer.write(TraceOp::insert, int64_t(key), count++);
+        }
+
+        void remove(const T &key)
+        {
+            tree.remove(key);
+            writer.write(TraceOp::remove, int64_t(key), count--);
+        }
+
+        bool contains(const T &key)
+        {
+            bool found = tree.contains(key);
+            writer.write(TraceOp::contains, int64_t(key), count);
+            return found;
+        }
+
+        size_t size() const { return count; }
+
+    private:
+        BST<T> &tree;
+        TraceWriter &writer;
+        size_t count;
+    };
+} // namespace ds
+
+#endif // TRACE_HPP_GUARD_
@@ -0,0 +1,113 @@
+// Replays an operation trace (see trace.hpp) against the ds container it was
+// recorded from and against its standard library alternatives, with wall
+// time and hardware counters per operation (see benchmark.hpp). Every replay
+// must read the same values and end with the size the trace ends with.
+//
+// g++ -std=c++17 -O2 trace_replay.cpp -o trace_replay
+// ./trace_replay orders.trace [--json results.json]
+
+#include "benchmark.hpp"
+#include "trace_replay.hpp"
+
+#include <iostream>
+
+using namespace ds;
+
+// Replays trace into container as one benchmark case; false if the replay
+// disagrees with the trace or with the previous replays
+template <typename Container>
+static bool run(bench::Benchmark &bench, const Trace &trace, const std::string &name, Container &container,
+                bool &first, uint64_t &checksum)
+{
+    ReplayResult result;
+    bench.run(name, trace.records.size(), [&] { result = replay(trace, container); });
+
+    if (result.size != trace.finalSize() || (!first && result.checksum != checksum))
+    {
+        std::cerr << name << " disagrees with the trace: size " << result.size << " (expected "
+                  << trace.finalSize() << "), checksum " << result.checksum << "\n";
+        return false;
+    }
+
+    first = false;
+    checksum = result.checksum;
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 2 || argv[1][0] == '-')
+    {
+        std::cerr << "Usage: " << argv[0] << " TRACE [--json FILE]\n";
+        return 2;
+    }
+
+    Trace trace;
+    try
+    {
+        trace = readTrace(argv[1]);
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << e.what() << "\n";
+        return 1;
+    }
+
+    std::cout << argv[1] << ": " << trace.records.size() << " operations on " << describe(trace.target)
+              << ", peak size " << trace.peakSize() << "\n";
+
+    bench::Benchmark bench(std::string("replay ") + argv[1], argc, argv);
+    bool first = true, agree = true;
+    uint64_t checksum = 0;
+
+    try
+    {
+        switch (trace.target)
+        {
+        case TraceTarget::array:
+        {
+            dynamic_array<long long> arr;
+            std::vector<long long> vec;
+            std::deque<long long> deq;
+            agree = run(bench, trace, "dynamic_array", arr, first, checksum) &&
+                    run(bench, trace, "std::vector", vec, first, checksum) &&
+                    run(bench, trace, "std::deque", deq, first, checksum);
+            break;
+        }
+        case TraceTarget::list:
+        {
+            List<long long> list;
+            std::list<long long> stdList;
+            std::deque<long long> deq;
+            agree = run(bench, trace, "List", list, first, checksum) &&
+                    run(bench, trace, "std::list", stdList, first, checksum) &&
+                    run(bench, trace, "std::deque", deq, first, checksum);
+            break;
+        }
+        case TraceTarget::heap:
+        {
+            BinaryHeap<long long> heap(BinaryHeap<long long>::less);
+            std::priority_queue<long long, std::vector<long long>, std::greater<long long>> queue;
+            agree = run(bench, trace, "BinaryHeap", heap, first, checksum) &&
+                    run(bench, trace, "std::priority_queue", queue, first, checksum);
+            break;
+        }
+        case TraceTarget::bst:
+        {
+            BST<long long> tree;
+            std::set<long long> set;
+            agree = run(bench, trace, "BST", tree, first, checksum) &&
+                    run(bench, trace, "std::set", set, first, checksum);
+            break;
+        }
+        }
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << e.what() << "\n";
+        return 1;
+    }
+
+    int status = bench.finish();
+    return agree ? status : 1;
+}
@@ -0,0 +1,337 @@
+/**
+ * @file trace_replay.hpp
+ * @author Ivan Penev
+ * @brief Re-executes a trace (see trace.hpp) against a container
+ * @date 2026-10-18
+ *
+ *     ds::Trace trace = ds::readTrace("orders.trace");
+ *     std::priority_queue<int, std::vector<int>, std::greater<int>> queue;
+ *     ds::ReplayResult result = ds::replay(trace, queue);
+ *
+ * TraceReplayer<Container> maps the trace operations to the container; it is
+ * specialized here for the ds containers and their standard library
+ * counterparts, and any other implementation is plugged in by specializing
+ * it the same way. The replay reads whatever the operations return into a
+ * checksum, so that the reads are not optimized away and two replays of one
+ * trace can be compared for equal results. Heaps are replayed as min-heaps.
+ */
+
+#ifndef TRACE_REPLAY_HPP_GUARD_
+#define TRACE_REPLAY_HPP_GUARD_
+
+#include <deque>
+#include <functional>
+#include <list>
+#include <queue>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "trace.hpp"
+
+namespace ds
+{
+    namespace trace_detail
+    {
+        inline void unsupported(TraceOp op, const char *container)
+        {
+            throw std::invalid_argument(std::string("TraceReplayer: ") + describe(op) +
+                                        " is not an operation of " + container + "!");
+        }
+
+        // The sequence operations shared by dynamic_array, std::vector,
+        // std::deque, List and std::list
+        template <typename T, typename Sequence>
+        void applyToSequence(Sequence &seq, const TraceRecord &record, uint64_t &checksum, const char *name)
+        {
+            switch (record.op)
+            {
+            case TraceOp::push_back:
+                seq.push_back(T(record.key));
+                break;
+            case TraceOp::pop_back:
+                seq.pop_back();
+                break;
+            case TraceOp::front:
+                checksum += uint64_t(seq.front());
+                break;
+            case TraceOp::back:
+                checksum += uint64_t(seq.back());
+                break;
+            default:
+                unsupported(record.op, name);
+            }
+        }
+    } // namespace trace_detail
+
+    /**
+     * @brief Applies trace records to a Container; specialize it to replay
+     * traces against another implementation
+     *
+     * A specialization provides
+     *     static void apply(Container &, const TraceRecord &, uint64_t &checksum);
+     *     static size_t size(const Container &);
+     */
+    template <typename Container>
+    struct TraceReplayer;
+
+    template <typename T>
+    struct TraceReplayer<dynamic_array<T>>
+    {
+        static void apply(dynamic_array<T> &arr, const TraceRecord &record, uint64_t &checksum)
+        {
+            switch (record.op)
+            {
+            case TraceOp::insert_at:
+                arr.insert((unsigned int)record.key, T(record.value));
+                break;
+            case TraceOp::erase_at:
+                arr.erase((unsigned int)record.key);
+                break;
+            case TraceOp::at:
+                checksum += uint64_t(arr[(unsigned int)record.key]);
+                break;
+            default:
+                trace_detail::applyToSequence<T>(arr, record, checksum, "dynamic_array");
+            }
+        }
+
+        static size_t size(const dynamic_array<T> &arr) { return arr.size(); }
+    };
+
+    template <typename T>
+    struct TraceReplayer<std::vector<T>>
+    {
+        static void apply(std::vector<T> &vec, const TraceRecord &record, uint64_t &checksum)
+        {
+            switch (record.op)
+            {
+            case TraceOp::insert_at:
+                vec.insert(vec.begin() + record.key, T(record.value));
+                break;
+            case TraceOp::erase_at:
+                vec.erase(vec.begin() + record.key);
+                break;
+            case TraceOp::at:
+                checksum += uint64_t(vec[size_t(record.key)]);
+                break;
+            default:
+                trace_detail::applyToSequence<T>(vec, record, checksum, "std::vector");
+            }
+        }
+
+        static size_t size(const std::vector<T> &vec) { return vec.size(); }
+    };
+
+    template <typename T>
+    struct TraceReplayer<std::deque<T>>
+    {
+        static void apply(std::deque<T> &deq, const TraceRecord &record, uint64_t &checksum)
+        {
+            switch (record.op)
+            {
+            case TraceOp::push_front:
+                deq.push_front(T(record.key));
+                break;
+            case TraceOp::pop_front:
+                deq.pop_front();
+                break;
+            case TraceOp::insert_at:
+                deq.insert(deq.begin() + record.key, T(record.value));
+                break;
+            case TraceOp::erase_at:
+                deq.erase(deq.begin() + record.key);
+                break;
+            case TraceOp::at:
+                checksum += uint64_t(deq[size_t(record.key)]);
+                break;
+            default:
+                trace_detail::applyToSequence<T>(deq, record, checksum, "std::deque");
+            }
+        }
+
+        static size_t size(const std::deque<T> &deq) { return deq.size(); }
+    };
+
+    template <typename T>
+    struct TraceReplayer<List<T>>
+    {
+        static void apply(List<T> &list, const TraceRecord &record, uint64_t &checksum)
+        {
+            switch (record.op)
+            {
+            case TraceOp::push_front:
+                list.push_front(T(record.key));
+                break;
+            case TraceOp::pop_front:
+                list.pop_front();
+                break;
+            default:
+                trace_detail::applyToSequence<T>(list, record, checksum, "List");
+            }
+        }
+
+        static size_t size(const List<T> &list) { return list.size(); }
+    };
+
+    template <typename T>
+    struct TraceReplayer<std::list<T>>
+    {
+        static void apply(std::list<T> &list, const TraceRecord &record, uint64_t &checksum)
+        {
+            switch (record.op)
+            {
+            case TraceOp::push_front:
+                list.push_front(T(record.key));
+                break;
+            case TraceOp::pop_front:
+                list.pop_front();
+                break;
+            default:
+                trace_detail::applyToSequence<T>(list, record, checksum, "std::list");
+            }
+        }
+
+        static size_t size(const std::list<T> &list) { return list.size(); }
+    };
+
+    // Construct the heap with BinaryHeap<T>::less; another heap is rejected
+    // with std::invalid_argument
+    template <typename T>
+    struct TraceReplayer<BinaryHeap<T>>
+    {
+        static void apply(BinaryHeap<T> &heap, const TraceRecord &record, uint64_t &checksum)
+        {
+            switch (record.op)
+            {
+            case TraceOp::push:
+                if (heap.comparator() != BinaryHeap<T>::less)
+                    throw std::invalid_argument("TraceReplayer: Heaps are replayed as min-heaps (BinaryHeap<T>::less)!");
+                heap.push(T(record.key));
+                break;
+            case TraceOp::pop:
+                heap.pop();
+                break;
+            case TraceOp::top:
+                checksum += uint64_t(heap.top());
+                break;
+            default:
+                trace_detail::unsupported(record.op, "BinaryHeap");
+            }
+        }
+
+        static size_t size(const BinaryHeap<T> &heap) { return heap.size(); }
+    };
+
+    template <typename T>
+    struct TraceReplayer<std::priority_queue<T, std::vector<T>, std::greater<T>>>
+    {
+        typedef std::priority_queue<T, std::vector<T>, std::greater<T>> Queue;
+
+        static void apply(Queue &queue, const TraceRecord &record, uint64_t &checksum)
+        {
+            switch (record.op)
+            {
+            case TraceOp::push:
+                queue.push(T(record.key));
+                break;
+            case TraceOp::pop:
+                queue.pop();
+                break;
+            case TraceOp::top:
+                checksum += uint64_t(queue.top());
+                break;
+            default:
+                trace_detail::unsupported(record.op, "std::priority_queue");
+            }
+        }
+
+        static size_t size(const Queue &queue) { return queue.size(); }
+    };
+
+    template <typename T>
+    struct TraceReplayer<BST<T>>
+    {
+        static void apply(BST<T> &tree, const TraceRecord &record, uint64_t &checksum)
+        {
+            switch (record.op)
+            {
+            case TraceOp::insert:
+                tree.insert(T(record.key));
+                break;
+            case TraceOp::remove:
+                tree.remove(T(record.key));
+                break;
+            case TraceOp::contains:
+                checksum += tree.contains(T(record.key));
+                break;
+            default:
+                trace_detail::unsupported(record.op, "BST");
+            }
+        }
+
+        // The tree does not count its elements
+        // Time complexity: O(n)
+        static size_t size(const BST<T> &tree)
+        {
+            size_t count = 0;
+            tree.inorder([&count](const T &) { ++count; });
+            return count;
+        }
+    };
+
+    template <typename T>
+    struct TraceReplayer<std::set<T>>
+    {
+        static void apply(std::set<T> &set, const TraceRecord &record, uint64_t &checksum)
+        {
+            switch (record.op)
+            {
+            case TraceOp::insert:
+                set.insert(T(record.key));
+                break;
+            case TraceOp::remove:
+                set.erase(T(record.key));
+                break;
+            case TraceOp::contains:
+                checksum += set.count(T(record.key));
+                break;
+            default:
+                trace_detail::unsupported(record.op, "std::set");
+            }
+        }
+
+        static size_t size(const std::set<T> &set) { return set.size(); }
+    };
+
+    /**
+     * @brief What a replay read and left behind
+     */
+    struct ReplayResult
+    {
+        uint64_t checksum; // sum of the values read by the operations
+        size_t size;       // size of the container afterwards
+    };
+
+    /**
+     * @brief Applies every record of trace to container, which should be
+     * empty
+     * @throws std::invalid_argument when the container does not support an
+     * operation of the trace
+     */
+    template <typename Container>
+    ReplayResult replay(const Trace &trace, Container &container)
+    {
+        typedef TraceReplayer<Container> Replayer;
+
+        uint64_t checksum = 0;
+        for (const TraceRecord &record : trace.records)
+            Replayer::apply(container, record, checksum);
+
+        ReplayResult result = {checksum, Replayer::size(container)};
+        return result;
+    }
+} // namespace ds
+
+#endif // TRACE_REPLAY_HPP_GUARD_
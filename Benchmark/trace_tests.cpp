@@ -0,0 +1,250 @@
+#define CATCH_CONFIG_MAIN
+#include "../Catch2/catch.hpp"
+#include "trace.hpp"
+#include "trace_replay.hpp"
+
+#include <cstdio>
+#include <filesystem>
+#include <random>
+
+using namespace ds;
+
+static const std::string PATH = (std::filesystem::temp_directory_path() / "ds_trace_tests.trace").string();
+
+TEST_CASE("FORMAT", "[TRACE]")
+{
+    SECTION("ROUND TRIP")
+    {
+        const TraceRecord RECORDS[] = {
+            {TraceOp::push_back, 5, 0, 0},          {TraceOp::push_back, -7, 1, 0},
+            {TraceOp::insert_at, 1, 2, -300},       {TraceOp::at, 2, 3, 0},
+            {TraceOp::pop_back, 0, 3, 0},           {TraceOp::push, INT64_MIN, 2, 0},
+            {TraceOp::push, INT64_MAX, 3, 0},       {TraceOp::contains, 123456789, 4, 0},
+            {TraceOp::erase_at, 0, 4, 0},           {TraceOp::top, 0, 3, 0},
+        };
+
+        {
+            TraceWriter writer(PATH, TraceTarget::heap);
+            for (const TraceRecord &record : RECORDS)
+                writer.write(record.op, record.key, record.size, record.value);
+            REQUIRE(writer.count() == 10);
+        }
+
+        Trace trace = readTrace(PATH);
+        REQUIRE(trace.target == TraceTarget::heap);
+        REQUIRE(trace.records.size() == 10);
+        for (size_t i = 0; i < 10; i++)
+        {
+            REQUIRE(trace.records[i].op == RECORDS[i].op);
+            REQUIRE(trace.records[i].size == RECORDS[i].size);
+            if (hasKey(RECORDS[i].op))
+                REQUIRE(trace.records[i].key == RECORDS[i].key);
+            REQUIRE(trace.records[i].value == RECORDS[i].value);
+        }
+        REQUIRE(trace.finalSize() == 3);
+        REQUIRE(trace.peakSize() == 4);
+    }
+
+    SECTION("COMPACT")
+    {
+        {
+            TraceWriter writer(PATH, TraceTarget::array);
+            for (int i = 0; i < 100000; i++)
+                writer.write(TraceOp::push_back, i % 64, i);
+            for (int i = 100000; i > 0; i--)
+                writer.write(TraceOp::pop_back, 0, i);
+            writer.close();
+        }
+
+        std::FILE *file = std::fopen(PATH.c_str(), "rb");
+        std::fseek(file, 0, SEEK_END);
+        long bytes = std::ftell(file);
+        std::fclose(file);
+
+        REQUIRE(bytes == 6 + 100000 * 3 + 100000 * 2);
+        REQUIRE(readTrace(PATH).finalSize() == 0);
+        REQUIRE(readTrace(PATH).peakSize() == 100000);
+    }
+
+    SECTION("INVALID FILES")
+    {
+        REQUIRE_THROWS_AS(readTrace(PATH + ".missing"), std::runtime_error);
+
+        std::FILE *file = std::fopen(PATH.c_str(), "wb");
+        std::fputs("not a trace", file);
+        std::fclose(file);
+        REQUIRE_THROWS_AS(readTrace(PATH), std::runtime_error);
+
+        {
+            TraceWriter writer(PATH, TraceTarget::bst);
+            writer.write(TraceOp::insert, 1000000, 0);
+        }
+        std::filesystem::resize_file(PATH, 8); // cuts the key
+        REQUIRE_THROWS_AS(readTrace(PATH), std::runtime_error);
+    }
+
+    std::remove(PATH.c_str());
+}
+
+TEST_CASE("RECORD AND REPLAY", "[TRACE]")
+{
+    std::mt19937 rng(11);
+    uint64_t reads = 0; // what the recorded program read, as the replay sums it
+
+    SECTION("DYNAMIC ARRAY")
+    {
+        {
+            TraceWriter writer(PATH, TraceTarget::array);
+            dynamic_array<int> arr;
+            TracedArray<int> traced(arr, writer);
+            for (int i = 0; i < 20000; i++)
+            {
+                unsigned int op = rng() % 6;
+                if (traced.empty() || op == 0)
+                    traced.push_back(int(rng() % 1000) - 500);
+                else if (op == 1)
+                    traced.pop_back();
+                else if (op == 2)
+                    traced.insert(rng() % traced.size(), i);
+                else if (op == 3)
+                    traced.erase(rng() % traced.size());
+                else if (op == 4)
+                    reads += uint64_t(traced[rng() % traced.size()]);
+                else
+                    reads += uint64_t(traced.front()) + uint64_t(traced.back());
+            }
+        }
+
+        Trace trace = readTrace(PATH);
+        REQUIRE(trace.target == TraceTarget::array);
+
+        dynamic_array<int> arr;
+        std::vector<int> vec;
+        std::deque<int> deq;
+        ReplayResult own = replay(trace, arr);
+        REQUIRE(own.checksum == reads);
+        REQUIRE(own.size == trace.finalSize());
+        REQUIRE(replay(trace, vec).checksum == reads);
+        REQUIRE(replay(trace, deq).checksum == reads);
+        REQUIRE(vec.size() == arr.size());
+    }
+
+    SECTION("LIST")
+    {
+        {
+            TraceWriter writer(PATH, TraceTarget::list);
+            List<int> list;
+            TracedList<int> traced(list, writer);
+            for (int i = 0; i < 20000; i++)
+            {
+                unsigned int op = rng() % 5;
+                if (traced.empty() || op == 0)
+                    traced.push_back(i);
+                else if (op == 1)
+                    traced.push_front(-i);
+                else if (op == 2)
+                    traced.pop_front();
+                else if (op == 3)
+                    traced.pop_back();
+                else
+                    reads += uint64_t(traced.front()) + uint64_t(traced.back());
+            }
+        }
+
+        Trace trace = readTrace(PATH);
+        List<int> list;
+        std::list<int> stdList;
+        std::deque<int> deq;
+        REQUIRE(replay(trace, list).checksum == reads);
+        REQUIRE(replay(trace, stdList).checksum == reads);
+        REQUIRE(replay(trace, deq).checksum == reads);
+        REQUIRE(list.size() == trace.finalSize());
+    }
+
+    SECTION("BINARY HEAP")
+    {
+        {
+            TraceWriter writer(PATH, TraceTarget::heap);
+            BinaryHeap<int> heap(BinaryHeap<int>::less);
+            TracedHeap<int> traced(heap, writer);
+            for (int i = 0; i < 20000; i++)
+            {
+                unsigned int op = rng() % 3;
+                if (traced.isEmpty() || op == 0)
+                    traced.push(int(rng() % 100000));
+                else if (op == 1)
+                    traced.pop();
+                else
+                    reads += uint64_t(traced.top());
+            }
+        }
+
+        Trace trace = readTrace(PATH);
+        BinaryHeap<int> heap(BinaryHeap<int>::less);
+        std::priority_queue<int, std::vector<int>, std::greater<int>> queue;
+        REQUIRE(replay(trace, heap).checksum == reads);
+        REQUIRE(replay(trace, queue).checksum == reads);
+        REQUIRE(heap.size() == trace.finalSize());
+    }
+
+    SECTION("BST")
+    {
+        {
+            TraceWriter writer(PATH, TraceTarget::bst);
+            BST<int> tree;
+            TracedBST<int> traced(tree, writer);
+            for (int i = 0; i < 20000; i++)
+            {
+                int key = int(rng() % 2000);
+                if (traced.contains(key))
+                {
+                    ++reads;
+                    if (rng() % 2)
+                        traced.remove(key);
+                }
+                else
+                    traced.insert(key);
+            }
+        }
+
+        Trace trace = readTrace(PATH);
+        BST<int> tree;
+        std::set<int> set;
+        ReplayResult own = replay(trace, tree);
+        REQUIRE(own.checksum == reads);
+        REQUIRE(own.size == trace.finalSize());
+        REQUIRE(replay(trace, set).checksum == reads);
+        REQUIRE(set.size() == trace.finalSize());
+    }
+
+    SECTION("MAX-HEAP")
+    {
+        // The trace would not tell the replay to pop the largest element
+        TraceWriter writer(PATH, TraceTarget::heap);
+        BinaryHeap<int> maxHeap(BinaryHeap<int>::greater);
+        REQUIRE_THROWS_AS(TracedHeap<int>(maxHeap, writer), std::invalid_argument);
+
+        BinaryHeap<int> minHeap(BinaryHeap<int>::less);
+        TracedHeap<int> traced(minHeap, writer);
+        traced.push(1);
+        writer.close();
+
+        REQUIRE_THROWS_AS(replay(readTrace(PATH), maxHeap), std::invalid_argument);
+        BinaryHeap<int> replayed(BinaryHeap<int>::less);
+        REQUIRE(replay(readTrace(PATH), replayed).size == 1);
+    }
+
+    SECTION("UNSUPPORTED OPERATION")
+    {
+        {
+            TraceWriter writer(PATH, TraceTarget::array);
+            writer.write(TraceOp::push_back, 1, 0);
+            writer.write(TraceOp::at, 0, 1);
+        }
+
+        List<int> list;
+        REQUIRE_THROWS_AS(replay(readTrace(PATH), list), std::invalid_argument);
+    }
+
+    std::remove(PATH.c_str());
+}
@@ -1,8 +1,14 @@
 #ifndef BST_HPP_GUARD_
 #define BST_HPP_GUARD_
 
+#include <cstddef>
+#include <new>
 #include <stdexcept>
 
+#include "../Common/allocation_seal.hpp"
+#include "../Common/expected.hpp"
+#include "../Common/latency_histogram.hpp"
+
 namespace ds
 {
     template <typename DataType>
@@ -20,6 +26,10 @@ namespace ds
                   left(nullptr), right(nullptr) {}
         } * root;
 
+        NodePool<Node> pool{"BST"}; // spare nodes
+
+        LatencyRecorder *latency = nullptr;
+
     public:
         BST();
 
@@ -29,10 +39,37 @@ namespace ds
 
         void insert(const DataType &data);
 
+        // Like insert(), but an element already in the tree gives Errc::duplicate
+        Expected<void> try_insert(const DataType &data);
+
         void remove(const DataType &data);
 
         bool contains(const DataType &data);
 
+        // Looks up every key of [first, last) and writes whether it is in the
+        // tree to out, in order. Up to LOOKUP_BATCH walks advance in turn, so
+        // their cache misses overlap instead of following one another.
+        template <typename InputIt, typename OutputIt>
+        void containsBatch(InputIt first, InputIt last, OutputIt out) const;
+
+        // Visits every element in ascending order
+        template <typename Visitor>
+        void inorder(Visitor visit) const;
+
+        // Keeps spare nodes, so that count elements fit without allocating;
+        // removed nodes are kept as spares up to count
+        void reserve(size_t count) { pool.reserve(count); }
+
+        // Reports every following allocation to the seal hook
+        // (see Common/allocation_seal.hpp)
+        void seal() { pool.seal(); }
+        void unseal() { pool.unseal(); }
+        bool isSealed() const { return pool.isSealed(); }
+
+        // Times insert, remove (as erase) and contains (as find) into
+        // recorder (see Common/latency_histogram.hpp); nullptr turns it off
+        void setLatencyRecorder(LatencyRecorder *recorder) { latency = recorder; }
+
         ~BST();
 
         /* Helpers */
@@ -46,6 +83,11 @@ namespace ds
         void copyFrom(Node *root); // TODO
 
         void freeTree(Node *root);
+
+        template <typename Visitor>
+        static void inorder(const Node *root, Visitor &visit);
+
+        static const size_t LOOKUP_BATCH = 16;
     };
 
     template <typename DataType>
@@ -71,21 +113,37 @@ namespace ds
         {
             freeTree(root->left);
             freeTree(root->right);
-            delete root;
+            pool.destroy(root);
         }
     }
 
     template <typename DataType>
     inline void BST<DataType>::insert(const DataType &data)
     {
+        LatencyScope timer(latency, LatencyOp::insert);
+        Node *&node = find(root, data);
+
+        if (node)
+        {
+            DS_THROW(std::logic_error, "BST: A node with this data is already inserted!");
+        }
+
+        node = pool.create(data);
+    }
+
+    template <typename DataType>
+    inline Expected<void> BST<DataType>::try_insert(const DataType &data)
+    {
+        LatencyScope timer(latency, LatencyOp::insert);
         Node *&node = find(root, data);
 
         if (node)
         {
-            throw std::logic_error("BST: A node with this data is already inserted!");
+            return Unexpected(Errc::duplicate);
         }
 
-        node = new Node(data);
+        node = pool.create(data);
+        return Expected<void>();
     }
 
     template <typename DataType>
@@ -109,26 +167,27 @@ namespace ds
     template <typename DataType>
     inline void BST<DataType>::remove(const DataType &data)
     {
+        LatencyScope timer(latency, LatencyOp::erase);
         Node *&node = find(root, data);
 
         if (!node->left && !node->right)
         {
             // The node to be removed is leaf
-            delete node;
+            pool.destroy(node);
             node = nullptr;
         }
         else if (!node->left)
         {
             // The node to be removed has only one right child
             Node *right = node->right;
-            delete node;
+            pool.destroy(node);
             node = right;
         }
         else if (!node->right)
         {
             // The node to be removed has only one left child
             Node *left = node->left;
-            delete node;
+            pool.destroy(node);
             node = left;
         }
         else
@@ -137,23 +196,128 @@ namespace ds
             // Find the max record in the left subtree and swap with the node
             Node *&maxLeft = max(node->left);
             node->data = maxLeft->data;
-            delete maxLeft;
-            maxLeft = nullptr;
+
+            // The max has no right child, but may still have a left subtree
+            Node *left = maxLeft->left;
+            pool.destroy(maxLeft);
+            maxLeft = left;
         }
     }
 
     template <typename DataType>
     inline bool BST<DataType>::contains(const DataType &data)
     {
+        LatencyScope timer(latency, LatencyOp::find);
         return find(root, data) != nullptr;
     }
 
+    template <typename DataType>
+    template <typename Visitor>
+    inline void BST<DataType>::inorder(Visitor visit) const
+    {
+        inorder(root, visit);
+    }
+
+    template <typename DataType>
+    template <typename Visitor>
+    inline void BST<DataType>::inorder(const Node *root, Visitor &visit)
+    {
+        if (root)
+        {
+            inorder(root->left, visit);
+            visit(root->data);
+            inorder(root->right, visit);
+        }
+    }
+
+    template <typename DataType>
+    template <typename InputIt, typename OutputIt>
+    inline void BST<DataType>::containsBatch(InputIt first, InputIt last, OutputIt out) const
+    {
+        struct Walk
+        {
+            DataType key;
+            const Node *node;
+            bool done;
+        };
+
+        // Raw storage for one batch - a lookup does not allocate
+        struct Batch
+        {
+            alignas(Walk) unsigned char bytes[LOOKUP_BATCH * sizeof(Walk)];
+            size_t size = 0;
+
+            Walk *walks() { return reinterpret_cast<Walk *>(bytes); }
+
+            void clear()
+            {
+                for (; size > 0; size--)
+                    walks()[size - 1].~Walk();
+            }
+
+            ~Batch() { clear(); }
+        };
+
+        // Fills LOOKUP_BATCH slots, advances each unfinished walk by one node
+        // in turn, and writes the results of a batch once it is done
+        Batch batch;
+        Walk *walks = batch.walks();
+        while (first != last)
+        {
+            batch.clear();
+            for (; batch.size < LOOKUP_BATCH && first != last; ++first, ++batch.size)
+                new (walks + batch.size) Walk{*first, root, root == nullptr};
+
+            size_t count = batch.size;
+            size_t pending = count;
+            for (size_t i = 0; i < count; i++)
+                pending -= walks[i].done;
+
+            while (pending > 0)
+            {
+                for (size_t i = 0; i < count; i++)
+                {
+                    Walk &walk = walks[i];
+                    if (walk.done)
+                        continue;
+
+                    if (walk.node->data == walk.key)
+                    {
+                        walk.done = true;
+                        --pending;
+                        continue;
+                    }
+
+                    walk.node = walk.key < walk.node->data ? walk.node->left : walk.node->right;
+                    if (walk.node)
+                    {
+                        // Both children, before the comparison picks one
+                        __builtin_prefetch(walk.node->left);
+                        __builtin_prefetch(walk.node->right);
+                    }
+                    else
+                    {
+                        walk.done = true;
+                        --pending;
+                    }
+                }
+            }
+
+            for (size_t i = 0; i < count; i++)
+                *out++ = walks[i].node != nullptr;
+        }
+    }
+
     template <typename DataType>
     inline typename BST<DataType>::Node *&BST<DataType>::find(Node *&root, const DataType &key)
     {
         if (!root || root->data == key)
             return root;
 
+        // The next node is one of the children - start loading both
+        __builtin_prefetch(root->left);
+        __builtin_prefetch(root->right);
+
         if (key < root->data)
             return find(root->left, key);
         else
@@ -0,0 +1,54 @@
+// Lookups in a BST of 4M random keys (far larger than the last level
+// cache): contains() one key at a time against containsBatch(), which
+// advances 16 walks in turn so their cache misses overlap.
+//
+// g++ -std=c++17 -O2 bst_lookup_bench.cpp -o bst_lookup_bench
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "BST.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+int main()
+{
+    const size_t N = 1 << 22, LOOKUPS = 1 << 21;
+    std::mt19937_64 rng(11);
+
+    ds::BST<unsigned long long> tree;
+    std::vector<unsigned long long> inserted(N);
+    for (size_t i = 0; i < N; i++)
+    {
+        inserted[i] = rng() | 1; // odd keys - collisions are negligible
+        tree.insert(inserted[i]);
+    }
+
+    // Half hits, half misses (even keys)
+    std::vector<unsigned long long> keys(LOOKUPS);
+    for (size_t i = 0; i < LOOKUPS; i++)
+        keys[i] = i & 1 ? inserted[rng() % N] : rng() & ~1ull;
+
+    auto start = Clock::now();
+    size_t found = 0;
+    for (unsigned long long key : keys)
+        found += tree.contains(key);
+    double single = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / LOOKUPS;
+
+    std::vector<char> results(LOOKUPS);
+    start = Clock::now();
+    tree.containsBatch(keys.begin(), keys.end(), results.begin());
+    double batched = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / LOOKUPS;
+
+    size_t batchFound = 0;
+    for (char result : results)
+        batchFound += result;
+
+    std::cout << N << " keys\n"
+              << "  contains     : " << single << " ns/lookup\n"
+              << "  containsBatch: " << batched << " ns/lookup\n"
+              << "(found " << found << " / " << batchFound << ")\n";
+    return 0;
+}
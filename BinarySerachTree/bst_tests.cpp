@@ -0,0 +1,99 @@
+#define CATCH_CONFIG_MAIN
+#include "../Catch2/catch.hpp"
+#include "../Common/catch_no_exceptions.hpp"
+#include "BST.hpp"
+
+#include <algorithm>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace ds;
+
+TEST_CASE("OPERATIONS", "[INSERT][REMOVE][CONTAINS]")
+{
+    BST<int> tree;
+    for (int key : {50, 30, 70, 20, 40, 60, 80})
+        tree.insert(key);
+
+    REQUIRE(tree.contains(40));
+    REQUIRE_FALSE(tree.contains(45));
+    REQUIRE_THROWS_AS(tree.insert(40), std::logic_error);
+
+    tree.remove(30); // two children
+    tree.remove(80); // leaf
+    REQUIRE_FALSE(tree.contains(30));
+    REQUIRE_FALSE(tree.contains(80));
+
+    std::vector<int> ordered;
+    tree.inorder([&](int key)
+                 { ordered.push_back(key); });
+    REQUIRE(ordered == std::vector<int>{20, 40, 50, 60, 70});
+}
+
+TEST_CASE("TRY API", "[NOEXCEPT]")
+{
+    BST<int> tree;
+
+    REQUIRE(tree.try_insert(2));
+    REQUIRE(tree.try_insert(1));
+    REQUIRE(tree.try_insert(2).error() == Errc::duplicate);
+    REQUIRE(tree.contains(1));
+    REQUIRE(tree.contains(2));
+}
+
+TEST_CASE("BATCHED LOOKUP", "[CONTAINS]")
+{
+    SECTION("EMPTY TREE")
+    {
+        BST<int> tree;
+        std::vector<int> keys = {1, 2, 3};
+        std::vector<bool> found;
+
+        tree.containsBatch(keys.begin(), keys.end(), std::back_inserter(found));
+        REQUIRE(found == std::vector<bool>{false, false, false});
+    }
+
+    SECTION("AGAINST CONTAINS")
+    {
+        std::mt19937 rng(5);
+        BST<int> tree;
+        std::set<int> inserted;
+        while (inserted.size() < 5000)
+        {
+            int key = (int)(rng() % 20000);
+            if (inserted.insert(key).second)
+                tree.insert(key);
+        }
+
+        // Not a multiple of the batch size, with repeated keys
+        std::vector<int> keys(1237);
+        for (int &key : keys)
+            key = (int)(rng() % 20000);
+
+        std::vector<bool> found;
+        tree.containsBatch(keys.begin(), keys.end(), std::back_inserter(found));
+
+        REQUIRE(found.size() == keys.size());
+        for (size_t i = 0; i < keys.size(); i++)
+            REQUIRE(found[i] == (inserted.count(keys[i]) == 1));
+    }
+    SECTION("KEYS WITH A DESTRUCTOR")
+    {
+        BST<std::string> tree;
+        for (int i = 0; i < 100; i += 2)
+            tree.insert(std::string(40, 'a') + std::to_string(i));
+
+        std::vector<std::string> keys;
+        for (int i = 0; i < 50; i++)
+            keys.push_back(std::string(40, 'a') + std::to_string(i));
+
+        std::vector<bool> found;
+        tree.containsBatch(keys.begin(), keys.end(), std::back_inserter(found));
+
+        REQUIRE(found.size() == 50);
+        for (int i = 0; i < 50; i++)
+            REQUIRE(found[i] == (i % 2 == 0));
+    }
+}
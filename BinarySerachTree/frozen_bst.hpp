@@ -0,0 +1,196 @@
+/**
+ * @file frozen_bst.hpp
+ * @author Ivan Penev
+ * @brief Read-only search tree in implicit (Eytzinger) array layout
+ * @date 2026-10-18
+ *
+ * A pointer based BST pays a dependent cache miss on every level. Once a set
+ * stops changing it can be frozen into an array where node k has its children
+ * at 2k and 2k + 1 (1-based, the same as a binary heap). The search then has
+ * no pointers to chase, compiles to a branchless loop, and the four
+ * grandchildren of a node are adjacent, so they can be prefetched with a
+ * single cache line request two levels ahead.
+ */
+
+#ifndef FROZEN_BST_HPP_GUARD_
+#define FROZEN_BST_HPP_GUARD_
+
+#include <cstddef>
+#include <vector>    // Used as main tree container
+
+#include "BST.hpp"
+
+namespace ds
+{
+    template <typename DataType>
+    class FrozenBST
+    {
+    private:
+        std::vector<DataType> tree; // tree[0] is unused
+        size_t count;
+
+    public:
+        /**
+         * @brief Builds the tree from a sorted sequence without duplicates
+         * @note Time complexity: O(N)
+         *
+         * @param sorted - elements in ascending order
+         */
+        explicit FrozenBST(const std::vector<DataType> &sorted)
+            : tree(sorted.size() + 1), count(sorted.size())
+        {
+            size_t next = 0;
+            build(sorted, next, 1);
+        }
+
+        /**
+         * @brief Freezes a BST. Later changes to the source are not reflected.
+         * @note Time complexity: O(N)
+         */
+        explicit FrozenBST(const BST<DataType> &source)
+            : FrozenBST(collect(source)) {}
+
+        /**
+         * @brief Checks whether the element is in the tree
+         * @note Time complexity: O(logN), branchless
+         */
+        bool contains(const DataType &key) const
+        {
+            size_t k = lowerBound(key);
+            return k != 0 && !(key < tree[k]);
+        }
+
+        /**
+         * @brief Answers many lookups at once. Up to LANES descents run in lock
+         * step so their cache misses overlap instead of following each other.
+         * @note Time complexity: O(M logN) for M keys
+         *
+         * @param first, last - range of keys to look up
+         * @param out - output iterator receiving one bool per key
+         */
+        template <typename InputIterator, typename OutputIterator>
+        OutputIterator containsBatch(InputIterator first, InputIterator last, OutputIterator out) const
+        {
+            static const size_t LANES = 8;
+            const DataType *keys[LANES];
+            size_t k[LANES];
+
+            while (first != last)
+            {
+                size_t lanes = 0;
+                for (; lanes < LANES && first != last; ++first)
+                {
+                    keys[lanes] = &*first;
+                    k[lanes++] = 1;
+                }
+
+                // All lanes are at most one level apart, so the deepest lane
+                // decides how many rounds are needed
+                for (bool active = true; active;)
+                {
+                    active = false;
+                    for (size_t i = 0; i < lanes; i++)
+                    {
+                        if (k[i] <= count)
+                        {
+                            prefetch(4 * k[i]);
+                            k[i] = 2 * k[i] + (tree[k[i]] < *keys[i]);
+                            active = true;
+                        }
+                    }
+                }
+
+                for (size_t i = 0; i < lanes; i++)
+                {
+                    size_t found = finish(k[i]);
+                    *out++ = found != 0 && !(*keys[i] < tree[found]);
+                }
+            }
+
+            return out;
+        }
+
+        /**
+         * @brief Returns the number of elements in the tree
+         */
+        size_t size() const { return count; }
+
+        /**
+         * @brief Checks if the tree is empty
+         */
+        bool isEmpty() const { return count == 0; }
+
+        //
+        /* Helpers */
+    private:
+        static std::vector<DataType> collect(const BST<DataType> &source)
+        {
+            std::vector<DataType> sorted;
+            source.inorder([&sorted](const DataType &value)
+                           { sorted.push_back(value); });
+            return sorted;
+        }
+
+        /**
+         * @brief Fills the subtree rooted at k by an in-order walk, which
+         * consumes the sorted input from left to right
+         */
+        void build(const std::vector<DataType> &sorted, size_t &next, size_t k)
+        {
+            if (k <= count)
+            {
+                build(sorted, next, 2 * k);
+                tree[k] = sorted[next++];
+                build(sorted, next, 2 * k + 1);
+            }
+        }
+
+        /**
+         * @brief Index of the first element not less than key, 0 if none
+         */
+        size_t lowerBound(const DataType &key) const
+        {
+            size_t k = 1;
+            while (k <= count)
+            {
+                prefetch(4 * k);
+                k = 2 * k + (tree[k] < key);
+            }
+
+            return finish(k);
+        }
+
+        /**
+         * @brief Undoes the right turns taken after the last left turn - the
+         * node where the search last went left is the answer
+         */
+        static size_t finish(size_t k)
+        {
+            // k + 1 has as many trailing zeros as k has trailing ones
+#if defined(__GNUC__) || defined(__clang__)
+            size_t rightTurns = __builtin_ctzll(k + 1);
+#else
+            size_t rightTurns = 0;
+            for (size_t bits = k + 1; (bits & 1) == 0; bits >>= 1)
+                ++rightTurns;
+#endif
+
+            return k >> (rightTurns + 1);
+        }
+
+        /**
+         * @brief Requests the grandchildren block of a node (4k .. 4k + 3)
+         */
+        void prefetch(size_t k) const
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            if (k <= count)
+                __builtin_prefetch(tree.data() + k);
+#else
+            (void)k;
+#endif
+        }
+    };
+} // namespace ds
+
+#endif // FROZEN_BST_HPP_GUARD_
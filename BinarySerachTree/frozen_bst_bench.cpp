@@ -0,0 +1,64 @@
+// Lookup throughput: BST::contains vs FrozenBST::contains vs containsBatch
+// on a set much larger than the last level cache.
+//
+// g++ -std=c++17 -O2 frozen_bst_bench.cpp -o frozen_bst_bench
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "frozen_bst.hpp"
+
+template <typename Work>
+double nsPerOp(size_t ops, Work work)
+{
+    auto start = std::chrono::steady_clock::now();
+    work();
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / ops;
+}
+
+int main()
+{
+    const size_t N = 4000000, LOOKUPS = 4000000;
+
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> dist(0, 1 << 30);
+
+    ds::BST<int> bst;
+    for (size_t i = 0; i < N; i++)
+    {
+        int value = dist(rng);
+        if (!bst.contains(value))
+            bst.insert(value);
+    }
+
+    ds::FrozenBST<int> frozen(bst);
+
+    std::vector<int> keys(LOOKUPS);
+    for (int &key : keys)
+        key = dist(rng);
+
+    size_t hits = 0;
+    double pointer = nsPerOp(LOOKUPS, [&]
+                             {
+                                 for (int key : keys)
+                                     hits += bst.contains(key); });
+
+    double implicit = nsPerOp(LOOKUPS, [&]
+                              {
+                                  for (int key : keys)
+                                      hits += frozen.contains(key); });
+
+    std::vector<char> found(LOOKUPS);
+    double batched = nsPerOp(LOOKUPS, [&]
+                             { frozen.containsBatch(keys.begin(), keys.end(), found.begin()); });
+
+    std::cout << "elements: " << frozen.size() << " (hits " << hits << ")\n"
+              << "BST::contains:             " << pointer << " ns/op\n"
+              << "FrozenBST::contains:       " << implicit << " ns/op\n"
+              << "FrozenBST::containsBatch:  " << batched << " ns/op" << std::endl;
+
+    return 0;
+}
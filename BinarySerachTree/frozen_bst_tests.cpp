@@ -0,0 +1,85 @@
+#define CATCH_CONFIG_MAIN
+#include "../Catch2/catch.hpp"
+#include "frozen_bst.hpp"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace ds;
+
+TEST_CASE("FREEZE", "[CONSTRUCTOR]")
+{
+    SECTION("EMPTY")
+    {
+        BST<int> bst;
+        FrozenBST<int> frozen(bst);
+
+        REQUIRE(frozen.isEmpty());
+        REQUIRE_FALSE(frozen.contains(0));
+    }
+
+    SECTION("FROM BST")
+    {
+        BST<int> bst;
+        for (int value : {50, 20, 70, 10, 30, 60, 80, 25})
+            bst.insert(value);
+
+        FrozenBST<int> frozen(bst);
+
+        REQUIRE(frozen.size() == 8);
+        for (int value : {50, 20, 70, 10, 30, 60, 80, 25})
+            REQUIRE(frozen.contains(value));
+        for (int value : {0, 15, 26, 55, 90})
+            REQUIRE_FALSE(frozen.contains(value));
+    }
+}
+
+TEST_CASE("SEARCH", "[CONTAINS][BATCH]")
+{
+    // Every size up to a few full levels - the last level is partially filled
+    for (int n = 1; n <= 70; n++)
+    {
+        std::vector<int> sorted;
+        for (int i = 0; i < n; i++)
+            sorted.push_back(2 * i + 1); // odd numbers only
+
+        FrozenBST<int> frozen(sorted);
+
+        std::vector<int> keys;
+        for (int key = -1; key <= 2 * n + 1; key++)
+            keys.push_back(key);
+
+        std::vector<bool> batch;
+        frozen.containsBatch(keys.begin(), keys.end(), std::back_inserter(batch));
+
+        REQUIRE(batch.size() == keys.size());
+        for (size_t i = 0; i < keys.size(); i++)
+        {
+            bool expected = keys[i] > 0 && keys[i] < 2 * n && keys[i] % 2 != 0;
+            REQUIRE(frozen.contains(keys[i]) == expected);
+            REQUIRE(batch[i] == expected);
+        }
+    }
+}
+
+TEST_CASE("MATCHES BST", "[CONTAINS]")
+{
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> dist(0, 100000);
+
+    BST<int> bst;
+    for (int i = 0; i < 5000; i++)
+    {
+        int value = dist(rng);
+        if (!bst.contains(value))
+            bst.insert(value);
+    }
+
+    FrozenBST<int> frozen(bst);
+    for (int i = 0; i < 20000; i++)
+    {
+        int key = dist(rng);
+        REQUIRE(frozen.contains(key) == bst.contains(key));
+    }
+}
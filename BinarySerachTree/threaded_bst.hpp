@@ -0,0 +1,348 @@
+/**
+ * @file threaded_bst.hpp
+ * @author Ivan Penev
+ * @brief Threaded binary search tree with stackless in-order iteration
+ * @date 2026-10-18
+ *
+ * In ds::BST half of the child links are null and an ordered walk needs a
+ * stack. Here a missing left child links to the in-order predecessor and a
+ * missing right child to the in-order successor. The lowest bit of every link
+ * tells whether it is a child or such a thread, so nodes stay the size of BST
+ * nodes. From any node the successor is either the right thread or the
+ * leftmost node of the right subtree; a full scan follows every link at most
+ * twice - O(1) amortized per step, in both directions, without a stack.
+ */
+
+#ifndef THREADED_BST_HPP_GUARD_
+#define THREADED_BST_HPP_GUARD_
+
+#include <cassert>   // Used to validate invariants
+#include <cstddef>
+#include <cstdint>
+#include <iterator>  // std::bidirectional_iterator_tag
+#include <stdexcept> // Exception handling
+
+namespace ds
+{
+    template <typename DataType>
+    class ThreadedBST
+    {
+    private:
+        struct Node;
+
+        /**
+         * @brief A child pointer or a thread, told apart by the lowest bit
+         */
+        class Link
+        {
+        public:
+            static Link child(Node *node) { return Link(reinterpret_cast<uintptr_t>(node)); }
+
+            static Link thread(Node *node) { return Link(reinterpret_cast<uintptr_t>(node) | THREAD); }
+
+            Node *node() const { return reinterpret_cast<Node *>(bits & ~THREAD); }
+
+            bool isThread() const { return bits & THREAD; }
+
+        private:
+            static const uintptr_t THREAD = 1;
+
+            explicit Link(uintptr_t bits) : bits(bits) {}
+
+            uintptr_t bits;
+        };
+
+        struct Node
+        {
+            DataType data;
+            Link left;
+            Link right;
+
+            Node(const DataType &data, Link left, Link right)
+                : data(data), left(left), right(right) {}
+        };
+
+        static_assert(alignof(Node) > 1, "ThreadedBST: the tag bit needs aligned nodes");
+
+        Node *root = nullptr;
+        size_t count = 0;
+
+    public:
+        /**
+         * @brief Bidirectional iterator over the elements in ascending order
+         */
+        class Iterator
+        {
+        public:
+            using iterator_category = std::bidirectional_iterator_tag;
+            using value_type = DataType;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const DataType *;
+            using reference = const DataType &;
+
+            const DataType &operator*() const { return node->data; }
+
+            const DataType *operator->() const { return &node->data; }
+
+            /**
+             * @brief Moves to the next element
+             * @note Time complexity: O(1) amortized, O(h) worst case
+             */
+            Iterator &operator++()
+            {
+                node = successor(node);
+                return *this;
+            }
+
+            /**
+             * @brief Moves to the previous element; from end() to the largest one
+             * @note Time complexity: O(1) amortized, O(h) worst case
+             */
+            Iterator &operator--()
+            {
+                node = node ? predecessor(node) : rightmost(tree->root);
+                return *this;
+            }
+
+            bool operator==(const Iterator &other) const { return node == other.node; }
+
+            bool operator!=(const Iterator &other) const { return node != other.node; }
+
+        private:
+            friend ThreadedBST;
+
+            Iterator(const ThreadedBST *tree, Node *node) : tree(tree), node(node) {}
+
+            const ThreadedBST *tree;
+            Node *node;
+        };
+
+        ThreadedBST() = default;
+
+        ThreadedBST(const ThreadedBST &) = delete;
+        ThreadedBST &operator=(const ThreadedBST &) = delete;
+
+        ~ThreadedBST()
+        {
+            // The successor of a node is found through its right link, which
+            // does not lead back to the nodes already freed
+            Node *node = leftmost(root);
+            while (node)
+            {
+                Node *next = successor(node);
+                delete node;
+                node = next;
+            }
+        }
+
+        /**
+         * @brief Inserts an element
+         * @note Time complexity: O(h)
+         * @throws std::logic_error if the element is already in the tree
+         */
+        void insert(const DataType &data)
+        {
+            if (!root)
+            {
+                root = new Node(data, Link::thread(nullptr), Link::thread(nullptr));
+                ++count;
+                return;
+            }
+
+            Node *parent = root;
+            for (;;)
+            {
+                if (data < parent->data)
+                {
+                    if (parent->left.isThread())
+                    {
+                        // The new node comes between the predecessor of parent and parent
+                        parent->left = Link::child(new Node(data, parent->left, Link::thread(parent)));
+                        break;
+                    }
+                    parent = parent->left.node();
+                }
+                else if (parent->data < data)
+                {
+                    if (parent->right.isThread())
+                    {
+                        parent->right = Link::child(new Node(data, Link::thread(parent), parent->right));
+                        break;
+                    }
+                    parent = parent->right.node();
+                }
+                else
+                {
+                    throw std::logic_error("ThreadedBST: A node with this data is already inserted!");
+                }
+            }
+            ++count;
+        }
+
+        /**
+         * @brief Removes an element
+         * @note Time complexity: O(h)
+         * @throws std::logic_error if the element is not in the tree
+         */
+        void remove(const DataType &data)
+        {
+            Node *parent = nullptr;
+            Node *node = root;
+            while (node && (data < node->data || node->data < data))
+            {
+                parent = node;
+                const Link &next = data < node->data ? node->left : node->right;
+                node = next.isThread() ? nullptr : next.node();
+            }
+
+            if (!node)
+            {
+                throw std::logic_error("ThreadedBST: The element is not in the tree!");
+            }
+
+            if (!node->left.isThread() && !node->right.isThread())
+            {
+                // Two children - take the data of the successor and remove it
+                // instead; it has no left child
+                parent = node;
+                Node *successor = node->right.node();
+                while (!successor->left.isThread())
+                {
+                    parent = successor;
+                    successor = successor->left.node();
+                }
+                node->data = successor->data;
+                node = successor;
+            }
+
+            unlink(parent, node);
+            delete node;
+            --count;
+        }
+
+        /**
+         * @brief Checks whether the element is in the tree
+         * @note Time complexity: O(h)
+         */
+        bool contains(const DataType &data) const
+        {
+            return find(data) != end();
+        }
+
+        /**
+         * @brief Returns an iterator to the element or end()
+         * @note Time complexity: O(h)
+         */
+        Iterator find(const DataType &data) const
+        {
+            Node *node = root;
+            while (node && (data < node->data || node->data < data))
+            {
+                const Link &next = data < node->data ? node->left : node->right;
+                node = next.isThread() ? nullptr : next.node();
+            }
+            return Iterator(this, node);
+        }
+
+        /**
+         * @brief Iterator to the smallest element
+         * @note Time complexity: O(h)
+         */
+        Iterator begin() const { return Iterator(this, leftmost(root)); }
+
+        Iterator end() const { return Iterator(this, nullptr); }
+
+        /**
+         * @brief Visits every element in ascending order without a stack
+         * @note Time complexity: O(N)
+         */
+        template <typename Visitor>
+        void inorder(Visitor visit) const
+        {
+            for (Node *node = leftmost(root); node; node = successor(node))
+                visit(node->data);
+        }
+
+        /**
+         * @brief Returns the number of elements
+         */
+        size_t size() const { return count; }
+
+        /**
+         * @brief Checks if the tree is empty
+         */
+        bool isEmpty() const { return count == 0; }
+
+        //
+        /* Helpers */
+    private:
+        static Node *leftmost(Node *node)
+        {
+            if (node)
+            {
+                while (!node->left.isThread())
+                    node = node->left.node();
+            }
+            return node;
+        }
+
+        static Node *rightmost(Node *node)
+        {
+            if (node)
+            {
+                while (!node->right.isThread())
+                    node = node->right.node();
+            }
+            return node;
+        }
+
+        static Node *successor(const Node *node)
+        {
+            return node->right.isThread() ? node->right.node() : leftmost(node->right.node());
+        }
+
+        static Node *predecessor(const Node *node)
+        {
+            return node->left.isThread() ? node->left.node() : rightmost(node->left.node());
+        }
+
+        /**
+         * @brief Takes out a node with at most one child, keeping the threads
+         * of its neighbours pointing past it
+         */
+        void unlink(Node *parent, Node *node)
+        {
+            assert(node->left.isThread() || node->right.isThread());
+
+            Link replacement = Link::thread(nullptr);
+            bool isLeft = parent && parent->left.node() == node && !parent->left.isThread();
+
+            if (node->left.isThread() && node->right.isThread())
+            {
+                // Leaf - the parent link becomes the thread the node had on that side
+                replacement = isLeft ? node->left : node->right;
+            }
+            else if (!node->left.isThread())
+            {
+                // Only a left child - its largest node threaded forward to node
+                rightmost(node->left.node())->right = node->right;
+                replacement = node->left;
+            }
+            else
+            {
+                // Only a right child - its smallest node threaded back to node
+                leftmost(node->right.node())->left = node->left;
+                replacement = node->right;
+            }
+
+            if (!parent)
+                root = replacement.isThread() ? nullptr : replacement.node();
+            else if (isLeft)
+                parent->left = replacement;
+            else
+                parent->right = replacement;
+        }
+    };
+} // namespace ds
+
+#endif // THREADED_BST_HPP_GUARD_
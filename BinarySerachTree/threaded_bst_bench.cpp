@@ -0,0 +1,77 @@
+// Full in-order scans of the same random set: ThreadedBST follows threads
+// (no stack), BST::inorder recurses (the call stack holds the path) and
+// std::set climbs parent pointers. All trees are built from the same
+// insertion order, so the BSTs have the same shape.
+//
+// g++ -std=c++17 -O2 threaded_bst_bench.cpp -o threaded_bst_bench
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <set>
+#include <vector>
+
+#include "BST.hpp"
+#include "threaded_bst.hpp"
+
+template <typename Scan>
+double nsPerElement(size_t elements, int rounds, Scan scan)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; r++)
+        scan();
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / (elements * rounds);
+}
+
+int main()
+{
+    for (size_t n : {1000, 100000, 1000000})
+    {
+        std::mt19937 rng(7);
+        std::vector<int> keys;
+        std::set<int> set;
+        while (set.size() < n)
+        {
+            int key = rng();
+            if (set.insert(key).second)
+                keys.push_back(key);
+        }
+
+        ds::BST<int> bst;
+        ds::ThreadedBST<int> threaded;
+        for (int key : keys)
+        {
+            bst.insert(key);
+            threaded.insert(key);
+        }
+
+        const int rounds = 20000000 / n;
+        long long sum = 0;
+
+        double iterator = nsPerElement(n, rounds, [&]
+                                       {
+                                           for (auto it = threaded.begin(); it != threaded.end(); ++it)
+                                               sum += *it; });
+        double reverse = nsPerElement(n, rounds, [&]
+                                      {
+                                          for (auto it = threaded.end(); it != threaded.begin();)
+                                              sum -= *--it; });
+        double recursive = nsPerElement(n, rounds, [&]
+                                        { bst.inorder([&sum](int key)
+                                                      { sum += key; }); });
+        double parents = nsPerElement(n, rounds, [&]
+                                      {
+                                          for (int key : set)
+                                              sum -= key; });
+
+        std::cout << n << " elements"
+                  << "\tThreadedBST forward: " << iterator << " ns"
+                  << "\tbackward: " << reverse << " ns"
+                  << "\tBST::inorder (recursion): " << recursive << " ns"
+                  << "\tstd::set: " << parents << " ns"
+                  << "\t(" << sum << ")" << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,112 @@
+#define CATCH_CONFIG_MAIN
+#include "../Catch2/catch.hpp"
+#include "threaded_bst.hpp"
+
+#include <random>
+#include <set>
+#include <vector>
+
+using namespace ds;
+
+// Walks forwards and backwards and compares with the expected contents
+template <typename T>
+void requireOrder(const ThreadedBST<T> &tree, const std::set<T> &expected)
+{
+    REQUIRE(tree.size() == expected.size());
+
+    std::vector<T> forward(tree.begin(), tree.end());
+    REQUIRE(forward == std::vector<T>(expected.begin(), expected.end()));
+
+    std::vector<T> backward;
+    for (auto it = tree.end(); it != tree.begin();)
+        backward.push_back(*--it);
+    REQUIRE(backward == std::vector<T>(expected.rbegin(), expected.rend()));
+
+    std::vector<T> visited;
+    tree.inorder([&visited](const T &value)
+                 { visited.push_back(value); });
+    REQUIRE(visited == forward);
+}
+
+TEST_CASE("CONSTRUCTOR", "[DEFAULT]")
+{
+    ThreadedBST<int> tree;
+
+    REQUIRE(tree.isEmpty());
+    REQUIRE(tree.begin() == tree.end());
+    REQUIRE_FALSE(tree.contains(1));
+}
+
+TEST_CASE("ABSTRACT OPERATIONS", "[INSERT][REMOVE][CONTAINS]")
+{
+    ThreadedBST<int> tree;
+    std::set<int> expected{50, 20, 70, 10, 30, 60, 80, 25, 35, 65};
+    for (int value : {50, 20, 70, 10, 30, 60, 80, 25, 35, 65})
+        tree.insert(value);
+
+    SECTION("INSERT")
+    {
+        requireOrder(tree, expected);
+        REQUIRE(tree.contains(25));
+        REQUIRE_FALSE(tree.contains(26));
+        REQUIRE_THROWS_AS(tree.insert(30), std::logic_error);
+    }
+
+    SECTION("NEXT AND PREV FROM ANY NODE")
+    {
+        auto it = tree.find(30);
+        REQUIRE(*++it == 35);
+        REQUIRE(*++it == 50);
+        REQUIRE(*--it == 35);
+        REQUIRE(*--it == 30);
+        REQUIRE(*--it == 25);
+
+        REQUIRE(++tree.find(80) == tree.end());
+        REQUIRE(tree.find(42) == tree.end());
+    }
+
+    SECTION("REMOVE LEAF, ONE CHILD, TWO CHILDREN AND THE ROOT")
+    {
+        for (int value : {25, 60, 20, 50})
+        {
+            tree.remove(value);
+            expected.erase(value);
+            requireOrder(tree, expected);
+        }
+        REQUIRE_THROWS_AS(tree.remove(25), std::logic_error);
+
+        for (int value : std::set<int>(expected))
+        {
+            tree.remove(value);
+            expected.erase(value);
+            requireOrder(tree, expected);
+        }
+        REQUIRE(tree.isEmpty());
+    }
+}
+
+TEST_CASE("MATCHES std::set", "[INSERT][REMOVE]")
+{
+    std::mt19937 rng(23);
+    ThreadedBST<int> tree;
+    std::set<int> expected;
+
+    for (int i = 0; i < 3000; i++)
+    {
+        int value = rng() % 500;
+        if (expected.count(value))
+        {
+            tree.remove(value);
+            expected.erase(value);
+        }
+        else
+        {
+            tree.insert(value);
+            expected.insert(value);
+        }
+
+        if (i % 100 == 0)
+            requireOrder(tree, expected);
+    }
+    requireOrder(tree, expected);
+}
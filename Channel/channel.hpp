@@ -0,0 +1,699 @@
+/**
+ * @file channel.hpp
+ * @author Ivan Penev
+ * @brief Bounded producer/consumer channel for C++20 coroutines
+ * @date 2026-10-18
+ *
+ * The channel stores its elements in a lock-free ring buffer, so the common
+ * case (there is room to send / there is something to receive) never blocks
+ * and never takes a lock. Only when a coroutine has to wait it is parked in a
+ * small waiter list and later resumed through a Scheduler.
+ *
+ *     ds::InlineScheduler sched;
+ *     ds::Channel<int> ch(sched, 64);
+ *
+ *     ds::spawn(sched, producer(ch)); // co_await ch.send(x);
+ *     ds::spawn(sched, consumer(ch)); // std::optional<int> x = co_await ch.recv();
+ *     sched.run();
+ */
+
+#ifndef CHANNEL_HPP_GUARD_
+#define CHANNEL_HPP_GUARD_
+
+#include <atomic>             // Ring buffer sequence counters
+#include <condition_variable> // ThreadPoolScheduler idle wait
+#include <coroutine>          // C++ 20
+#include <cstddef>
+#include <deque>     // Scheduler run queues
+#include <mutex>     // ThreadPoolScheduler run queue
+#include <optional>  // recv() result
+#include <stdexcept> // Exception handling
+#include <thread>    // ThreadPoolScheduler workers
+#include <utility>
+#include <vector>
+
+namespace ds
+{
+    /**
+     * @brief Bounded multi-producer multi-consumer lock-free queue
+     * (D. Vyukov's sequence-numbered ring buffer).
+     *
+     * @param ValueType The type of the elements in the queue
+     */
+    template <typename ValueType>
+    class RingBuffer
+    {
+    public:
+        /**
+         * @brief Constructs a ring buffer
+         *
+         * @param capacity - rounded up to the next power of two (at least 2,
+         * the sequence numbers cannot tell full from empty with a single slot)
+         * @throws std::invalid_argument when the capacity is 0
+         */
+        explicit RingBuffer(size_t capacity)
+        {
+            if (capacity == 0)
+            {
+                throw std::invalid_argument("RingBuffer: Invalid capacity!");
+            }
+
+            size_t rounded = 2;
+            while (rounded < capacity)
+                rounded <<= 1;
+
+            mask = rounded - 1;
+            cells = std::vector<Cell>(rounded);
+            for (size_t i = 0; i < rounded; i++)
+                cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+
+        RingBuffer(const RingBuffer &) = delete;
+        RingBuffer &operator=(const RingBuffer &) = delete;
+
+        /**
+         * @brief Appends an element if there is free space
+         * @note Time complexity: O(1), lock-free
+         * @return true if the element was stored, false if the buffer is full
+         */
+        bool try_push(const ValueType &value)
+        {
+            size_t pos = tail.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                Cell &cell = cells[pos & mask];
+                size_t seq = cell.sequence.load(std::memory_order_acquire);
+                std::ptrdiff_t diff = (std::ptrdiff_t)seq - (std::ptrdiff_t)pos;
+
+                if (diff == 0)
+                {
+                    if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    {
+                        cell.value = value;
+                        cell.sequence.store(pos + 1, std::memory_order_release);
+                        return true;
+                    }
+                }
+                else if (diff < 0)
+                {
+                    return false; // Full
+                }
+                else
+                {
+                    pos = tail.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        /**
+         * @brief Removes the oldest element if there is one
+         * @note Time complexity: O(1), lock-free
+         * @return true if an element was moved into out, false if the buffer is empty
+         */
+        bool try_pop(ValueType &out)
+        {
+            size_t pos = head.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                Cell &cell = cells[pos & mask];
+                size_t seq = cell.sequence.load(std::memory_order_acquire);
+                std::ptrdiff_t diff = (std::ptrdiff_t)seq - (std::ptrdiff_t)(pos + 1);
+
+                if (diff == 0)
+                {
+                    if (head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    {
+                        out = std::move(cell.value);
+                        cell.sequence.store(pos + mask + 1, std::memory_order_release);
+                        return true;
+                    }
+                }
+                else if (diff < 0)
+                {
+                    return false; // Empty
+                }
+                else
+                {
+                    pos = head.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        /**
+         * @brief Returns the number of slots in the buffer
+         */
+        size_t capacity() const { return mask + 1; }
+
+    private:
+        struct Cell
+        {
+            std::atomic<size_t> sequence;
+            ValueType value;
+        };
+
+        std::vector<Cell> cells;
+        size_t mask;
+
+        // Producers and consumers touch different cache lines
+        alignas(64) std::atomic<size_t> head{0};
+        alignas(64) std::atomic<size_t> tail{0};
+    };
+
+    /**
+     * @brief Something that can resume suspended coroutines
+     */
+    class Scheduler
+    {
+    public:
+        virtual ~Scheduler() = default;
+
+        /**
+         * @brief Queues a coroutine to be resumed later. Must be thread-safe.
+         */
+        virtual void schedule(std::coroutine_handle<> handle) = 0;
+    };
+
+    /**
+     * @brief Single-threaded scheduler. Every coroutine runs on the thread
+     * that calls run().
+     */
+    class InlineScheduler : public Scheduler
+    {
+    public:
+        void schedule(std::coroutine_handle<> handle) override
+        {
+            std::lock_guard<std::mutex> lock(queueLock);
+            queue.push_back(handle);
+        }
+
+        /**
+         * @brief Resumes queued coroutines until there is nothing left to run
+         */
+        void run()
+        {
+            std::coroutine_handle<> next;
+            while (pop(next))
+                next.resume();
+        }
+
+    private:
+        bool pop(std::coroutine_handle<> &out)
+        {
+            std::lock_guard<std::mutex> lock(queueLock);
+            if (queue.empty())
+                return false;
+
+            out = queue.front();
+            queue.pop_front();
+            return true;
+        }
+
+        // Only needed when other threads wake coroutines owned by this scheduler
+        std::mutex queueLock;
+        std::deque<std::coroutine_handle<>> queue;
+    };
+
+    /**
+     * @brief Multiplexes coroutines over a fixed number of worker threads
+     */
+    class ThreadPoolScheduler : public Scheduler
+    {
+    public:
+        /**
+         * @param threads - number of worker threads
+         * @throws std::invalid_argument when threads is 0
+         */
+        explicit ThreadPoolScheduler(size_t threads)
+        {
+            if (threads == 0)
+            {
+                throw std::invalid_argument("ThreadPoolScheduler: Invalid thread count!");
+            }
+
+            for (size_t i = 0; i < threads; i++)
+                workers.emplace_back([this]
+                                     { work(); });
+        }
+
+        ThreadPoolScheduler(const ThreadPoolScheduler &) = delete;
+        ThreadPoolScheduler &operator=(const ThreadPoolScheduler &) = delete;
+
+        /**
+         * @brief Finishes the queued work and joins the workers
+         */
+        ~ThreadPoolScheduler()
+        {
+            {
+                std::lock_guard<std::mutex> lock(queueLock);
+                stopping = true;
+            }
+            wakeUp.notify_all();
+
+            for (std::thread &worker : workers)
+                worker.join();
+        }
+
+        void schedule(std::coroutine_handle<> handle) override
+        {
+            {
+                std::lock_guard<std::mutex> lock(queueLock);
+                queue.push_back(handle);
+            }
+            wakeUp.notify_one();
+        }
+
+    private:
+        void work()
+        {
+            for (;;)
+            {
+                std::coroutine_handle<> next;
+                {
+                    std::unique_lock<std::mutex> lock(queueLock);
+                    wakeUp.wait(lock, [this]
+                                { return stopping || !queue.empty(); });
+
+                    if (queue.empty())
+                        return; // stopping
+
+                    next = queue.front();
+                    queue.pop_front();
+                }
+                next.resume();
+            }
+        }
+
+        std::mutex queueLock;
+        std::condition_variable wakeUp;
+        std::deque<std::coroutine_handle<>> queue;
+        bool stopping = false;
+        std::vector<std::thread> workers;
+    };
+
+    /**
+     * @brief Fire-and-forget coroutine. It is started by spawn() and destroys
+     * itself when it finishes.
+     */
+    class Task
+    {
+    public:
+        struct promise_type
+        {
+            Task get_return_object()
+            {
+                return Task(std::coroutine_handle<promise_type>::from_promise(*this));
+            }
+
+            std::suspend_always initial_suspend() noexcept { return {}; }
+            std::suspend_never final_suspend() noexcept { return {}; }
+            void return_void() {}
+            void unhandled_exception() { std::terminate(); }
+        };
+
+        Task(Task &&other) noexcept : handle(std::exchange(other.handle, nullptr)) {}
+        Task(const Task &) = delete;
+        Task &operator=(const Task &) = delete;
+
+        ~Task()
+        {
+            // Never spawned
+            if (handle)
+                handle.destroy();
+        }
+
+    private:
+        explicit Task(std::coroutine_handle<promise_type> handle) : handle(handle) {}
+
+        friend void spawn(Scheduler &scheduler, Task task);
+
+        std::coroutine_handle<promise_type> handle;
+    };
+
+    /**
+     * @brief Hands a task to the scheduler which will start it
+     */
+    inline void spawn(Scheduler &scheduler, Task task)
+    {
+        scheduler.schedule(std::exchange(task.handle, nullptr));
+    }
+
+    /**
+     * @brief Bounded channel between coroutines
+     *
+     * @param ValueType The type of the elements in the channel
+     */
+    template <typename ValueType>
+    class Channel
+    {
+    private:
+        // A coroutine parked in send() or recv()
+        struct Waiter
+        {
+            std::coroutine_handle<> handle;
+            ValueType value{};  // value to send / received value
+            bool done = false;  // the operation completed on the waiter's behalf
+            Waiter *next = nullptr;
+        };
+
+        // Intrusive FIFO of waiters, guarded by the channel spinlock
+        struct WaitList
+        {
+            Waiter *first = nullptr;
+            Waiter *last = nullptr;
+
+            void push(Waiter *w)
+            {
+                w->next = nullptr;
+                if (last)
+                    last->next = w;
+                else
+                    first = w;
+                last = w;
+            }
+
+            Waiter *pop()
+            {
+                Waiter *w = first;
+                if (w)
+                {
+                    first = w->next;
+                    if (!first)
+                        last = nullptr;
+                }
+                return w;
+            }
+
+            void pushFront(Waiter *w)
+            {
+                w->next = first;
+                first = w;
+                if (!last)
+                    last = w;
+            }
+        };
+
+    public:
+        /**
+         * @brief Constructs a new Channel
+         *
+         * @param scheduler - resumes coroutines woken up by the channel
+         * @param capacity - maximum number of buffered elements (rounded up to a power of two, at least 2)
+         */
+        Channel(Scheduler &scheduler, size_t capacity)
+            : scheduler(scheduler), buffer(capacity) {}
+
+        Channel(const Channel &) = delete;
+        Channel &operator=(const Channel &) = delete;
+
+        /**
+         * @brief Non-suspending send
+         * @note Time complexity: O(1)
+         * @return true if the element was buffered
+         */
+        bool try_send(const ValueType &value)
+        {
+            if (closed.load(std::memory_order_acquire) || !buffer.try_push(value))
+                return false;
+
+            notify(receivers);
+            return true;
+        }
+
+        /**
+         * @brief Non-suspending receive
+         * @note Time complexity: O(1)
+         * @return The oldest element or std::nullopt if nothing is buffered
+         */
+        std::optional<ValueType> try_recv()
+        {
+            ValueType value;
+            if (!buffer.try_pop(value))
+                return std::nullopt;
+
+            notify(senders);
+            return value;
+        }
+
+        /**
+         * @brief Sends as many elements of [first, last) as fit without suspending
+         * @note Waiting receivers are woken once for the whole batch
+         * @return Iterator to the first element which was not sent
+         */
+        template <typename Iterator>
+        Iterator try_send_batch(Iterator first, Iterator last)
+        {
+            size_t sent = 0;
+            while (first != last && !closed.load(std::memory_order_acquire) && buffer.try_push(*first))
+            {
+                ++first;
+                ++sent;
+            }
+
+            for (; sent > 0 && waiting.load(std::memory_order_relaxed) > 0; sent--)
+                notify(receivers);
+
+            return first;
+        }
+
+        /**
+         * @brief Receives up to maxCount buffered elements without suspending
+         * @return Output iterator past the last written element
+         */
+        template <typename OutputIterator>
+        OutputIterator try_recv_batch(OutputIterator out, size_t maxCount)
+        {
+            size_t received = 0;
+            ValueType value;
+            while (received < maxCount && buffer.try_pop(value))
+            {
+                *out++ = std::move(value);
+                ++received;
+            }
+
+            for (; received > 0 && waiting.load(std::memory_order_relaxed) > 0; received--)
+                notify(senders);
+
+            return out;
+        }
+
+        /**
+         * @brief Closes the channel. Pending and future sends fail, receivers
+         * drain the buffered elements and then get std::nullopt.
+         */
+        void close()
+        {
+            closed.store(true, std::memory_order_seq_cst);
+
+            std::vector<Waiter *> wake;
+            lock();
+            while (Waiter *w = senders.pop())
+                wake.push_back(w);
+            while (Waiter *w = receivers.pop())
+            {
+                w->done = buffer.try_pop(w->value);
+                wake.push_back(w);
+            }
+            waiting.store(0, std::memory_order_relaxed);
+            unlock();
+
+            for (Waiter *w : wake)
+                scheduler.schedule(w->handle);
+        }
+
+        /**
+         * @brief Checks whether close() was called
+         */
+        bool isClosed() const { return closed.load(std::memory_order_acquire); }
+
+        /**
+         * @brief Returns the maximum number of buffered elements
+         */
+        size_t capacity() const { return buffer.capacity(); }
+
+        /**
+         * @brief Awaitable returned by send()
+         */
+        class SendAwaiter
+        {
+        public:
+            bool await_ready()
+            {
+                if (ch.closed.load(std::memory_order_acquire))
+                    return true;
+
+                waiter.done = ch.try_send(waiter.value);
+                return waiter.done;
+            }
+
+            bool await_suspend(std::coroutine_handle<> handle)
+            {
+                waiter.handle = handle;
+                return ch.park(ch.senders, &waiter, [this]
+                               { return ch.buffer.try_push(waiter.value); });
+            }
+
+            /**
+             * @return true if the element was sent, false if the channel is closed
+             */
+            bool await_resume() const { return waiter.done; }
+
+        private:
+            friend Channel;
+            SendAwaiter(Channel &ch, const ValueType &value) : ch(ch) { waiter.value = value; }
+
+            Channel &ch;
+            Waiter waiter;
+        };
+
+        /**
+         * @brief Awaitable returned by recv()
+         */
+        class RecvAwaiter
+        {
+        public:
+            bool await_ready()
+            {
+                waiter.done = ch.buffer.try_pop(waiter.value);
+                if (waiter.done)
+                    ch.notify(ch.senders);
+
+                return waiter.done || ch.closed.load(std::memory_order_acquire);
+            }
+
+            bool await_suspend(std::coroutine_handle<> handle)
+            {
+                waiter.handle = handle;
+                return ch.park(ch.receivers, &waiter, [this]
+                               { return ch.buffer.try_pop(waiter.value); });
+            }
+
+            /**
+             * @return The received element or std::nullopt if the channel is closed and drained
+             */
+            std::optional<ValueType> await_resume()
+            {
+                if (!waiter.done)
+                    return std::nullopt;
+
+                return std::move(waiter.value);
+            }
+
+        private:
+            friend Channel;
+            explicit RecvAwaiter(Channel &ch) : ch(ch) {}
+
+            Channel &ch;
+            Waiter waiter;
+        };
+
+        /**
+         * @brief co_await ch.send(x) - suspends while the channel is full
+         */
+        SendAwaiter send(const ValueType &value) { return SendAwaiter(*this, value); }
+
+        /**
+         * @brief co_await ch.recv() - suspends while the channel is empty
+         */
+        RecvAwaiter recv() { return RecvAwaiter(*this); }
+
+        /* Helpers */
+    private:
+        void lock()
+        {
+            while (spin.test_and_set(std::memory_order_acquire))
+                std::this_thread::yield();
+        }
+
+        void unlock() { spin.clear(std::memory_order_release); }
+
+        /**
+         * @brief Parks the waiter unless the operation succeeds on a last retry
+         *
+         * The waiter count is published before the retry, and notify() reads it
+         * after its own buffer operation, so one of the two always sees the other.
+         *
+         * @return false if the coroutine must not suspend
+         */
+        template <typename Operation>
+        bool park(WaitList &list, Waiter *w, Operation retry)
+        {
+            const bool sending = &list == &senders;
+
+            lock();
+            waiting.fetch_add(1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            // Receivers still drain a closed channel, senders give up at once
+            bool closedNow = closed.load(std::memory_order_relaxed);
+            bool ok = (sending && closedNow) ? false : retry();
+
+            if (ok || closedNow)
+            {
+                waiting.fetch_sub(1, std::memory_order_relaxed);
+                unlock();
+
+                w->done = ok;
+                if (ok)
+                    notify(sending ? receivers : senders);
+                return false;
+            }
+
+            list.push(w);
+            unlock();
+            return true;
+        }
+
+        /**
+         * @brief Completes the operation of the first waiter in the list on its
+         * behalf and schedules it. Each completed operation changes the buffer,
+         * so the opposite list is served next.
+         */
+        void notify(WaitList &first)
+        {
+            WaitList *list = &first;
+            while (list)
+            {
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if (waiting.load(std::memory_order_relaxed) == 0)
+                    return;
+
+                const bool sending = list == &senders;
+
+                lock();
+                Waiter *w = list->pop();
+                if (w)
+                {
+                    w->done = sending ? buffer.try_push(w->value)
+                                      : buffer.try_pop(w->value);
+                    if (w->done)
+                    {
+                        waiting.fetch_sub(1, std::memory_order_relaxed);
+                    }
+                    else
+                    {
+                        // Somebody on the fast path was quicker - keep waiting
+                        list->pushFront(w);
+                        w = nullptr;
+                    }
+                }
+                unlock();
+
+                if (!w)
+                    return;
+
+                scheduler.schedule(w->handle);
+                list = sending ? &receivers : &senders;
+            }
+        }
+
+        Scheduler &scheduler;
+        RingBuffer<ValueType> buffer;
+
+        std::atomic_flag spin = ATOMIC_FLAG_INIT;
+        std::atomic<size_t> waiting{0};
+        std::atomic<bool> closed{false};
+        WaitList senders, receivers;
+    };
+} // namespace ds
+
+#endif // CHANNEL_HPP_GUARD_
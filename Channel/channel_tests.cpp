@@ -0,0 +1,158 @@
+#define CATCH_CONFIG_MAIN
+#include "../Catch2/catch.hpp"
+#include "channel.hpp"
+
+#include <atomic>
+#include <vector>
+
+using namespace ds;
+
+Task produce(Channel<int> &ch, int from, int to, bool closeAtEnd)
+{
+    for (int i = from; i < to; i++)
+        co_await ch.send(i);
+
+    if (closeAtEnd)
+        ch.close();
+}
+
+Task consume(Channel<int> &ch, std::vector<int> &out)
+{
+    while (std::optional<int> value = co_await ch.recv())
+        out.push_back(*value);
+}
+
+Task consumeSum(Channel<int> &ch, std::atomic<long long> &sum, std::atomic<int> &finished)
+{
+    while (std::optional<int> value = co_await ch.recv())
+        sum += *value;
+
+    ++finished;
+}
+
+TEST_CASE("RING BUFFER", "[PUSH][POP]")
+{
+    SECTION("CAPACITY")
+    {
+        RingBuffer<int> rb(5);
+
+        REQUIRE(rb.capacity() == 8);
+        REQUIRE(RingBuffer<int>(1).capacity() == 2);
+        REQUIRE_THROWS(RingBuffer<int>(0));
+    }
+
+    SECTION("FIFO")
+    {
+        RingBuffer<int> rb(4);
+        int value;
+
+        for (int i = 0; i < 4; i++)
+            REQUIRE(rb.try_push(i));
+        REQUIRE_FALSE(rb.try_push(4));
+
+        for (int i = 0; i < 4; i++)
+        {
+            REQUIRE(rb.try_pop(value));
+            REQUIRE(value == i);
+        }
+        REQUIRE_FALSE(rb.try_pop(value));
+    }
+}
+
+TEST_CASE("NON-SUSPENDING OPERATIONS", "[TRY_SEND][TRY_RECV][BATCH]")
+{
+    InlineScheduler sched;
+    Channel<int> ch(sched, 4);
+
+    SECTION("TRY SEND / TRY RECV")
+    {
+        REQUIRE(ch.try_send(1));
+        REQUIRE(ch.try_send(2));
+        REQUIRE(ch.try_recv() == 1);
+        REQUIRE(ch.try_recv() == 2);
+        REQUIRE_FALSE(ch.try_recv().has_value());
+    }
+
+    SECTION("BATCH")
+    {
+        std::vector<int> in{1, 2, 3, 4, 5, 6};
+        std::vector<int> out;
+
+        auto rest = ch.try_send_batch(in.begin(), in.end());
+        REQUIRE(rest - in.begin() == 4);
+
+        ch.try_recv_batch(std::back_inserter(out), 10);
+        REQUIRE(out == std::vector<int>{1, 2, 3, 4});
+    }
+
+    SECTION("CLOSE")
+    {
+        ch.try_send(1);
+        ch.close();
+
+        REQUIRE(ch.isClosed());
+        REQUIRE_FALSE(ch.try_send(2));
+        REQUIRE(ch.try_recv() == 1);
+    }
+}
+
+TEST_CASE("COROUTINES", "[SEND][RECV][SCHEDULER]")
+{
+    SECTION("SINGLE THREADED")
+    {
+        const int N = 1000;
+        InlineScheduler sched;
+        Channel<int> ch(sched, 8); // Much smaller than N - both sides suspend
+        std::vector<int> out;
+
+        spawn(sched, consume(ch, out));
+        spawn(sched, produce(ch, 0, N, true));
+        sched.run();
+
+        REQUIRE(out.size() == N);
+        for (int i = 0; i < N; i++)
+            REQUIRE(out[i] == i);
+    }
+
+    SECTION("MANY STAGES")
+    {
+        const int STAGES = 1000;
+        InlineScheduler sched;
+        Channel<int> ch(sched, 1);
+        std::vector<int> out;
+
+        for (int i = 0; i < STAGES; i++)
+            spawn(sched, produce(ch, i, i + 1, false));
+        spawn(sched, consume(ch, out));
+        sched.run();
+
+        REQUIRE(out.size() == STAGES);
+    }
+
+    SECTION("THREAD POOL")
+    {
+        const int PRODUCERS = 8, CONSUMERS = 4, N = 20000;
+        std::atomic<long long> sum{0};
+        std::atomic<int> finished{0};
+        {
+            ThreadPoolScheduler sched(4);
+            Channel<int> ch(sched, 16);
+
+            for (int i = 0; i < CONSUMERS; i++)
+                spawn(sched, consumeSum(ch, sum, finished));
+            for (int i = 0; i < PRODUCERS; i++)
+                spawn(sched, produce(ch, i * N, (i + 1) * N, false));
+
+            // Wait until everything is received, then release the consumers
+            const long long TOTAL = (long long)PRODUCERS * N * (PRODUCERS * N - 1) / 2;
+            while (sum.load() != TOTAL)
+                std::this_thread::yield();
+
+            ch.close();
+            while (finished.load() != CONSUMERS)
+                std::this_thread::yield();
+        }
+
+        REQUIRE(finished == CONSUMERS);
+    }
+}
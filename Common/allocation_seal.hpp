@@ -0,0 +1,258 @@
+/**
+ * @file allocation_seal.hpp
+ * @author Ivan Penev
+ * @brief Sealed (allocation-free) steady state for the containers
+ * @date 2026-10-18
+ *
+ * A latency-critical thread sizes its containers during warm-up and must not
+ * allocate afterwards. dynamic_array, List, Stack, BinaryHeap and BST support
+ * this with three calls:
+ *
+ *  - reserve(n) - dynamic_array and BinaryHeap grow their buffer to n
+ *    elements; the node containers fill a pool of spare nodes, so together
+ *    with the live nodes n elements are backed. Erased nodes return to the
+ *    pool while it is below n, pushes and inserts take nodes from it;
+ *  - seal() - from now on every allocation the container makes is reported
+ *    to the seal hook before it happens;
+ *  - unseal() - back to normal.
+ *
+ * The hook is global and chosen with setSealHook: seal_hooks::abort (the
+ * default - a violation is a bug), seal_hooks::log (print and go on) or
+ * seal_hooks::count (go on silently). Every violation is counted either way,
+ * see sealViolations(). Copies and assignments are not steady-state
+ * operations and are not checked; auto-compaction of a sealed List is off.
+ */
+
+#ifndef ALLOCATION_SEAL_HPP_GUARD_
+#define ALLOCATION_SEAL_HPP_GUARD_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdio>  // fprintf
+#include <cstdlib> // abort
+#include <new>
+#include <utility> // std::forward, std::swap
+
+#include "expected.hpp" // DS_TRY
+
+namespace ds
+{
+    /**
+     * @brief Called before a sealed container allocates
+     *
+     * @param container - the name of the container, e.g. "List"
+     * @param bytes - the size of the allocation
+     */
+    typedef void (*SealHook)(const char *container, size_t bytes);
+
+    namespace seal_hooks
+    {
+        inline void abort(const char *container, size_t bytes)
+        {
+            std::fprintf(stderr, "%s: allocation of %zu bytes while sealed!\n", container, bytes);
+            std::abort();
+        }
+
+        inline void log(const char *container, size_t bytes)
+        {
+            std::fprintf(stderr, "%s: allocation of %zu bytes while sealed\n", container, bytes);
+        }
+
+        inline void count(const char *, size_t) {}
+    } // namespace seal_hooks
+
+    namespace detail
+    {
+        inline std::atomic<SealHook> &sealHook()
+        {
+            static std::atomic<SealHook> hook(seal_hooks::abort);
+            return hook;
+        }
+
+        inline std::atomic<size_t> &sealViolationCounter()
+        {
+            static std::atomic<size_t> counter(0);
+            return counter;
+        }
+
+        // Kept out of line and cold: it is never called in a correct steady state
+        __attribute__((noinline, cold)) inline void sealedAllocation(const char *container, size_t bytes)
+        {
+            sealViolationCounter().fetch_add(1, std::memory_order_relaxed);
+            sealHook().load(std::memory_order_relaxed)(container, bytes);
+        }
+    } // namespace detail
+
+    /**
+     * @brief Sets the hook for every sealed container
+     * @return SealHook - the previous hook
+     */
+    inline SealHook setSealHook(SealHook hook)
+    {
+        return detail::sealHook().exchange(hook);
+    }
+
+    /**
+     * @brief Returns the number of allocations made by sealed containers
+     */
+    inline size_t sealViolations()
+    {
+        return detail::sealViolationCounter().load(std::memory_order_relaxed);
+    }
+
+    inline void resetSealViolations()
+    {
+        detail::sealViolationCounter().store(0, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Free list of node storage for the node containers
+     *
+     * Keeps freed nodes as spares while the nodes handed out plus the spares
+     * are fewer than the reserved capacity, and reports the allocations of a
+     * sealed pool. Node has to be at least as large as a pointer.
+     */
+    template <typename Node>
+    class NodePool
+    {
+    private:
+        struct Slot
+        {
+            Slot *next;
+        };
+
+        Slot *spare = nullptr;
+        size_t spares = 0;
+        size_t outstanding = 0; // nodes handed out and not returned
+        size_t capacity = 0;
+        bool sealed = false;
+        const char *owner;
+
+    public:
+        explicit NodePool(const char *owner) : owner(owner) {}
+
+        NodePool(const NodePool &) = delete;
+        NodePool &operator=(const NodePool &) = delete;
+
+        ~NodePool() { trim(0); }
+
+        /**
+         * @brief Constructs a node in spare storage, or in new storage
+         * @note Time complexity: O(1)
+         */
+        template <typename... Args>
+        Node *create(Args &&...args)
+        {
+            void *slot = allocate();
+            DS_TRY
+            {
+                return new (slot) Node(std::forward<Args>(args)...);
+            }
+            DS_CATCH_ALL
+            {
+                deallocate(slot);
+                DS_RETHROW;
+            }
+        }
+
+        /**
+         * @brief Destroys a node made by create() and keeps or frees its storage
+         * @note Time complexity: O(1)
+         */
+        void destroy(Node *node)
+        {
+            node->~Node();
+            deallocate(node);
+        }
+
+        /**
+         * @brief Makes sure that count nodes can be handed out without
+         * allocating; further spares are kept up to count
+         * @note Time complexity: O(count)
+         */
+        void reserve(size_t count)
+        {
+            capacity = count;
+            while (outstanding + spares < capacity)
+            {
+                if (sealed)
+                    detail::sealedAllocation(owner, sizeof(Node));
+                push(::operator new(sizeof(Node)));
+            }
+            trim(capacity > outstanding ? capacity - outstanding : 0);
+        }
+
+        void seal() { sealed = true; }
+
+        void unseal() { sealed = false; }
+
+        bool isSealed() const { return sealed; }
+
+        size_t spareCount() const { return spares; }
+
+        // The seal stays with the pool, it is not swapped
+        void swap(NodePool &other)
+        {
+            using std::swap;
+            swap(spare, other.spare);
+            swap(spares, other.spares);
+            swap(outstanding, other.outstanding);
+            swap(capacity, other.capacity);
+        }
+
+    private:
+        void *allocate()
+        {
+            ++outstanding;
+            if (spare)
+            {
+                Slot *slot = spare;
+                spare = slot->next;
+                --spares;
+                return slot;
+            }
+
+            if (sealed)
+                detail::sealedAllocation(owner, sizeof(Node));
+
+            DS_TRY
+            {
+                return ::operator new(sizeof(Node));
+            }
+            DS_CATCH_ALL
+            {
+                --outstanding;
+                DS_RETHROW;
+            }
+        }
+
+        void deallocate(void *storage)
+        {
+            --outstanding;
+            if (outstanding + spares < capacity)
+                push(storage);
+            else
+                ::operator delete(storage);
+        }
+
+        void push(void *storage)
+        {
+            spare = new (storage) Slot{spare};
+            ++spares;
+        }
+
+        // Frees spares until at most count are left
+        void trim(size_t count)
+        {
+            while (spares > count)
+            {
+                Slot *slot = spare;
+                spare = slot->next;
+                --spares;
+                ::operator delete(slot);
+            }
+        }
+    };
+} // namespace ds
+
+#endif // ALLOCATION_SEAL_HPP_GUARD_
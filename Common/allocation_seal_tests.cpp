@@ -0,0 +1,309 @@
+#define CATCH_CONFIG_MAIN
+#include "../Catch2/catch.hpp"
+#include "allocation_seal.hpp"
+
+#include "../BinarySerachTree/BST.hpp"
+#include "../DoublyLinkedList/list.hpp"
+#include "../DynamicArray/dynamic_array.hpp"
+#include "../Heap/binary_heap.hpp"
+#include "../Stacks/StackLinked/stack_linked.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <random>
+
+using namespace ds;
+
+// Every allocation of the program is counted, so a workload proves that it
+// is allocation-free independently of the seal
+static size_t allocations = 0;
+
+// The replacements go through these; free() is kept out of line, so the
+// compiler does not pair it with the inlined operator new and warn
+// (-Wmismatched-new-delete)
+static void *allocate(size_t size)
+{
+    ++allocations;
+    return std::malloc(size ? size : 1);
+}
+
+__attribute__((noinline)) static void deallocate(void *ptr)
+{
+    std::free(ptr);
+}
+
+void *operator new(size_t size)
+{
+    void *ptr = allocate(size);
+    if (!ptr)
+        std::abort(); // out of memory in a test
+    return ptr;
+}
+
+void *operator new[](size_t size) { return operator new(size); }
+
+void *operator new(size_t size, const std::nothrow_t &) noexcept { return allocate(size); }
+
+void operator delete(void *ptr) noexcept { deallocate(ptr); }
+
+void operator delete[](void *ptr) noexcept { deallocate(ptr); }
+
+void operator delete(void *ptr, size_t) noexcept { deallocate(ptr); }
+
+void operator delete[](void *ptr, size_t) noexcept { deallocate(ptr); }
+
+static const char *lastContainer = nullptr;
+
+static void remember(const char *container, size_t)
+{
+    lastContainer = container;
+}
+
+TEST_CASE("STEADY STATE", "[SEAL]")
+{
+    const int OPS = 100000;
+    std::mt19937 rng(7);
+    resetSealViolations();
+
+    SECTION("DYNAMIC ARRAY")
+    {
+        dynamic_array<int> arr;
+        arr.reserve(1024);
+        arr.seal();
+
+        size_t before = allocations;
+        for (int i = 0; i < OPS; i++)
+        {
+            if (arr.size() < 1000 && (arr.empty() || rng() % 3))
+                arr.push_back(i);
+            else if (rng() % 2)
+                arr.pop_back();
+            else
+                arr.erase(rng() % arr.size());
+
+            if (arr.size() > 1 && arr.size() < 1000 && i % 16 == 0)
+                arr.insert(rng() % arr.size(), i);
+        }
+
+        REQUIRE(allocations == before);
+        REQUIRE(sealViolations() == 0);
+        REQUIRE(arr.isSealed());
+    }
+
+    SECTION("LIST")
+    {
+        List<int> list;
+        list.reserve(1000);
+        for (int i = 0; i < 500; i++)
+            list.push_back(i);
+        list.seal();
+
+        size_t before = allocations;
+        for (int i = 0; i < OPS; i++)
+        {
+            switch (rng() % 4)
+            {
+            case 0:
+                if (list.size() < 1000)
+                    list.push_back(i);
+                break;
+            case 1:
+                if (list.size() < 1000)
+                    list.insert(++list.begin(), i);
+                break;
+            case 2:
+                list.pop_front();
+                break;
+            default:
+                list.pop_back();
+            }
+
+            if (list.empty())
+                list.push_front(i);
+        }
+
+        // The prefetching walks keep their cursors on the stack
+        size_t visits = 0;
+        list.for_each([&visits](int)
+                      { ++visits; },
+                      1000);
+        const List<int> *lists[] = {&list, &list, &list};
+        List<int>::for_each(lists, 3, [&visits](size_t, int)
+                            { ++visits; });
+        REQUIRE(visits == 4 * list.size());
+        REQUIRE(allocations == before);
+        REQUIRE(sealViolations() == 0);
+    }
+
+    SECTION("LIST AFTER COMPACTION")
+    {
+        // The compacted block is allocated before the seal; the erased block
+        // nodes are replaced by spares
+        List<int> list;
+        for (int i = 0; i < 500; i++)
+            list.push_back(i);
+        list.compact();
+        list.reserve(1000);
+        list.seal();
+
+        size_t before = allocations;
+        for (int i = 0; i < OPS; i++)
+        {
+            list.pop_front();
+            list.push_back(i);
+        }
+
+        REQUIRE(allocations == before);
+        REQUIRE(sealViolations() == 0);
+        REQUIRE(list.size() == 500);
+    }
+
+    SECTION("STACK")
+    {
+        Stack<int> stk;
+        stk.reserve(256);
+        stk.seal();
+
+        size_t before = allocations;
+        for (int i = 0; i < OPS; i++)
+        {
+            if (stk.size() < 256 && (stk.empty() || rng() % 2))
+                stk.push(i);
+            else
+                stk.pop();
+        }
+
+        REQUIRE(allocations == before);
+        REQUIRE(sealViolations() == 0);
+    }
+
+    SECTION("BINARY HEAP")
+    {
+        BinaryHeap<int> heap(BinaryHeap<int>::less);
+        heap.reserve(1024);
+        heap.seal();
+
+        size_t before = allocations;
+        for (int i = 0; i < OPS; i++)
+        {
+            if (heap.size() < 1024 && (heap.isEmpty() || rng() % 2))
+                heap.push(rng() % 10000);
+            else
+                heap.pop();
+        }
+
+        REQUIRE(allocations == before);
+        REQUIRE(sealViolations() == 0);
+    }
+
+    SECTION("BST")
+    {
+        const int KEYS = 2000;
+        BST<int> tree;
+        tree.reserve(KEYS);
+        tree.seal();
+
+        size_t before = allocations;
+        for (int i = 0; i < OPS; i++)
+        {
+            int key = rng() % KEYS;
+            if (tree.contains(key))
+                tree.remove(key);
+            else
+                tree.insert(key);
+        }
+
+        // Batched lookups keep their walks on the stack
+        int keys[100];
+        bool found[100];
+        for (int &key : keys)
+            key = rng() % KEYS;
+        tree.containsBatch(keys, keys + 100, found);
+
+        REQUIRE(allocations == before);
+        REQUIRE(sealViolations() == 0);
+    }
+}
+
+TEST_CASE("VIOLATIONS", "[SEAL]")
+{
+    SealHook previous = setSealHook(seal_hooks::count);
+    resetSealViolations();
+
+    SECTION("COUNTED")
+    {
+        dynamic_array<int> arr(2);
+        arr.seal();
+        for (int i = 0; i < 3; i++)
+            arr.push_back(i);
+
+        Stack<int> stk;
+        stk.seal();
+        stk.push(1);
+        stk.push(2);
+
+        // The allocations still happen - only the hook is told
+        REQUIRE(sealViolations() == 3);
+        REQUIRE(arr.size() == 3);
+        REQUIRE(stk.size() == 2);
+    }
+
+    SECTION("RESERVE LIMIT")
+    {
+        BST<int> tree;
+        tree.reserve(2);
+        tree.seal();
+        tree.insert(1);
+        tree.insert(2);
+        REQUIRE(sealViolations() == 0);
+
+        tree.insert(3);
+        REQUIRE(sealViolations() == 1);
+    }
+
+    SECTION("ASSIGNMENT KEEPS THE SEAL")
+    {
+        List<int> sealed, other = {1, 2, 3};
+        sealed.seal();
+
+        sealed = other; // copy and swap - the copy is not sealed
+        REQUIRE(sealed.isSealed());
+        REQUIRE_FALSE(other.isSealed());
+        sealed.push_back(4);
+        REQUIRE(sealViolations() == 1);
+
+        sealed.swap(other);
+        REQUIRE(sealed.isSealed());
+        REQUIRE_FALSE(other.isSealed());
+        sealed.push_back(5);
+        other.push_back(5);
+        REQUIRE(sealViolations() == 2);
+    }
+
+    SECTION("CUSTOM HOOK AND UNSEAL")
+    {
+        setSealHook(remember);
+
+        List<int> list;
+        list.seal();
+        list.push_back(1);
+        REQUIRE(lastContainer != nullptr);
+        REQUIRE(std::strcmp(lastContainer, "List") == 0);
+
+        BinaryHeap<int> heap(BinaryHeap<int>::less);
+        heap.seal();
+        heap.push(1);
+        REQUIRE(std::strcmp(lastContainer, "BinaryHeap") == 0);
+        REQUIRE(sealViolations() == 2);
+
+        heap.unseal();
+        list.unseal();
+        REQUIRE_FALSE(list.isSealed());
+        heap.push(2);
+        list.push_back(2);
+        REQUIRE(sealViolations() == 2);
+    }
+
+    setSealHook(previous);
+}
@@ -0,0 +1,35 @@
+/**
+ * @file catch_no_exceptions.hpp
+ * @author Ivan Penev
+ * @brief Lets the unit tests build with -fno-exceptions
+ * @date 2026-10-18
+ *
+ * Catch2 has no exception assertions without exceptions. Included after
+ * catch.hpp, this header turns them into what they can still check in the
+ * exception-free mode: a *_THROWS assertion is skipped (the call would abort),
+ * a *_NOTHROW assertion just runs its expression. With exceptions it does
+ * nothing. The try_* test cases cover the failures in both builds.
+ */
+
+#ifndef CATCH_NO_EXCEPTIONS_HPP_GUARD_
+#define CATCH_NO_EXCEPTIONS_HPP_GUARD_
+
+#include "expected.hpp" // DS_NO_EXCEPTIONS
+
+#ifdef DS_NO_EXCEPTIONS
+#undef REQUIRE_THROWS
+#undef REQUIRE_THROWS_AS
+#undef REQUIRE_NOTHROW
+#undef CHECK_THROWS
+#undef CHECK_THROWS_AS
+#undef CHECK_NOTHROW
+
+#define REQUIRE_THROWS(...) (void)0
+#define REQUIRE_THROWS_AS(expr, exceptionType) (void)0
+#define REQUIRE_NOTHROW(...) (void)(__VA_ARGS__)
+#define CHECK_THROWS(...) (void)0
+#define CHECK_THROWS_AS(expr, exceptionType) (void)0
+#define CHECK_NOTHROW(...) (void)(__VA_ARGS__)
+#endif
+
+#endif // CATCH_NO_EXCEPTIONS_HPP_GUARD_
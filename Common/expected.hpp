@@ -0,0 +1,250 @@
+/**
+ * @file expected.hpp
+ * @author Ivan Penev
+ * @brief Error codes and the exception-free operating mode
+ * @date 2026-10-18
+ *
+ * Every container reports a misuse (pop from an empty stack, index out of
+ * range...) in two ways:
+ *
+ *  - the classic functions throw, as they always did;
+ *  - the try_* functions return an Expected<T> - a value or an Errc - and
+ *    never throw, so a hot path pays one predictable branch and no unwind
+ *    tables.
+ *
+ * The library also builds with -fno-exceptions. DS_NO_EXCEPTIONS is then
+ * defined (it can also be defined by hand) and the throwing functions print
+ * the message and abort instead - code built that way uses the try_* API.
+ *
+ *     ds::Expected<int &> top = stack.try_top();
+ *     if (!top)
+ *         return top.error(); // ds::Errc::empty
+ *     *top += 1;
+ */
+
+#ifndef EXPECTED_HPP_GUARD_
+#define EXPECTED_HPP_GUARD_
+
+#include <cstdio>  // fprintf
+#include <cstdlib> // abort
+#include <new>     // placement new
+#include <utility> // std::move
+
+#if !defined(DS_NO_EXCEPTIONS) && !defined(__cpp_exceptions) && !defined(__EXCEPTIONS)
+#define DS_NO_EXCEPTIONS
+#endif
+
+#ifdef DS_NO_EXCEPTIONS
+#define DS_THROW(Exception, message) ::ds::detail::fail(#Exception, message)
+#define DS_TRY if (true)
+#define DS_CATCH_ALL else
+#define DS_RETHROW
+#else
+#include <stdexcept>
+#define DS_THROW(Exception, message) throw Exception(message)
+#define DS_TRY try
+#define DS_CATCH_ALL catch (...)
+#define DS_RETHROW throw
+#endif
+
+namespace ds
+{
+    /**
+     * @brief Why a try_* operation did nothing
+     */
+    enum class Errc
+    {
+        ok = 0,
+        empty,            // pop or access on an empty container
+        full,             // push on a container with fixed capacity
+        out_of_range,     // index past the last element
+        invalid_argument, // e.g. an insert position past the end
+        duplicate,        // the key is already in the container
+    };
+
+    inline const char *describe(Errc error)
+    {
+        switch (error)
+        {
+        case Errc::ok:
+            return "ok";
+        case Errc::empty:
+            return "the container is empty";
+        case Errc::full:
+            return "the container is full";
+        case Errc::out_of_range:
+            return "index out of range";
+        case Errc::invalid_argument:
+            return "invalid argument";
+        case Errc::duplicate:
+            return "duplicate key";
+        }
+        return "unknown error";
+    }
+
+    namespace detail
+    {
+        // DS_THROW without exceptions: the failure is a bug in the caller
+        [[noreturn]] inline void fail(const char *exception, const char *message)
+        {
+            std::fprintf(stderr, "%s: %s\n", exception, message);
+            std::abort();
+        }
+    } // namespace detail
+
+    /**
+     * @brief The error side of an Expected, so that an Errc converts to any
+     * Expected<T>: return Unexpected(Errc::empty);
+     */
+    struct Unexpected
+    {
+        explicit Unexpected(Errc error) : error(error) {}
+
+        Errc error;
+    };
+
+    /**
+     * @brief Either a value of T or the Errc which explains its absence
+     *
+     * value() on an error is a bug: it throws std::logic_error, or aborts
+     * in the exception-free mode. operator* does not check.
+     */
+    template <typename T>
+    class Expected
+    {
+    public:
+        Expected(const T &value) : err(Errc::ok) { new (&storage) T(value); }
+
+        Expected(T &&value) : err(Errc::ok) { new (&storage) T(std::move(value)); }
+
+        Expected(Unexpected error) : err(error.error) {}
+
+        Expected(const Expected &other) : err(other.err)
+        {
+            if (has_value())
+                new (&storage) T(*other);
+        }
+
+        Expected(Expected &&other) : err(other.err)
+        {
+            if (has_value())
+                new (&storage) T(std::move(*other));
+        }
+
+        Expected &operator=(Expected other)
+        {
+            reset();
+            err = other.err;
+            if (has_value())
+                new (&storage) T(std::move(*other));
+            return *this;
+        }
+
+        ~Expected() { reset(); }
+
+        bool has_value() const { return err == Errc::ok; }
+
+        explicit operator bool() const { return has_value(); }
+
+        Errc error() const { return err; }
+
+        T &operator*() { return storage; }
+
+        const T &operator*() const { return storage; }
+
+        T *operator->() { return &storage; }
+
+        const T *operator->() const { return &storage; }
+
+        T &value()
+        {
+            check();
+            return storage;
+        }
+
+        const T &value() const
+        {
+            check();
+            return storage;
+        }
+
+        T value_or(const T &fallback) const { return has_value() ? storage : fallback; }
+
+    private:
+        void reset()
+        {
+            if (has_value())
+                storage.~T();
+            err = Errc::empty;
+        }
+
+        void check() const
+        {
+            if (!has_value())
+                DS_THROW(std::logic_error, describe(err));
+        }
+
+        // A union member is neither constructed nor destroyed implicitly
+        union
+        {
+            T storage;
+        };
+        Errc err;
+    };
+
+    /**
+     * @brief A reference to an element of a container, or an Errc
+     */
+    template <typename T>
+    class Expected<T &>
+    {
+    public:
+        Expected(T &value) : ptr(&value), err(Errc::ok) {}
+
+        Expected(Unexpected error) : ptr(nullptr), err(error.error) {}
+
+        bool has_value() const { return err == Errc::ok; }
+
+        explicit operator bool() const { return has_value(); }
+
+        Errc error() const { return err; }
+
+        T &operator*() const { return *ptr; }
+
+        T *operator->() const { return ptr; }
+
+        T &value() const
+        {
+            if (!has_value())
+                DS_THROW(std::logic_error, describe(err));
+            return *ptr;
+        }
+
+    private:
+        T *ptr;
+        Errc err;
+    };
+
+    /**
+     * @brief Success, or the Errc of an operation which has no result
+     */
+    template <>
+    class Expected<void>
+    {
+    public:
+        Expected() : err(Errc::ok) {}
+
+        Expected(Unexpected error) : err(error.error) {}
+
+        bool has_value() const { return err == Errc::ok; }
+
+        explicit operator bool() const { return has_value(); }
+
+        Errc error() const { return err; }
+
+    private:
+        Errc err;
+    };
+} // namespace ds
+
+#endif // EXPECTED_HPP_GUARD_
@@ -0,0 +1,338 @@
+/**
+ * @file latency_histogram.hpp
+ * @author Ivan Penev
+ * @brief Opt-in per-operation latency recording with HDR-style histograms
+ * @date 2026-10-18
+ *
+ * Averages hide the rare slow operation - a dynamic_array growth, a deep BST
+ * descent. A LatencyRecorder attached to a container times its operations
+ * and keeps one histogram per operation type:
+ *
+ *     ds::LatencyRecorder latency;
+ *     arr.setLatencyRecorder(&latency);
+ *     ...
+ *     ds::LatencySnapshot push = latency.snapshot(ds::LatencyOp::push);
+ *     push.percentile(99.99); // nanoseconds
+ *
+ * The histograms are log-linear like HdrHistogram: 64 linear sub-buckets per
+ * power of two, so every recorded value is kept with a relative error below
+ * 1/64 (two significant digits) from one tick up to 2^64 ticks, in a fixed
+ * 30 KiB per operation type. The timestamps are read with rdtsc on x86 (the
+ * invariant TSC, converted to nanoseconds by a one-off calibration against
+ * steady_clock) and with clock_gettime elsewhere.
+ *
+ * A container and its recorder are used by one thread; the counters are
+ * atomics written with plain relaxed stores, so any other thread can take a
+ * snapshot at any time without locks. Nested operations (pop_front calling
+ * erase) are recorded once, as the outer one.
+ *
+ * Without a recorder an operation pays one predictable branch. A timed
+ * operation pays two timestamps and a record(): about 20 ns on a machine
+ * where rdtsc takes 8 ns (see latency_histogram_bench.cpp). LatencyRecorder(k)
+ * times only every 2^k-th operation; k = 4 brings the overhead to about 1 ns
+ * per operation, and the percentiles stay unbiased estimates.
+ */
+
+#ifndef LATENCY_HISTOGRAM_HPP_GUARD_
+#define LATENCY_HISTOGRAM_HPP_GUARD_
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h> // __rdtsc
+#define DS_LATENCY_RDTSC
+#else
+#include <time.h> // clock_gettime
+#endif
+
+namespace ds
+{
+    /**
+     * @brief The operation types a LatencyRecorder tells apart
+     */
+    enum class LatencyOp
+    {
+        push,   // push_back, push_front, push
+        pop,    // pop_back, pop_front, pop
+        insert, // insert at a position or of a key
+        erase,  // erase at a position or remove of a key
+        find,   // contains
+    };
+
+    const size_t LATENCY_OPS = 5;
+
+    inline const char *describe(LatencyOp op)
+    {
+        static const char *const NAMES[LATENCY_OPS] = {"push", "pop", "insert", "erase", "find"};
+        return NAMES[static_cast<size_t>(op)];
+    }
+
+    namespace detail
+    {
+        inline uint64_t latencyTicks()
+        {
+#ifdef DS_LATENCY_RDTSC
+            return __rdtsc();
+#else
+            timespec now;
+            clock_gettime(CLOCK_MONOTONIC, &now);
+            return uint64_t(now.tv_sec) * 1000000000u + uint64_t(now.tv_nsec);
+#endif
+        }
+
+        // Measured once, over 10 ms, the first time a snapshot is taken
+        inline double nanosecondsPerTick()
+        {
+#ifdef DS_LATENCY_RDTSC
+            static const double RATIO = []
+            {
+                typedef std::chrono::steady_clock Clock;
+                Clock::time_point start = Clock::now();
+                uint64_t startTicks = __rdtsc();
+                while (Clock::now() - start < std::chrono::milliseconds(10))
+                {
+                }
+                double elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+                return elapsed / double(__rdtsc() - startTicks);
+            }();
+            return RATIO;
+#else
+            return 1.0;
+#endif
+        }
+    } // namespace detail
+
+    /**
+     * @brief Log-linear histogram of tick counts, one writer and any number
+     * of concurrent readers
+     */
+    class LatencyHistogram
+    {
+    public:
+        // An enum, so that the constants can be bound to references without
+        // an out-of-class definition in C++11
+        enum : size_t
+        {
+            SUB_BITS = 7,
+            SUB_BUCKETS = size_t(1) << SUB_BITS, // values below are exact
+            BUCKETS = (64 - SUB_BITS + 1) * (SUB_BUCKETS / 2) + SUB_BUCKETS / 2,
+        };
+
+        LatencyHistogram() { reset(); }
+
+        /**
+         * @brief Adds a value; only the owning thread may call it
+         * @note Time complexity: O(1) - a bit scan and four stores
+         */
+        void record(uint64_t value)
+        {
+            std::atomic<uint64_t> &bucket = counts[bucketOf(value)];
+            bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            total.store(total.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            sum.store(sum.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+            if (value > max.load(std::memory_order_relaxed))
+                max.store(value, std::memory_order_relaxed);
+            if (value < min.load(std::memory_order_relaxed))
+                min.store(value, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Clears the histogram; not to be called during a record()
+         */
+        void reset()
+        {
+            for (std::atomic<uint64_t> &bucket : counts)
+                bucket.store(0, std::memory_order_relaxed);
+            total.store(0, std::memory_order_relaxed);
+            sum.store(0, std::memory_order_relaxed);
+            max.store(0, std::memory_order_relaxed);
+            min.store(UINT64_MAX, std::memory_order_relaxed);
+        }
+
+        uint64_t count() const { return total.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Returns the index of the bucket which holds value
+         */
+        static size_t bucketOf(uint64_t value)
+        {
+            if (value < SUB_BUCKETS)
+                return size_t(value);
+
+            unsigned shift = 64 - __builtin_clzll(value) - unsigned(SUB_BITS); // >= 1
+            return shift * (SUB_BUCKETS / 2) + size_t(value >> shift);
+        }
+
+        /**
+         * @brief Returns the largest value which falls into the bucket
+         */
+        static uint64_t bucketHigh(size_t index)
+        {
+            if (index < SUB_BUCKETS)
+                return index;
+
+            size_t shift = index / (SUB_BUCKETS / 2) - 1;
+            uint64_t low = uint64_t(index - shift * (SUB_BUCKETS / 2)) << shift;
+            return low + ((uint64_t(1) << shift) - 1);
+        }
+
+    private:
+        friend class LatencySnapshot;
+
+        std::atomic<uint64_t> counts[BUCKETS];
+        std::atomic<uint64_t> total;
+        std::atomic<uint64_t> sum;
+        std::atomic<uint64_t> max;
+        std::atomic<uint64_t> min;
+    };
+
+    /**
+     * @brief A copy of a histogram, in nanoseconds
+     *
+     * The copy is taken while the owner may keep recording, so the buckets
+     * can be a few operations apart; the total is computed from the copy.
+     */
+    class LatencySnapshot
+    {
+    public:
+        explicit LatencySnapshot(const LatencyHistogram &histogram)
+            : counts(LatencyHistogram::BUCKETS), total(0), scale(detail::nanosecondsPerTick())
+        {
+            for (size_t i = 0; i < LatencyHistogram::BUCKETS; i++)
+            {
+                counts[i] = histogram.counts[i].load(std::memory_order_relaxed);
+                total += counts[i];
+            }
+            sumTicks = histogram.sum.load(std::memory_order_relaxed);
+            maxTicks = histogram.max.load(std::memory_order_relaxed);
+            minTicks = total ? histogram.min.load(std::memory_order_relaxed) : 0;
+        }
+
+        uint64_t count() const { return total; }
+
+        double min() const { return minTicks * scale; }
+
+        double max() const { return maxTicks * scale; }
+
+        double mean() const { return total ? double(sumTicks) / total * scale : 0; }
+
+        /**
+         * @brief Returns the value below or at which percent of the
+         * operations fall (the upper edge of its bucket, at most max())
+         * @note Time complexity: O(buckets)
+         */
+        double percentile(double percent) const
+        {
+            if (total == 0)
+                return 0;
+
+            uint64_t rank = uint64_t(percent / 100.0 * double(total) + 0.5);
+            rank = rank < 1 ? 1 : rank > total ? total : rank;
+
+            uint64_t seen = 0;
+            for (size_t i = 0; i < counts.size(); i++)
+            {
+                seen += counts[i];
+                if (seen >= rank)
+                {
+                    uint64_t high = LatencyHistogram::bucketHigh(i);
+                    return (high < maxTicks ? high : maxTicks) * scale;
+                }
+            }
+            return max();
+        }
+
+    private:
+        std::vector<uint64_t> counts;
+        uint64_t total;
+        uint64_t sumTicks, maxTicks, minTicks;
+        double scale; // nanoseconds per tick
+    };
+
+    /**
+     * @brief One histogram per LatencyOp, attached to a container with
+     * setLatencyRecorder
+     */
+    class LatencyRecorder
+    {
+    public:
+        /**
+         * @brief Constructs a recorder which times every 2^sampleShift-th
+         * operation (every operation by default)
+         */
+        explicit LatencyRecorder(unsigned sampleShift = 0)
+            : period(uint32_t(1) << sampleShift), countdown(1) {}
+
+        LatencyRecorder(const LatencyRecorder &) = delete;
+        LatencyRecorder &operator=(const LatencyRecorder &) = delete;
+
+        LatencySnapshot snapshot(LatencyOp op) const { return LatencySnapshot(histograms[size_t(op)]); }
+
+        const LatencyHistogram &histogram(LatencyOp op) const { return histograms[size_t(op)]; }
+
+        void reset()
+        {
+            for (LatencyHistogram &histogram : histograms)
+                histogram.reset();
+        }
+
+    private:
+        friend class LatencyScope;
+
+        // True if the operation starting now is timed
+        bool enter()
+        {
+            if (depth++ != 0 || --countdown != 0)
+                return false;
+
+            countdown = period;
+            return true;
+        }
+
+        void leave() { --depth; }
+
+        LatencyHistogram histograms[LATENCY_OPS];
+        uint32_t period;
+        uint32_t countdown;
+        unsigned depth = 0;
+    };
+
+    /**
+     * @brief Times the enclosing container operation, if a recorder is attached
+     */
+    class LatencyScope
+    {
+    public:
+        LatencyScope(LatencyRecorder *recorder, LatencyOp op)
+            : recorder(recorder), op(op), timed(false), start(0)
+        {
+            if (recorder && (timed = recorder->enter()))
+                start = detail::latencyTicks();
+        }
+
+        ~LatencyScope()
+        {
+            if (recorder)
+            {
+                if (timed)
+                    recorder->histograms[size_t(op)].record(detail::latencyTicks() - start);
+                recorder->leave();
+            }
+        }
+
+        LatencyScope(const LatencyScope &) = delete;
+        LatencyScope &operator=(const LatencyScope &) = delete;
+
+    private:
+        LatencyRecorder *recorder;
+        LatencyOp op;
+        bool timed;
+        uint64_t start;
+    };
+} // namespace ds
+
+#endif // LATENCY_HISTOGRAM_HPP_GUARD_
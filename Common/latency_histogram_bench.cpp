@@ -0,0 +1,97 @@
+// Overhead of the latency recorder: dynamic_array push_back/pop_back cycles
+// and BST lookups without a recorder, with one timing every operation and
+// with one sampling every 16th operation. Then the percentiles it reports
+// for pushes into a growing dynamic_array - the growths are the tail.
+//
+// g++ -std=c++17 -O2 latency_histogram_bench.cpp -o latency_histogram_bench
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "latency_histogram.hpp"
+
+#include "../BinarySerachTree/BST.hpp"
+#include "../DynamicArray/dynamic_array.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+static const int OPS = 1 << 22;
+
+static double elapsed(Clock::time_point start)
+{
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+}
+
+static double arrayCycles(ds::LatencyRecorder *latency)
+{
+    ds::dynamic_array<int> arr;
+    arr.reserve(1024);
+    arr.setLatencyRecorder(latency);
+
+    auto start = Clock::now();
+    for (int i = 0; i < OPS / 2; i++)
+    {
+        arr.push_back(i);
+        if (arr.size() == 1000)
+            while (!arr.empty())
+                arr.pop_back();
+    }
+    return elapsed(start) / OPS;
+}
+
+static double treeLookups(ds::BST<int> &tree, const std::vector<int> &keys, ds::LatencyRecorder *latency)
+{
+    tree.setLatencyRecorder(latency);
+    size_t found = 0;
+    auto start = Clock::now();
+    for (int key : keys)
+        found += tree.contains(key);
+    double ns = elapsed(start) / keys.size();
+    tree.setLatencyRecorder(nullptr);
+    return found ? ns : 0;
+}
+
+int main()
+{
+    auto start = Clock::now();
+    unsigned long long ticks = 0;
+    for (int i = 0; i < OPS; i++)
+        ticks += ds::detail::latencyTicks();
+    std::cout << "Timestamp: " << elapsed(start) / OPS << " ns (" << (ticks & 1) << ")\n";
+
+    ds::LatencyRecorder every, sampled(4);
+
+    std::cout << "dynamic_array push_back/pop_back:\n"
+              << "  no recorder: " << arrayCycles(nullptr) << " ns/op\n"
+              << "  every op:    " << arrayCycles(&every) << " ns/op\n"
+              << "  1 in 16:     " << arrayCycles(&sampled) << " ns/op\n";
+
+    std::mt19937 rng(9);
+    ds::BST<int> tree;
+    for (int i = 0; i < 1 << 16; i++)
+        tree.try_insert(int(rng() % (1 << 20)));
+    std::vector<int> keys(OPS / 4);
+    for (int &key : keys)
+        key = int(rng() % (1 << 20));
+
+    std::cout << "BST contains (64K keys):\n"
+              << "  no recorder: " << treeLookups(tree, keys, nullptr) << " ns/op\n"
+              << "  every op:    " << treeLookups(tree, keys, &every) << " ns/op\n"
+              << "  1 in 16:     " << treeLookups(tree, keys, &sampled) << " ns/op\n";
+
+    // Where the time of a growing array goes
+    ds::LatencyRecorder growth;
+    {
+        ds::dynamic_array<long long> arr;
+        arr.setLatencyRecorder(&growth);
+        for (int i = 0; i < OPS; i++)
+            arr.push_back(i);
+    }
+    ds::LatencySnapshot push = growth.snapshot(ds::LatencyOp::push);
+    std::cout << "Growing dynamic_array push_back (" << push.count() << " ops): mean " << push.mean()
+              << " ns, p50 " << push.percentile(50) << ", p99 " << push.percentile(99)
+              << ", p99.99 " << push.percentile(99.99) << ", max " << push.max() << " ns\n";
+    return 0;
+}
@@ -0,0 +1,169 @@
+#define CATCH_CONFIG_MAIN
+#include "../Catch2/catch.hpp"
+#include "latency_histogram.hpp"
+
+#include "../BinarySerachTree/BST.hpp"
+#include "../DoublyLinkedList/list.hpp"
+#include "../DynamicArray/dynamic_array.hpp"
+#include "../Heap/binary_heap.hpp"
+#include "../Stacks/StackLinked/stack_linked.hpp"
+
+#include <random>
+
+using namespace ds;
+
+TEST_CASE("HISTOGRAM", "[LATENCY]")
+{
+    SECTION("BUCKETS")
+    {
+        // Contiguous, exact below SUB_BUCKETS and within 1/64 above
+        std::mt19937_64 rng(1);
+        for (int i = 0; i < 100000; i++)
+        {
+            uint64_t value = rng() >> (rng() % 64);
+            size_t bucket = LatencyHistogram::bucketOf(value);
+            REQUIRE(bucket < LatencyHistogram::BUCKETS);
+            REQUIRE(LatencyHistogram::bucketHigh(bucket) >= value);
+            REQUIRE(LatencyHistogram::bucketHigh(bucket) - value <= value / 64);
+            if (bucket > 0)
+                REQUIRE(LatencyHistogram::bucketHigh(bucket - 1) < value);
+        }
+
+        for (uint64_t value = 0; value < LatencyHistogram::SUB_BUCKETS; value++)
+            REQUIRE(LatencyHistogram::bucketHigh(LatencyHistogram::bucketOf(value)) == value);
+        REQUIRE(LatencyHistogram::bucketOf(UINT64_MAX) == LatencyHistogram::BUCKETS - 1);
+        REQUIRE(LatencyHistogram::bucketHigh(LatencyHistogram::BUCKETS - 1) == UINT64_MAX);
+    }
+
+    SECTION("PERCENTILES")
+    {
+        LatencyHistogram histogram;
+        for (uint64_t value = 1; value <= 10000; value++)
+            histogram.record(value);
+        histogram.record(1000000); // the one outlier
+
+        LatencySnapshot snapshot(histogram);
+        double tick = detail::nanosecondsPerTick();
+
+        REQUIRE(snapshot.count() == 10001);
+        REQUIRE(snapshot.min() == Approx(1 * tick));
+        REQUIRE(snapshot.max() == Approx(1000000 * tick));
+        REQUIRE(snapshot.percentile(50) / tick == Approx(5000).epsilon(1.0 / 64));
+        REQUIRE(snapshot.percentile(99) / tick == Approx(9900).epsilon(1.0 / 64));
+        REQUIRE(snapshot.percentile(99.99) / tick == Approx(10000).epsilon(1.0 / 64));
+        REQUIRE(snapshot.percentile(100) == snapshot.max());
+
+        histogram.reset();
+        REQUIRE(LatencySnapshot(histogram).count() == 0);
+        REQUIRE(LatencySnapshot(histogram).percentile(99) == 0);
+    }
+}
+
+TEST_CASE("RECORDER", "[LATENCY]")
+{
+    SECTION("CONTAINERS")
+    {
+        LatencyRecorder latency;
+
+        dynamic_array<int> arr;
+        arr.setLatencyRecorder(&latency);
+        for (int i = 0; i < 100; i++)
+            arr.push_back(i);
+        arr.insert(0, 1); // calls push_back - recorded once, as insert
+        arr.erase(0);
+        arr.pop_back();
+
+        REQUIRE(latency.snapshot(LatencyOp::push).count() == 100);
+        REQUIRE(latency.snapshot(LatencyOp::insert).count() == 1);
+        REQUIRE(latency.snapshot(LatencyOp::erase).count() == 1);
+        REQUIRE(latency.snapshot(LatencyOp::pop).count() == 1);
+        REQUIRE(latency.snapshot(LatencyOp::push).max() > 0);
+
+        latency.reset();
+        List<int> list;
+        list.setLatencyRecorder(&latency);
+        list.push_back(1);
+        list.push_front(0); // calls insert
+        list.pop_front();   // calls erase
+        REQUIRE(latency.snapshot(LatencyOp::push).count() == 2);
+        REQUIRE(latency.snapshot(LatencyOp::pop).count() == 1);
+        REQUIRE(latency.snapshot(LatencyOp::insert).count() == 0);
+        REQUIRE(latency.snapshot(LatencyOp::erase).count() == 0);
+        list.setLatencyRecorder(nullptr);
+
+        latency.reset();
+        BST<int> tree;
+        tree.setLatencyRecorder(&latency);
+        for (int key : {5, 3, 8})
+            tree.insert(key);
+        tree.contains(3);
+        tree.remove(3);
+        REQUIRE(latency.snapshot(LatencyOp::insert).count() == 3);
+        REQUIRE(latency.snapshot(LatencyOp::find).count() == 1);
+        REQUIRE(latency.snapshot(LatencyOp::erase).count() == 1);
+
+        latency.reset();
+        Stack<int> stk;
+        BinaryHeap<int> heap(BinaryHeap<int>::less);
+        stk.setLatencyRecorder(&latency);
+        heap.setLatencyRecorder(&latency);
+        stk.push(1);
+        heap.push(1);
+        stk.pop();
+        heap.pop();
+        REQUIRE(latency.snapshot(LatencyOp::push).count() == 2);
+        REQUIRE(latency.snapshot(LatencyOp::pop).count() == 2);
+    }
+
+    SECTION("CLEAR AND DESTRUCTION")
+    {
+        LatencyRecorder latency;
+        {
+            List<int> list;
+            Stack<int> stk;
+            list.setLatencyRecorder(&latency);
+            stk.setLatencyRecorder(&latency);
+            for (int i = 0; i < 10; i++)
+            {
+                list.push_back(i);
+                stk.push(i);
+            }
+            list.pop_front();
+            stk.pop();
+
+            list.clear();
+            stk = Stack<int>();
+            REQUIRE(latency.snapshot(LatencyOp::pop).count() == 2);
+
+            for (int i = 0; i < 10; i++)
+            {
+                list.push_back(i);
+                stk.push(i);
+            }
+            stk = Stack<int>();
+        }
+        REQUIRE(latency.snapshot(LatencyOp::pop).count() == 2);
+        REQUIRE(latency.snapshot(LatencyOp::push).count() == 40);
+
+        // A recorder declared after the containers is destroyed first
+        List<int> list2;
+        Stack<int> stk2;
+        LatencyRecorder recorder;
+        list2.setLatencyRecorder(&recorder);
+        stk2.setLatencyRecorder(&recorder);
+        list2.push_back(1);
+        stk2.push(1);
+    }
+
+    SECTION("SAMPLING")
+    {
+        LatencyRecorder latency(3); // every 8th operation
+        dynamic_array<int> arr;
+        arr.setLatencyRecorder(&latency);
+        for (int i = 0; i < 800; i++)
+            arr.push_back(i);
+
+        REQUIRE(latency.snapshot(LatencyOp::push).count() == 100);
+        REQUIRE(describe(LatencyOp::push) == std::string("push"));
+    }
+}
@@ -4,10 +4,22 @@
 /* Exception handling */
 #include <cassert>
 #include <stdexcept>
+#include "../Common/expected.hpp"
 
 /* Initializer list */
 #include <initializer_list>
 
+/* Compaction */
+#include <cstdint>
+#include <new>
+#include <utility>
+
+/* Node pool and sealing */
+#include "../Common/allocation_seal.hpp"
+
+/* Latency recording */
+#include "../Common/latency_histogram.hpp"
+
 namespace ds
 {
     template <typename ValueType>
@@ -42,9 +54,15 @@ namespace ds
 
         // Exchanges the contents of two lists
         // Size may differ
+        // The seal, the auto-compaction settings and the latency recorder
+        // stay with the object, they are not swapped
         void swap(List &other); // nothrow
 
-        ~List() { clear(); };
+        ~List()
+        {
+            latency = nullptr; // the recorder may already be gone
+            clear();
+        };
 
         /* Bidirectional iterator */
         class Iterator
@@ -127,6 +145,19 @@ namespace ds
         ValueType &back();
         const ValueType &back() const;
 
+        /* Non-throwing access and removal */
+
+        // Like front() and back(), but an empty list gives Errc::empty
+        Expected<ValueType &> try_front();
+        Expected<const ValueType &> try_front() const;
+
+        Expected<ValueType &> try_back();
+        Expected<const ValueType &> try_back() const;
+
+        // Like pop_front() and pop_back(), but an empty list gives Errc::empty
+        Expected<void> try_pop_front();
+        Expected<void> try_pop_back();
+
         /* Modifiers */
 
         // Insert methods
@@ -186,16 +217,96 @@ namespace ds
         // Time complexity: O(n)
         void remove(const ValueType &val);
 
+        /* Traversals */
+
+        // Visits every element from head to tail. The walk runs distance nodes
+        // (at most MAX_WALK_DISTANCE) ahead of the visitor and prefetches every
+        // node it finds, so the visitor works on cached nodes while the next
+        // misses are in flight. Does not allocate.
+        // Time complexity: O(n)
+        template <typename Visitor>
+        void for_each(Visitor visit, size_t distance = 8) const;
+
+        // Visits the elements of several lists, advancing one node of each of
+        // up to WALK_BATCH lists in turn, so the cache misses of the independent
+        // walks overlap. visit(i, value) gets the index of the list in lists.
+        // Does not allocate.
+        // Time complexity: O(total size)
+        template <typename Visitor>
+        static void for_each(const List *const *lists, size_t count, Visitor visit);
+
+        /* Locality */
+
+        // Moves every element into a single block of nodes laid out in list
+        // order, so a scan reads memory sequentially again. The elements are
+        // moved, not copied; iterators and references to them are invalidated.
+        // Time complexity: O(n)
+        void compact();
+
+        // Estimates how scattered the nodes are: the fraction of hops between
+        // neighbours which leave the vicinity of the node (a few cache lines),
+        // sampled over the first nodes of the list. 0 - laid out in order.
+        // Time complexity: O(1), at most FRAGMENTATION_SAMPLE hops
+        double fragmentation() const;
+
+        // When enabled, push_back and push_front compact the list once it has
+        // seen at least size() inserts/erases since the last compaction and
+        // the nodes are scattered beyond the threshold: at the front, as
+        // fragmentation() tells, or anywhere among the last
+        // FRAGMENTATION_SAMPLE links made by inserts since then, e.g. at the
+        // back of a queue, which reaches the front later. Any push may then
+        // invalidate iterators.
+        void setAutoCompact(bool enabled, double threshold = 0.5);
+
+        /* Steady state (see Common/allocation_seal.hpp) */
+
+        // Keeps spare nodes, so that count elements can be held without
+        // allocating; erased nodes are kept as spares up to count.
+        // Time complexity: O(count)
+        void reserve(size_t count);
+
+        // Reports every following allocation to the seal hook. A sealed list
+        // is not compacted automatically.
+        void seal();
+        void unseal();
+        bool isSealed() const;
+
+        // Times pushes, pops, insert and erase into recorder
+        // (see Common/latency_histogram.hpp); nullptr turns it off
+        void setLatencyRecorder(LatencyRecorder *recorder);
+
         // Helpers
     private:
         void copyFrom(const List &src);
 
+        // Frees a node, which may live in the compacted block
+        void release(Node *node);
+
+        // Called after every push in auto-compact mode
+        void maybeCompact();
+
+        // Records a link made by an insert, between a new node and its neighbour
+        void countLink(const Node *node, const Node *neighbour);
+        void forgetLinks();
+
+        // Whether a hop between the nodes leaves the vicinity (a few cache lines)
+        static bool isFar(const Node *from, const Node *to);
+
+        static const size_t FRAGMENTATION_SAMPLE = 256;
+        static const size_t COMPACT_MIN_SIZE = 1024;
+        static const size_t MAX_WALK_DISTANCE = 64;
+        static const size_t WALK_BATCH = 16;
+
     private:
         struct Node
         {
             Node(const ValueType &data, Node *prev = nullptr, Node *next = nullptr)
                 : data(data), prev(prev), next(next) {}
 
+            // Used by compact()
+            explicit Node(ValueType &&data)
+                : data(std::move(data)), prev(nullptr), next(nullptr) {}
+
             ValueType data;
             Node *prev;
             Node *next;
@@ -204,6 +315,27 @@ namespace ds
         Node *head;
         Node *tail;
         size_t m_size;
+
+        // Block of nodes made by compact(); freed with its last node
+        Node *block = nullptr;
+        size_t blockSize = 0;
+        size_t blockLive = 0;
+
+        size_t churn = 0; // inserts and erases since the last compaction
+
+        // Ring of the last FRAGMENTATION_SAMPLE links made by inserts - a bit
+        // per link which leaves the vicinity of the node
+        uint64_t recentLinks[FRAGMENTATION_SAMPLE / 64] = {};
+        size_t linkCount = 0;
+        size_t recentFar = 0;
+        bool scattered = false; // the ring exceeded the threshold since the last compaction
+
+        bool autoCompact = false;
+        double compactThreshold = 0.5;
+
+        NodePool<Node> pool{"List"};
+
+        LatencyRecorder *latency = nullptr; // stays with the object on swap
     };
 
     template <typename ValueType>
@@ -248,13 +380,33 @@ namespace ds
         swap(this->m_size, other.m_size);
         swap(this->head, other.head);
         swap(this->tail, other.tail);
+        swap(this->block, other.block);
+        swap(this->blockSize, other.blockSize);
+        swap(this->blockLive, other.blockLive);
+        swap(this->churn, other.churn);
+        swap(this->recentLinks, other.recentLinks);
+        swap(this->linkCount, other.linkCount);
+        swap(this->recentFar, other.recentFar);
+        swap(this->scattered, other.scattered);
+        this->pool.swap(other.pool);
     }
 
     template <typename ValueType>
     void List<ValueType>::clear()
     {
-        while (!empty())
-            pop_front();
+        // Frees the nodes directly, so that no pops are timed
+        Node *node = head;
+        while (node)
+        {
+            Node *next = node->next;
+            release(node);
+            node = next;
+        }
+
+        head = tail = nullptr;
+        m_size = 0;
+        churn = 0;
+        forgetLinks();
     }
 
     template <typename ValueType>
@@ -268,14 +420,14 @@ namespace ds
         // of the current list, consequently if it is not used on an
         // empty list, memory leaks are possible.
 
-        head = new Node(src.head->data);
+        head = pool.create(src.head->data);
         tail = head;
         ++m_size;
 
         Node *toCopy = src.head->next;
         while (toCopy)
         {
-            tail->next = new Node(toCopy->data, tail);
+            tail->next = pool.create(toCopy->data, tail);
             tail = tail->next;
             ++m_size;
 
@@ -286,15 +438,19 @@ namespace ds
     template <typename ValueType>
     inline typename List<ValueType>::Iterator List<ValueType>::insert(Iterator pos, const ValueType &value)
     {
+        LatencyScope timer(latency, LatencyOp::insert);
         if (pos == nullptr)
         {
             push_back(value);
             return Iterator(tail);
         }
-        else if (pos.ptr == head)
+
+        ++churn;
+        if (pos.ptr == head)
         {
-            head->prev = new Node(value, nullptr, head);
+            head->prev = pool.create(value, nullptr, head);
             head = head->prev;
+            countLink(head, head->next);
             ++m_size;
 
             return Iterator(head);
@@ -302,8 +458,9 @@ namespace ds
         else
         {
             Node *prev = pos.ptr->prev;
-            pos.ptr->prev = new Node(value, prev, pos.ptr);
+            pos.ptr->prev = pool.create(value, prev, pos.ptr);
             prev->next = pos.ptr->prev;
+            countLink(prev->next, prev);
 
             ++m_size;
             return Iterator(pos.ptr->prev);
@@ -313,6 +470,7 @@ namespace ds
     template <typename ValueType>
     inline void List<ValueType>::push_back(const ValueType &value)
     {
+        LatencyScope timer(latency, LatencyOp::push);
         if (empty())
         {
             // List is empty.
@@ -322,31 +480,38 @@ namespace ds
             assert(head == nullptr);
             assert(tail == nullptr);
 
-            head = new Node(value);
+            head = pool.create(value);
             tail = head;
         }
         else
         {
-            tail->next = new Node(value, tail);
+            tail->next = pool.create(value, tail);
             tail = tail->next;
+            countLink(tail, tail->prev);
         }
 
         ++m_size;
+        ++churn;
+        maybeCompact();
     }
 
     template <typename ValueType>
     inline void List<ValueType>::push_front(const ValueType &value)
     {
+        LatencyScope timer(latency, LatencyOp::push);
         insert(Iterator(head), value);
+        maybeCompact();
     }
 
     template <typename ValueType>
     inline typename List<ValueType>::Iterator List<ValueType>::erase(Iterator pos)
     {
+        LatencyScope timer(latency, LatencyOp::erase);
         if (empty() || pos.ptr == nullptr)
             return end();
 
         Node *toRemove = nullptr;
+        ++churn;
 
         if (pos.ptr == head)
         {
@@ -362,7 +527,7 @@ namespace ds
                 tail = nullptr;
             }
 
-            delete toRemove;
+            release(toRemove);
             --m_size;
 
             return begin();
@@ -382,7 +547,7 @@ namespace ds
                 head = nullptr;
             }
 
-            delete toRemove;
+            release(toRemove);
             --m_size;
 
             return end();
@@ -396,7 +561,7 @@ namespace ds
             next->prev = pos.ptr->prev;
             pos.ptr = pos.ptr->next;
 
-            delete toRemove;
+            release(toRemove);
             --m_size;
 
             return Iterator(pos.ptr);
@@ -406,9 +571,10 @@ namespace ds
     template <typename ValueType>
     inline void List<ValueType>::pop_front()
     {
+        LatencyScope timer(latency, LatencyOp::pop);
         if (empty())
         {
-            throw std::logic_error("pop_front(): Cannot perform pop. The list is empty!");
+            DS_THROW(std::logic_error, "pop_front(): Cannot perform pop. The list is empty!");
         }
 
         erase(begin());
@@ -417,9 +583,10 @@ namespace ds
     template <typename ValueType>
     inline void List<ValueType>::pop_back()
     {
+        LatencyScope timer(latency, LatencyOp::pop);
         if (empty())
         {
-            throw std::logic_error("pop_back(): Cannot perform pop. The list is empty!");
+            DS_THROW(std::logic_error, "pop_back(): Cannot perform pop. The list is empty!");
         }
 
         erase(Iterator(tail));
@@ -430,7 +597,7 @@ namespace ds
     {
         if (empty())
         {
-            throw std::logic_error("front(): Cannot access an element. The list is empty!");
+            DS_THROW(std::logic_error, "front(): Cannot access an element. The list is empty!");
         }
 
         return head->data;
@@ -447,7 +614,7 @@ namespace ds
     {
         if (empty())
         {
-            throw std::logic_error("back(): Cannot access an element. The list is empty!");
+            DS_THROW(std::logic_error, "back(): Cannot access an element. The list is empty!");
         }
 
         return tail->data;
@@ -459,6 +626,64 @@ namespace ds
         return const_cast<List<ValueType> &>(*this).back();
     }
 
+    template <typename ValueType>
+    inline Expected<ValueType &> List<ValueType>::try_front()
+    {
+        if (empty())
+            return Unexpected(Errc::empty);
+
+        return head->data;
+    }
+
+    template <typename ValueType>
+    inline Expected<const ValueType &> List<ValueType>::try_front() const
+    {
+        if (empty())
+            return Unexpected(Errc::empty);
+
+        return head->data;
+    }
+
+    template <typename ValueType>
+    inline Expected<ValueType &> List<ValueType>::try_back()
+    {
+        if (empty())
+            return Unexpected(Errc::empty);
+
+        return tail->data;
+    }
+
+    template <typename ValueType>
+    inline Expected<const ValueType &> List<ValueType>::try_back() const
+    {
+        if (empty())
+            return Unexpected(Errc::empty);
+
+        return tail->data;
+    }
+
+    template <typename ValueType>
+    inline Expected<void> List<ValueType>::try_pop_front()
+    {
+        LatencyScope timer(latency, LatencyOp::pop);
+        if (empty())
+            return Unexpected(Errc::empty);
+
+        erase(begin());
+        return Expected<void>();
+    }
+
+    template <typename ValueType>
+    inline Expected<void> List<ValueType>::try_pop_back()
+    {
+        LatencyScope timer(latency, LatencyOp::pop);
+        if (empty())
+            return Unexpected(Errc::empty);
+
+        erase(Iterator(tail));
+        return Expected<void>();
+    }
+
     template <typename ValueType>
     inline size_t List<ValueType>::size() const
     {
@@ -502,6 +727,240 @@ namespace ds
         }
     }
 
+    template <typename ValueType>
+    template <typename Visitor>
+    inline void List<ValueType>::for_each(Visitor visit, size_t distance) const
+    {
+        if (distance == 0)
+            distance = 1;
+        if (distance > MAX_WALK_DISTANCE)
+            distance = MAX_WALK_DISTANCE;
+
+        // Ring of the nodes found by the walk but not yet visited
+        Node *ring[MAX_WALK_DISTANCE];
+        size_t found = 0, visited = 0;
+
+        Node *ahead = head;
+        while (ahead && found < distance)
+        {
+            ring[found++ % distance] = ahead;
+            ahead = ahead->next;
+        }
+
+        while (visited < found)
+        {
+            visit(ring[visited++ % distance]->data);
+
+            if (ahead)
+            {
+                __builtin_prefetch(ahead->next);
+                ring[found++ % distance] = ahead;
+                ahead = ahead->next;
+            }
+        }
+    }
+
+    template <typename ValueType>
+    template <typename Visitor>
+    inline void List<ValueType>::for_each(const List *const *lists, size_t count, Visitor visit)
+    {
+        // The lists are walked WALK_BATCH at a time
+        Node *cursors[WALK_BATCH];
+        for (size_t first = 0; first < count; first += WALK_BATCH)
+        {
+            size_t batch = count - first < WALK_BATCH ? count - first : WALK_BATCH;
+            for (size_t i = 0; i < batch; i++)
+                cursors[i] = lists[first + i]->head;
+
+            size_t active = batch;
+            while (active > 0)
+            {
+                active = 0;
+                for (size_t i = 0; i < batch; i++)
+                {
+                    Node *node = cursors[i];
+                    if (!node)
+                        continue;
+
+                    // Start the next miss of this list before visiting
+                    __builtin_prefetch(node->next);
+                    visit(first + i, node->data);
+                    cursors[i] = node->next;
+                    ++active;
+                }
+            }
+        }
+    }
+
+    template <typename ValueType>
+    inline void List<ValueType>::compact()
+    {
+        churn = 0;
+        forgetLinks();
+        if (m_size == 0)
+            return;
+
+        if (pool.isSealed())
+            detail::sealedAllocation("List", m_size * sizeof(Node));
+
+        // Raw memory - the nodes are constructed in place from the old ones
+        Node *nodes = static_cast<Node *>(::operator new(m_size * sizeof(Node)));
+        size_t built = 0;
+        DS_TRY
+        {
+            for (Node *node = head; node; node = node->next, ++built)
+                new (nodes + built) Node(std::move(node->data));
+        }
+        DS_CATCH_ALL
+        {
+            // The elements moved so far are lost, like in a failed std::vector growth
+            for (size_t i = 0; i < built; i++)
+                nodes[i].~Node();
+            ::operator delete(nodes);
+            DS_RETHROW;
+        }
+
+        // Free the old nodes (the old block goes with its last node)
+        Node *node = head;
+        while (node)
+        {
+            Node *next = node->next;
+            release(node);
+            node = next;
+        }
+
+        for (size_t i = 0; i < m_size; i++)
+        {
+            nodes[i].prev = i > 0 ? nodes + i - 1 : nullptr;
+            nodes[i].next = i + 1 < m_size ? nodes + i + 1 : nullptr;
+        }
+
+        head = nodes;
+        tail = nodes + m_size - 1;
+        block = nodes;
+        blockSize = blockLive = m_size;
+    }
+
+    template <typename ValueType>
+    inline double List<ValueType>::fragmentation() const
+    {
+        size_t hops = 0, far = 0;
+        for (Node *node = head; node && node->next && hops < FRAGMENTATION_SAMPLE; node = node->next)
+        {
+            far += isFar(node, node->next);
+            ++hops;
+        }
+
+        return hops ? (double)far / hops : 0;
+    }
+
+    template <typename ValueType>
+    inline void List<ValueType>::setAutoCompact(bool enabled, double threshold)
+    {
+        autoCompact = enabled;
+        compactThreshold = threshold;
+    }
+
+    template <typename ValueType>
+    inline void List<ValueType>::reserve(size_t count)
+    {
+        pool.reserve(count);
+    }
+
+    template <typename ValueType>
+    inline void List<ValueType>::seal()
+    {
+        pool.seal();
+    }
+
+    template <typename ValueType>
+    inline void List<ValueType>::unseal()
+    {
+        pool.unseal();
+    }
+
+    template <typename ValueType>
+    inline bool List<ValueType>::isSealed() const
+    {
+        return pool.isSealed();
+    }
+
+    template <typename ValueType>
+    inline void List<ValueType>::setLatencyRecorder(LatencyRecorder *recorder)
+    {
+        latency = recorder;
+    }
+
+    template <typename ValueType>
+    inline void List<ValueType>::release(Node *node)
+    {
+        if (block && node >= block && node < block + blockSize)
+        {
+            node->~Node();
+            if (--blockLive == 0)
+            {
+                ::operator delete(block);
+                block = nullptr;
+                blockSize = 0;
+            }
+        }
+        else
+        {
+            pool.destroy(node);
+        }
+    }
+
+    template <typename ValueType>
+    inline void List<ValueType>::maybeCompact()
+    {
+        if (!autoCompact || pool.isSealed() || m_size < COMPACT_MIN_SIZE || churn < m_size)
+            return;
+
+        // Checked at most once per size() changes, so the sample is O(1) amortized
+        churn = 0;
+        if (scattered || fragmentation() > compactThreshold)
+            compact();
+    }
+
+    template <typename ValueType>
+    inline void List<ValueType>::countLink(const Node *node, const Node *neighbour)
+    {
+        size_t slot = linkCount++ % FRAGMENTATION_SAMPLE;
+        uint64_t &word = recentLinks[slot / 64];
+        uint64_t bit = uint64_t(1) << (slot % 64);
+
+        recentFar -= (word & bit) != 0;
+        if (isFar(node, neighbour))
+        {
+            word |= bit;
+            ++recentFar;
+        }
+        else
+        {
+            word &= ~bit;
+        }
+
+        scattered = scattered || recentFar > compactThreshold * FRAGMENTATION_SAMPLE;
+    }
+
+    template <typename ValueType>
+    inline void List<ValueType>::forgetLinks()
+    {
+        for (uint64_t &word : recentLinks)
+            word = 0;
+        recentFar = 0;
+        scattered = false;
+    }
+
+    template <typename ValueType>
+    inline bool List<ValueType>::isFar(const Node *from, const Node *to)
+    {
+        const uintptr_t VICINITY = 4 * 64;
+
+        uintptr_t a = reinterpret_cast<uintptr_t>(from), b = reinterpret_cast<uintptr_t>(to);
+        return (a > b ? a - b : b - a) > VICINITY;
+    }
+
 } // namespace ds
 
 #endif // LIST_HPP_GUARD_
\ No newline at end of file
@@ -0,0 +1,76 @@
+// A list whose nodes are scattered over the heap - built over shuffled free
+// blocks, then churned by random erases and inserts - scanned before and
+// after compact(), and the cost of the compaction itself.
+//
+// g++ -std=c++17 -O2 list_compact_bench.cpp -o list_compact_bench
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "list.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+static const size_t N = 1 << 21; // 2M nodes of 32 bytes - 64 MiB
+static const size_t PASSES = 5;
+
+static double elapsed(Clock::time_point start)
+{
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+}
+
+static void scan(const char *name, const ds::List<long long> &list)
+{
+    long long sum = 0;
+    auto start = Clock::now();
+    for (size_t pass = 0; pass < PASSES; pass++)
+        for (auto itr = list.begin(); itr != list.end(); ++itr)
+            sum += *itr;
+    std::cout << "  " << name << ": " << elapsed(start) / (PASSES * list.size())
+              << " ns/node (fragmentation " << list.fragmentation() << ", sum " << sum << ")\n";
+}
+
+int main()
+{
+    // Allocate and free node-sized blocks in random order, so the list's
+    // allocations come back scattered (the allocator reuses them LIFO)
+    std::mt19937 rng(5);
+    {
+        std::vector<void *> blocks(N);
+        for (void *&block : blocks)
+            block = malloc(3 * sizeof(void *));
+        std::shuffle(blocks.begin(), blocks.end(), rng);
+        for (void *block : blocks)
+            free(block);
+    }
+
+    ds::List<long long> list;
+    for (size_t i = 0; i < N; i++)
+        list.push_back((long long)i);
+
+    // Churn: erase and insert at random positions reached by a short walk
+    auto itr = list.begin();
+    for (size_t i = 0; i < N / 4; i++)
+    {
+        for (size_t steps = rng() % 64; steps > 0 && itr != list.end(); steps--)
+            ++itr;
+        if (itr == list.end())
+            itr = list.begin();
+        itr = list.erase(itr);
+        list.insert(itr, (long long)i);
+    }
+
+    std::cout << "List of " << list.size() << " nodes\n";
+    scan("scattered", list);
+
+    auto start = Clock::now();
+    list.compact();
+    std::cout << "  compact(): " << elapsed(start) / list.size() << " ns/node\n";
+
+    scan("compacted", list);
+    return 0;
+}
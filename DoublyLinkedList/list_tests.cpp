@@ -1,7 +1,14 @@
 #define CATCH_CONFIG_MAIN
 #include "../Catch2/catch.hpp"
+#include "../Common/catch_no_exceptions.hpp"
 #include "list.hpp"
 
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
 using namespace ds;
 
 TEST_CASE("CONSTRUCTORS", "[DEFAULT][COPY][OPERATOR=]")
@@ -169,3 +176,213 @@ TEST_CASE("OPERATIONS", "[PUSH][POP][ACCESS]")
         REQUIRE_THROWS(list.pop_front());
     }
 }
+
+TEST_CASE("TRAVERSALS", "[FOR_EACH]")
+{
+    SECTION("PREFETCHING WALK")
+    {
+        List<int> list;
+        for (int i = 0; i < 1000; i++)
+            list.push_back(i);
+
+        for (size_t distance : {0, 1, 8, 999, 1000, 5000})
+        {
+            int expected = 0;
+            bool inOrder = true;
+            list.for_each([&](int value)
+                          { inOrder &= value == expected++; },
+                          distance);
+
+            REQUIRE(inOrder);
+            REQUIRE(expected == 1000);
+        }
+
+        List<int> empty;
+        int visits = 0;
+        empty.for_each([&](int)
+                       { ++visits; });
+        REQUIRE(visits == 0);
+    }
+
+    SECTION("INTERLEAVED WALKS")
+    {
+        List<int> a = {1, 2, 3}, b, c = {10, 20, 30, 40, 50};
+        const List<int> *lists[] = {&a, &b, &c};
+
+        std::vector<int> seen[3];
+        List<int>::for_each(lists, 3, [&](size_t list, int value)
+                            { seen[list].push_back(value); });
+
+        REQUIRE(seen[0] == std::vector<int>{1, 2, 3});
+        REQUIRE(seen[1].empty());
+        REQUIRE(seen[2] == std::vector<int>{10, 20, 30, 40, 50});
+    }
+
+    SECTION("MORE LISTS THAN A BATCH")
+    {
+        std::vector<List<int>> many(40);
+        std::vector<const List<int> *> lists;
+        for (int i = 0; i < 40; i++)
+        {
+            for (int j = 0; j < i; j++)
+                many[i].push_back(i * 100 + j);
+            lists.push_back(&many[i]);
+        }
+
+        std::vector<std::vector<int>> seen(40);
+        List<int>::for_each(lists.data(), lists.size(), [&](size_t list, int value)
+                            { seen[list].push_back(value); });
+
+        for (int i = 0; i < 40; i++)
+        {
+            REQUIRE(seen[i].size() == size_t(i));
+            for (int j = 0; j < i; j++)
+                REQUIRE(seen[i][j] == i * 100 + j);
+        }
+    }
+}
+
+template <typename T>
+static std::vector<T> toVector(const List<T> &list)
+{
+    std::vector<T> elements;
+    for (const T &element : list)
+        elements.push_back(element);
+    return elements;
+}
+
+TEST_CASE("COMPACTION", "[COMPACT]")
+{
+    SECTION("ORDER AND LAYOUT")
+    {
+        List<std::string> list;
+        for (int i = 0; i < 500; i++)
+            list.push_back(std::to_string(i));
+
+        // Churn: drop every third element, put new ones at the front
+        auto itr = list.begin();
+        for (int i = 0; itr != list.end(); i++)
+            itr = i % 3 == 0 ? list.erase(itr) : ++itr;
+        for (int i = 0; i < 100; i++)
+            list.push_front("front" + std::to_string(i));
+
+        std::vector<std::string> before = toVector(list);
+        list.compact();
+        std::vector<std::string> after = toVector(list);
+
+        REQUIRE(after == before);
+        REQUIRE(list.size() == before.size());
+        REQUIRE(list.fragmentation() == 0);
+
+        // Still a working list: the block is freed node by node
+        list.push_back("tail");
+        list.erase(++list.begin());
+        REQUIRE(list.back() == "tail");
+        REQUIRE(list.size() == before.size());
+
+        list.compact(); // a second block replaces the first
+        REQUIRE(toVector(list).size() == before.size());
+
+        list.clear();
+        REQUIRE(list.empty());
+        list.compact();
+        REQUIRE(list.empty());
+    }
+
+    SECTION("COPY AND SWAP")
+    {
+        List<int> list = {1, 2, 3, 4};
+        list.compact();
+
+        List<int> copy = list;
+        List<int> other = {9};
+        other.swap(list);
+
+        REQUIRE(other.size() == 4);
+        REQUIRE(other.front() == 1);
+        REQUIRE(copy.back() == 4);
+        REQUIRE(list.front() == 9);
+    }
+
+    SECTION("AUTOMATIC")
+    {
+        // Inserting at random positions leaves the list order unrelated to
+        // the allocation order
+        std::mt19937 rng(4);
+        List<int> list;
+        list.push_back(0);
+        for (int i = 1; i < 3000; i++)
+        {
+            auto itr = list.begin();
+            for (size_t steps = rng() % list.size(); steps > 0; steps--)
+                ++itr;
+            list.insert(itr, i);
+        }
+        for (int i = 0; i < 100; i++)
+            list.erase(list.begin());
+        REQUIRE(list.fragmentation() > 0.5);
+
+        list.setAutoCompact(true, 0.25);
+        list.push_back(-1);
+
+        REQUIRE(list.fragmentation() == 0);
+        REQUIRE(list.size() == 2901);
+        REQUIRE(list.back() == -1);
+    }
+
+    SECTION("AUTOMATIC ON A QUEUE")
+    {
+        // Allocations between the pushes scatter the nodes appended by push_back
+        std::vector<std::unique_ptr<char[]>> noise;
+        List<int> list;
+        list.setAutoCompact(true, 0.25);
+        for (int i = 0; i < 2000; i++)
+        {
+            noise.emplace_back(new char[512]);
+            list.push_back(i);
+        }
+
+        // Scattered nodes appended at the back are compacted before they
+        // reach the front, where fragmentation() samples them
+        double worst = 0;
+        for (int i = 2000; i < 12000; i++)
+        {
+            noise[i % noise.size()].reset(new char[512]);
+            list.push_back(i);
+            list.pop_front();
+            if (i % 100 == 0)
+                worst = std::max(worst, list.fragmentation());
+        }
+
+        REQUIRE(worst <= 0.25);
+        REQUIRE(list.size() == 2000);
+        REQUIRE(list.front() == 10000);
+        REQUIRE(list.back() == 11999);
+    }
+}
+
+TEST_CASE("TRY API", "[NOEXCEPT]")
+{
+    List<int> list;
+
+    REQUIRE(list.try_front().error() == Errc::empty);
+    REQUIRE(list.try_back().error() == Errc::empty);
+    REQUIRE(list.try_pop_front().error() == Errc::empty);
+    REQUIRE(list.try_pop_back().error() == Errc::empty);
+
+    list.push_back(1);
+    list.push_back(2);
+    list.push_back(3);
+
+    *list.try_back() += 10;
+    REQUIRE(list.back() == 13);
+    REQUIRE(list.try_front().value() == 1);
+
+    REQUIRE(list.try_pop_front());
+    REQUIRE(list.try_pop_back());
+    REQUIRE(list.size() == 1);
+
+    const List<int> &view = list;
+    REQUIRE(*view.try_front() == 2);
+    REQUIRE(*view.try_back() == 2);
+}
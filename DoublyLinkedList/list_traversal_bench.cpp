@@ -0,0 +1,86 @@
+// Walking lists much larger than the last level cache whose nodes are
+// scattered over the heap: the plain iterator, for_each with prefetching
+// lookahead, and the interleaved for_each over several lists. The visitor
+// does a little work per element, as a real kernel would.
+//
+// g++ -std=c++17 -O2 list_traversal_bench.cpp -o list_traversal_bench
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "list.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+static const size_t N = 1 << 22; // 4M nodes of 32 bytes - 128 MiB
+static const size_t LISTS = 8;
+
+static unsigned long long checksum = 0;
+
+static void visit(long long value)
+{
+    // A few dependent multiplications - the work a kernel does per node
+    unsigned long long h = (unsigned long long)value;
+    for (int i = 0; i < 4; i++)
+        h = h * 0x9e3779b97f4a7c15ull + (h >> 29);
+    checksum += h;
+}
+
+template <typename Walk>
+static void measure(const std::string &name, Walk walk)
+{
+    auto start = Clock::now();
+    walk();
+    double total = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    std::cout << "  " << name << ": " << total / N << " ns/node\n";
+}
+
+int main()
+{
+    // Allocate and free node-sized blocks in random order, so the list's
+    // allocations come back scattered (the allocator reuses them LIFO)
+    std::mt19937 rng(3);
+    {
+        std::vector<void *> blocks(N);
+        for (void *&block : blocks)
+            block = malloc(3 * sizeof(void *));
+        std::shuffle(blocks.begin(), blocks.end(), rng);
+        for (void *block : blocks)
+            free(block);
+    }
+
+    std::vector<ds::List<long long>> lists(LISTS);
+    for (size_t i = 0; i < N; i++)
+        lists[i % LISTS].push_back((long long)i);
+
+    std::cout << LISTS << " lists, " << N << " nodes in total\n";
+
+    measure("iterator", [&]
+            {
+                for (const ds::List<long long> &list : lists)
+                    for (long long value : list)
+                        visit(value); });
+
+    for (size_t distance : {4, 16, 64})
+    {
+        measure("for_each, distance " + std::to_string(distance), [&]
+                {
+                    for (const ds::List<long long> &list : lists)
+                        list.for_each(visit, distance); });
+    }
+
+    std::vector<const ds::List<long long> *> pointers;
+    for (const ds::List<long long> &list : lists)
+        pointers.push_back(&list);
+    measure("interleaved walks", [&]
+            { ds::List<long long>::for_each(pointers.data(), pointers.size(), [](size_t, long long value)
+                                            { visit(value); }); });
+
+    std::cout << "(checksum " << checksum << ")\n";
+    return 0;
+}
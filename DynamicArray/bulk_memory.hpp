@@ -0,0 +1,232 @@
+#ifndef BULK_MEMORY_GUARD
+#define BULK_MEMORY_GUARD
+
+/*
+ *  Bulk copy and fill of large arrays of trivially copyable elements.
+ *
+ *  Small ranges go to memcpy / a plain loop. Above BULK_STREAMING_THRESHOLD
+ *  bytes the destination is written with non-temporal (streaming) stores,
+ *  which bypass the cache: a copy larger than the last level cache would
+ *  evict everything else and then read every destination line just to
+ *  overwrite it. Above BULK_THREADING_THRESHOLD bytes the range is split
+ *  into contiguous chunks, one per hardware thread. Each worker is the first
+ *  to write its chunk of a freshly allocated buffer, so with the default
+ *  first-touch policy the pages land on the NUMA node of the thread that
+ *  wrote them, and later threaded passes over the same chunks stay local.
+ *  On Linux large destinations are also advised to use transparent huge
+ *  pages, which cuts the page faults of a fresh buffer by 512x.
+ *
+ *  Element types which are not trivially copyable are assigned one by one.
+ *  The thresholds and the thread count can be overridden before including
+ *  the header.
+*/
+
+#include <algorithm> // std::min
+#include <cstddef>
+#include <cstdint>
+#include <cstring> // memcpy
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#if defined(__AVX__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#if defined(__linux__)
+#include <sys/mman.h> // madvise
+#endif
+
+#ifndef BULK_STREAMING_THRESHOLD
+#define BULK_STREAMING_THRESHOLD (8u << 20) // bytes; about the size of an LLC
+#endif
+
+#ifndef BULK_THREADING_THRESHOLD
+#define BULK_THREADING_THRESHOLD (64u << 20) // bytes; each thread gets at least this much / 2
+#endif
+
+#ifndef BULK_THREADS
+#define BULK_THREADS 0 // 0 - one per hardware thread
+#endif
+
+namespace ds
+{
+    namespace bulk_detail
+    {
+#if defined(__AVX__)
+        const size_t VECTOR = 32;
+#elif defined(__SSE2__)
+        const size_t VECTOR = 16;
+#else
+        const size_t VECTOR = 0; // no streaming stores
+#endif
+
+        // Streams [src, src + bytes) to dst; dst is VECTOR-aligned, bytes a multiple of VECTOR
+        inline void streamCopy(char *dst, const char *src, size_t bytes)
+        {
+#if defined(__AVX__)
+            for (size_t i = 0; i < bytes; i += 32)
+                _mm256_stream_si256(reinterpret_cast<__m256i *>(dst + i),
+                                    _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i)));
+            _mm_sfence();
+#elif defined(__SSE2__)
+            for (size_t i = 0; i < bytes; i += 16)
+                _mm_stream_si128(reinterpret_cast<__m128i *>(dst + i),
+                                 _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i)));
+            _mm_sfence();
+#else
+            memcpy(dst, src, bytes);
+#endif
+        }
+
+        // Streams copies of a VECTOR-byte pattern to dst, same requirements
+        inline void streamPattern(char *dst, const char *pattern, size_t bytes)
+        {
+#if defined(__AVX__)
+            const __m256i value = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pattern));
+            for (size_t i = 0; i < bytes; i += 32)
+                _mm256_stream_si256(reinterpret_cast<__m256i *>(dst + i), value);
+            _mm_sfence();
+#elif defined(__SSE2__)
+            const __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pattern));
+            for (size_t i = 0; i < bytes; i += 16)
+                _mm_stream_si128(reinterpret_cast<__m128i *>(dst + i), value);
+            _mm_sfence();
+#else
+            for (size_t i = 0; i < bytes; i += VECTOR)
+                memcpy(dst + i, pattern, VECTOR);
+#endif
+        }
+
+        // Asks for huge pages on the 2 MiB-aligned part of a large range; only a hint
+        inline void adviseHugePages(void *dst, size_t bytes)
+        {
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+            const uintptr_t HUGE_PAGE = 2u << 20;
+            if (bytes < BULK_STREAMING_THRESHOLD)
+                return;
+
+            uintptr_t begin = (reinterpret_cast<uintptr_t>(dst) + HUGE_PAGE - 1) & ~(HUGE_PAGE - 1);
+            uintptr_t end = (reinterpret_cast<uintptr_t>(dst) + bytes) & ~(HUGE_PAGE - 1);
+            if (begin < end)
+                madvise(reinterpret_cast<void *>(begin), end - begin, MADV_HUGEPAGE);
+#else
+            (void)dst;
+            (void)bytes;
+#endif
+        }
+
+        // Copies bytes, streaming the aligned middle part when it is large
+        inline void copyBytes(char *dst, const char *src, size_t bytes)
+        {
+            if (VECTOR == 0 || bytes < BULK_STREAMING_THRESHOLD)
+            {
+                memcpy(dst, src, bytes);
+                return;
+            }
+
+            size_t head = (VECTOR - reinterpret_cast<uintptr_t>(dst) % VECTOR) % VECTOR;
+            size_t body = (bytes - head) / VECTOR * VECTOR;
+            memcpy(dst, src, head);
+            streamCopy(dst + head, src + head, body);
+            memcpy(dst + head + body, src + head + body, bytes - head - body);
+        }
+
+        template <class T>
+        void fillElements(T *dst, size_t count, const T &value)
+        {
+            size_t bytes = count * sizeof(T);
+            bool streamable = VECTOR != 0 && bytes >= BULK_STREAMING_THRESHOLD &&
+                              VECTOR % sizeof(T) == 0 && reinterpret_cast<uintptr_t>(dst) % sizeof(T) == 0;
+            if (!streamable)
+            {
+                std::fill(dst, dst + count, value);
+                return;
+            }
+
+            // Elements until dst is aligned; the pattern then starts at an element
+            size_t head = (VECTOR - reinterpret_cast<uintptr_t>(dst) % VECTOR) % VECTOR / sizeof(T);
+            std::fill(dst, dst + head, value);
+
+            char pattern[VECTOR > 0 ? VECTOR : 1];
+            for (size_t i = 0; i < VECTOR; i += sizeof(T))
+                memcpy(pattern + i, &value, sizeof(T));
+
+            size_t body = (count - head) * sizeof(T) / VECTOR * VECTOR;
+            streamPattern(reinterpret_cast<char *>(dst + head), pattern, body);
+
+            size_t done = head + body / sizeof(T);
+            std::fill(dst + done, dst + count, value);
+        }
+
+        // Runs work(begin, end) over [0, count) split across the hardware threads
+        template <class Work>
+        void split(size_t count, size_t elementSize, Work work)
+        {
+            size_t bytes = count * elementSize;
+            size_t threads = BULK_THREADS ? BULK_THREADS : std::thread::hardware_concurrency();
+            threads = std::min<size_t>(threads ? threads : 1, bytes / (BULK_THREADING_THRESHOLD / 2));
+
+            if (bytes < BULK_THREADING_THRESHOLD || threads < 2)
+            {
+                work(0, count);
+                return;
+            }
+
+            // Whole cache lines per chunk, so with an aligned dst no line is shared
+            size_t lineElements = elementSize < 64 ? 64 / elementSize : 1;
+            size_t chunk = (count / threads + lineElements - 1) / lineElements * lineElements;
+
+            std::vector<std::thread> workers;
+            for (size_t begin = chunk; begin < count; begin += chunk)
+                workers.emplace_back(work, begin, std::min(count, begin + chunk));
+            work(0, std::min(count, chunk)); // the first chunk on the calling thread
+
+            for (std::thread &worker : workers)
+                worker.join();
+        }
+    } // namespace bulk_detail
+
+    /**
+     * Copies count elements from src to dst (the ranges must not overlap)
+     * Trivially copyable types: O(n) with streaming stores and threads for large ranges
+     */
+    template <class T>
+    void bulkCopy(T *dst, const T *src, size_t count)
+    {
+        if (!std::is_trivially_copyable<T>::value)
+        {
+            for (size_t i = 0; i < count; i++)
+                dst[i] = src[i];
+            return;
+        }
+
+        bulk_detail::adviseHugePages(dst, count * sizeof(T));
+        bulk_detail::split(count, sizeof(T), [=](size_t begin, size_t end)
+                           { bulk_detail::copyBytes(reinterpret_cast<char *>(dst + begin),
+                                                    reinterpret_cast<const char *>(src + begin),
+                                                    (end - begin) * sizeof(T)); });
+    }
+
+    /**
+     * Assigns value to count elements starting at dst
+     * Trivially copyable types: O(n) with streaming stores and threads for large ranges
+     */
+    template <class T>
+    void bulkFill(T *dst, size_t count, const T &value)
+    {
+        if (!std::is_trivially_copyable<T>::value)
+        {
+            for (size_t i = 0; i < count; i++)
+                dst[i] = value;
+            return;
+        }
+
+        const T copy = value; // value may live inside the range
+        bulk_detail::adviseHugePages(dst, count * sizeof(T));
+        bulk_detail::split(count, sizeof(T), [=, &copy](size_t begin, size_t end)
+                           { bulk_detail::fillElements(dst + begin, end - begin, copy); });
+    }
+} // namespace ds
+
+#endif // BULK_MEMORY_GUARD
@@ -0,0 +1,101 @@
+#define CATCH_CONFIG_MAIN
+#include "../Catch2/catch.hpp"
+
+// Small thresholds and several threads, so every path runs on small arrays
+#define BULK_STREAMING_THRESHOLD 256
+#define BULK_THREADING_THRESHOLD 4096
+#define BULK_THREADS 4
+#include "bulk_memory.hpp"
+#include "dynamic_array.hpp"
+
+#include <string>
+#include <vector>
+
+using namespace ds;
+
+struct Triple // 12 bytes - does not divide a vector register
+{
+    int a, b, c;
+    bool operator==(const Triple &other) const { return a == other.a && b == other.b && c == other.c; }
+};
+
+TEST_CASE("BULK COPY", "[COPY]")
+{
+    SECTION("SIZES AND ALIGNMENTS")
+    {
+        std::vector<char> src(100000), dst(100100);
+        for (size_t i = 0; i < src.size(); i++)
+            src[i] = (char)(i * 31 + 7);
+
+        for (size_t count : {0, 1, 100, 255, 256, 257, 5000, 99000})
+        {
+            for (size_t shift : {0, 1, 13, 31})
+            {
+                std::fill(dst.begin(), dst.end(), 0);
+                bulkCopy(dst.data() + shift, src.data() + 3, count);
+
+                REQUIRE(std::equal(src.begin() + 3, src.begin() + 3 + count, dst.begin() + shift));
+                REQUIRE(dst[shift + count] == 0); // nothing written past the end
+            }
+        }
+    }
+
+    SECTION("STRUCTS")
+    {
+        std::vector<Triple> src(10000), dst(10000);
+        for (int i = 0; i < 10000; i++)
+            src[i] = Triple{i, -i, i * i};
+
+        bulkCopy(dst.data(), src.data(), src.size());
+        REQUIRE(src == dst);
+    }
+
+    SECTION("NOT TRIVIALLY COPYABLE")
+    {
+        std::vector<std::string> src(1000, "a string too long for the small buffer"), dst(1000);
+        bulkCopy(dst.data(), src.data(), src.size());
+        REQUIRE(src == dst);
+    }
+}
+
+TEST_CASE("BULK FILL", "[FILL]")
+{
+    SECTION("ELEMENT SIZES")
+    {
+        std::vector<short> shorts(7777);
+        bulkFill(shorts.data() + 1, shorts.size() - 2, (short)-3);
+        REQUIRE(shorts.front() == 0);
+        REQUIRE(shorts.back() == 0);
+        REQUIRE(std::count(shorts.begin(), shorts.end(), (short)-3) == 7775);
+
+        std::vector<double> doubles(5000);
+        bulkFill(doubles.data() + 3, 4990, 2.5);
+        REQUIRE(std::count(doubles.begin(), doubles.end(), 2.5) == 4990);
+        REQUIRE(doubles[2] == 0);
+        REQUIRE(doubles[4993] == 0);
+
+        std::vector<Triple> triples(3000);
+        bulkFill(triples.data(), triples.size(), Triple{1, 2, 3});
+        REQUIRE(std::count(triples.begin(), triples.end(), Triple{1, 2, 3}) == 3000);
+    }
+
+    SECTION("VALUE INSIDE THE RANGE")
+    {
+        std::vector<int> values(10000, 0);
+        values[5000] = 42;
+        bulkFill(values.data(), values.size(), values[5000]);
+        REQUIRE(std::count(values.begin(), values.end(), 42) == 10000);
+    }
+}
+
+TEST_CASE("DYNAMIC ARRAY", "[COPY][FILL]")
+{
+    dynamic_array<long long> filled(20000, 7);
+    REQUIRE(filled[0] == 7);
+    REQUIRE(filled[19999] == 7);
+
+    filled[12345] = -1;
+    dynamic_array<long long> copy(filled);
+    REQUIRE(copy == filled);
+    REQUIRE(copy[12345] == -1);
+}
@@ -1,5 +1,6 @@
 #define CATCH_CONFIG_MAIN
 #include "../Catch2/catch.hpp"
+#include "../Common/catch_no_exceptions.hpp"
 #include "dynamic_array.hpp"
 
 using namespace ds;
@@ -229,3 +230,40 @@ TEST_CASE("ITERATOR", "[ITERATOR]")
         REQUIRE(EQUAL_FLAG);
     }
 }
+
+TEST_CASE("TRY API", "[NOEXCEPT]")
+{
+    SECTION("EMPTY")
+    {
+        dynamic_array<int> def;
+
+        REQUIRE(def.try_at(0).error() == Errc::out_of_range);
+        REQUIRE(def.try_front().error() == Errc::empty);
+        REQUIRE(def.try_back().error() == Errc::empty);
+        REQUIRE(def.try_pop_back().error() == Errc::empty);
+        REQUIRE(def.try_insert(0, 1).error() == Errc::invalid_argument);
+        REQUIRE(def.try_erase(0).error() == Errc::invalid_argument);
+    }
+
+    SECTION("SUCCESS")
+    {
+        dynamic_array<int> foo = {1, 2, 3};
+
+        REQUIRE(foo.try_at(1));
+        REQUIRE(*foo.try_at(1) == 2);
+        *foo.try_front() = 10;
+        REQUIRE(foo.front() == 10);
+        REQUIRE(foo.try_back().value() == 3);
+
+        REQUIRE(foo.try_insert(1, 5));
+        REQUIRE(foo.try_erase(0));
+        REQUIRE(foo.try_pop_back());
+        REQUIRE(foo.size() == 2);
+        REQUIRE(foo[0] == 5);
+        REQUIRE(foo[1] == 2);
+
+        const dynamic_array<int> &view = foo;
+        REQUIRE(view.try_at(2).error() == Errc::out_of_range);
+        REQUIRE(*view.try_back() == 2);
+    }
+}
@@ -9,6 +9,11 @@
 #include <iostream>         // Debugging
 #include <initializer_list> // C++ 11
 
+#include "bulk_memory.hpp"                // Large copies and fills
+#include "../Common/allocation_seal.hpp" // reserve/seal
+#include "../Common/expected.hpp"        // DS_THROW, try_* results
+#include "../Common/latency_histogram.hpp" // setLatencyRecorder
+
 namespace ds
 {
 
@@ -72,6 +77,38 @@ namespace ds
 
         void clear();
 
+        ///
+        // Non-throwing operations - report the failure as ds::Errc instead
+        Expected<T &> try_at(unsigned int index);
+        Expected<const T &> try_at(unsigned int index) const;
+
+        Expected<T &> try_front();
+        Expected<const T &> try_front() const;
+
+        Expected<T &> try_back();
+        Expected<const T &> try_back() const;
+
+        Expected<void> try_pop_back();
+
+        Expected<void> try_insert(unsigned int position, const T &val);
+
+        Expected<void> try_erase(unsigned int position);
+
+        ///
+        // Steady state (see Common/allocation_seal.hpp)
+
+        // Grow the buffer, so that new_capacity elements fit without allocating
+        void reserve(unsigned int new_capacity);
+
+        // Report every following allocation to the seal hook
+        void seal();
+        void unseal();
+        bool isSealed() const;
+
+        // Time push_back, pop_back, insert and erase into recorder
+        // (see Common/latency_histogram.hpp); nullptr turns it off
+        void setLatencyRecorder(LatencyRecorder *recorder);
+
         ///
         // Information methods
         unsigned int size() const;
@@ -193,11 +230,14 @@ namespace ds
     private:
         T *data;
         unsigned int m_size, m_capacity;
+        bool m_sealed = false;
+        LatencyRecorder *m_latency = nullptr;
 
         ///
         // Helpers
     private:
         void copyFrom(const dynamic_array<T> &src);
+        // The seal and the latency recorder stay with the object, they are not swapped
         friend void swap(dynamic_array &first, dynamic_array &second)
         {
             using std::swap;
@@ -206,6 +246,7 @@ namespace ds
             swap(first.m_size, second.m_size);         // Swaps m_size
         }
         void reserve_size();
+        void reallocate(unsigned int new_capacity);
     };
 
     /* one-definition rule (ODR) <=> inline */
@@ -216,7 +257,7 @@ namespace ds
         : m_capacity(m_capacity), m_size(0)
     {
         if (m_capacity == 0)
-            throw std::invalid_argument("Invalid initial m_capacity!");
+            DS_THROW(std::invalid_argument, "Invalid initial m_capacity!");
 
         data = new T[m_capacity];
     }
@@ -226,19 +267,18 @@ namespace ds
         : m_capacity(m_capacity), m_size(m_capacity)
     {
         if (m_capacity == 0)
-            throw std::invalid_argument("Invalid initial m_capacity!");
+            DS_THROW(std::invalid_argument, "Invalid initial m_capacity!");
 
         data = new T[m_capacity];
         // T::operator= might fail to copy and throw exception
-        try
+        DS_TRY
         {
-            for (unsigned int i = 0; i < m_size; i++)
-                data[i] = element;
+            bulkFill(data, m_size, element);
         }
-        catch (...)
+        DS_CATCH_ALL
         {
             std::cerr << "Invalid object copy operation!" << std::endl;
-            throw; // Rethrow the exception
+            DS_RETHROW; // Rethrow the exception
         }
     }
 
@@ -285,6 +325,7 @@ namespace ds
     template <class T>
     inline void dynamic_array<T>::push_back(const T &el)
     {
+        LatencyScope timer(m_latency, LatencyOp::push);
         if (m_size >= m_capacity)
         {
             reserve_size();
@@ -298,9 +339,10 @@ namespace ds
     template <class T>
     inline void dynamic_array<T>::insert(unsigned int position, const T &val)
     {
+        LatencyScope timer(m_latency, LatencyOp::insert);
         if (position >= m_size)
         {
-            throw std::invalid_argument("Invalid insert position!");
+            DS_THROW(std::invalid_argument, "Invalid insert position!");
         }
 
         this->push_back(val); // Guarantee enough capacity
@@ -316,9 +358,10 @@ namespace ds
     template <class T>
     inline void dynamic_array<T>::erase(unsigned int position)
     {
+        LatencyScope timer(m_latency, LatencyOp::erase);
         if (position >= m_size)
         {
-            throw std::invalid_argument("Invalid insert position!");
+            DS_THROW(std::invalid_argument, "Invalid insert position!");
         }
 
         for (size_t i = position; i < m_size - 1; i++)
@@ -332,8 +375,9 @@ namespace ds
     template <class T>
     inline void dynamic_array<T>::pop_back()
     {
+        LatencyScope timer(m_latency, LatencyOp::pop);
         if (m_size == 0)
-            throw std::logic_error("Invalid opration: Cannot pop from empty array!");
+            DS_THROW(std::logic_error, "Invalid opration: Cannot pop from empty array!");
 
         --m_size;
     }
@@ -356,10 +400,7 @@ namespace ds
     {
         m_capacity = src.m_capacity;
         data = new T[m_capacity]; // Might throw bad_alloc
-        for (unsigned int i = 0; i < src.m_size; i++)
-        {
-            data[i] = src.data[i];
-        }
+        bulkCopy(data, src.data, src.m_size);
 
         // Sets m_size after successfully assignment of the data
         m_size = src.m_size;
@@ -368,7 +409,16 @@ namespace ds
     template <class T>
     inline void dynamic_array<T>::reserve_size()
     {
-        unsigned int new_capacity = m_capacity ? m_capacity * GROWTH_RATE : INIT_CAPACITY;
+        reallocate(m_capacity ? m_capacity * GROWTH_RATE : INIT_CAPACITY);
+    }
+
+    // O(n) - Linear time
+    template <class T>
+    inline void dynamic_array<T>::reallocate(unsigned int new_capacity)
+    {
+        if (m_sealed)
+            detail::sealedAllocation("dynamic_array", new_capacity * sizeof(T));
+
         T *temp = new T[new_capacity];
 
         for (unsigned int i = 0; i < m_size; i++)
@@ -380,6 +430,40 @@ namespace ds
         m_capacity = new_capacity;
     }
 
+    // Steady state
+
+    // O(n) - Linear time, if the buffer grows
+    template <class T>
+    inline void dynamic_array<T>::reserve(unsigned int new_capacity)
+    {
+        if (new_capacity > m_capacity)
+            reallocate(new_capacity);
+    }
+
+    template <class T>
+    inline void dynamic_array<T>::seal()
+    {
+        m_sealed = true;
+    }
+
+    template <class T>
+    inline void dynamic_array<T>::unseal()
+    {
+        m_sealed = false;
+    }
+
+    template <class T>
+    inline bool dynamic_array<T>::isSealed() const
+    {
+        return m_sealed;
+    }
+
+    template <class T>
+    inline void dynamic_array<T>::setLatencyRecorder(LatencyRecorder *recorder)
+    {
+        m_latency = recorder;
+    }
+
     // Random access operations (operator [], front, back, at)
 
     // O(1) - Constant time
@@ -387,7 +471,7 @@ namespace ds
     inline const T &dynamic_array<T>::operator[](unsigned int index) const
     {
         if (index >= m_size)
-            throw std::out_of_range("Invalid index!");
+            DS_THROW(std::out_of_range, "Invalid index!");
 
         return data[index];
     }
@@ -397,7 +481,7 @@ namespace ds
     inline T &dynamic_array<T>::operator[](unsigned int index)
     {
         if (index >= m_size)
-            throw std::out_of_range("Invalid index!");
+            DS_THROW(std::out_of_range, "Invalid index!");
 
         return data[index];
     }
@@ -421,7 +505,7 @@ namespace ds
     inline T &dynamic_array<T>::front()
     {
         if (m_size == 0)
-            throw std::logic_error("Invalid opration: empty array!");
+            DS_THROW(std::logic_error, "Invalid opration: empty array!");
 
         return data[0];
     }
@@ -431,7 +515,7 @@ namespace ds
     inline const T &dynamic_array<T>::front() const
     {
         if (m_size == 0)
-            throw std::logic_error("Invalid opration: empty array!");
+            DS_THROW(std::logic_error, "Invalid opration: empty array!");
 
         return data[0];
     }
@@ -441,7 +525,7 @@ namespace ds
     inline T &dynamic_array<T>::back()
     {
         if (m_size == 0)
-            throw std::logic_error("Invalid opration: empty array!");
+            DS_THROW(std::logic_error, "Invalid opration: empty array!");
 
         return data[m_size - 1];
     }
@@ -451,11 +535,107 @@ namespace ds
     inline const T &dynamic_array<T>::back() const
     {
         if (m_size == 0)
-            throw std::logic_error("Invalid opration: empty array!");
+            DS_THROW(std::logic_error, "Invalid opration: empty array!");
 
         return data[m_size - 1];
     }
 
+    // Non-throwing operations
+
+    // O(1) - Constant time
+    template <class T>
+    inline Expected<T &> dynamic_array<T>::try_at(unsigned int index)
+    {
+        if (index >= m_size)
+            return Unexpected(Errc::out_of_range);
+
+        return data[index];
+    }
+
+    // O(1) - Constant time
+    template <class T>
+    inline Expected<const T &> dynamic_array<T>::try_at(unsigned int index) const
+    {
+        if (index >= m_size)
+            return Unexpected(Errc::out_of_range);
+
+        return data[index];
+    }
+
+    // O(1) - Constant time
+    template <class T>
+    inline Expected<T &> dynamic_array<T>::try_front()
+    {
+        if (m_size == 0)
+            return Unexpected(Errc::empty);
+
+        return data[0];
+    }
+
+    // O(1) - Constant time
+    template <class T>
+    inline Expected<const T &> dynamic_array<T>::try_front() const
+    {
+        if (m_size == 0)
+            return Unexpected(Errc::empty);
+
+        return data[0];
+    }
+
+    // O(1) - Constant time
+    template <class T>
+    inline Expected<T &> dynamic_array<T>::try_back()
+    {
+        if (m_size == 0)
+            return Unexpected(Errc::empty);
+
+        return data[m_size - 1];
+    }
+
+    // O(1) - Constant time
+    template <class T>
+    inline Expected<const T &> dynamic_array<T>::try_back() const
+    {
+        if (m_size == 0)
+            return Unexpected(Errc::empty);
+
+        return data[m_size - 1];
+    }
+
+    // O(1) - Constant time
+    template <class T>
+    inline Expected<void> dynamic_array<T>::try_pop_back()
+    {
+        LatencyScope timer(m_latency, LatencyOp::pop);
+        if (m_size == 0)
+            return Unexpected(Errc::empty);
+
+        --m_size;
+        return Expected<void>();
+    }
+
+    // O(n) - Linear time
+    template <class T>
+    inline Expected<void> dynamic_array<T>::try_insert(unsigned int position, const T &val)
+    {
+        if (position >= m_size)
+            return Unexpected(Errc::invalid_argument);
+
+        insert(position, val);
+        return Expected<void>();
+    }
+
+    // O(n) - Linear time
+    template <class T>
+    inline Expected<void> dynamic_array<T>::try_erase(unsigned int position)
+    {
+        if (position >= m_size)
+            return Unexpected(Errc::invalid_argument);
+
+        erase(position);
+        return Expected<void>();
+    }
+
     template <class T>
     inline bool dynamic_array<T>::operator==(const dynamic_array &other) const
     {
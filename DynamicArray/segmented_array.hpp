@@ -0,0 +1,556 @@
+#ifndef SEGMENTED_ARRAY_GUARD
+#define SEGMENTED_ARRAY_GUARD
+
+/*
+ *  Random access sequence container with the interface of dynamic_array
+ *  whose growth never moves the elements.
+ *
+ *  The elements are kept in segments of 16, 16, 32, 64, ... elements (each
+ *  new segment doubles the capacity). Growing allocates one more segment and
+ *  leaves the others alone, so push_back never copies the whole array and
+ *  references, pointers and iterators stay valid until the element is erased.
+ *  Element i lives in segment msb(i | 15) - 3, so random access is a bit scan
+ *  and two loads; the directory of segment pointers is a fixed array inside
+ *  the object.
+*/
+
+#include <iostream>         // Debugging
+#include <initializer_list> // C++ 11
+#include <stdexcept>
+#include <utility> // std::swap
+
+namespace ds
+{
+    template <class T>
+    class segmented_array
+    {
+    public:
+        // Constructors, Destructors; Gang of Four
+
+        // Default - Constructs an empty container with at least the selected capacity
+        explicit segmented_array(unsigned int m_capacity = FIRST_SEGMENT);
+
+        // Fill Constructor
+        explicit segmented_array(unsigned int m_size, const T &element);
+
+        // Constructs a container with a copy of each of the elements in il, in the same order.
+        segmented_array(const std::initializer_list<T> &i_list);
+
+        // Constructs a container with a copy of each of the elements and keep the original order
+        segmented_array(const segmented_array<T> &other);
+
+        // Copy assignment operator (copy-and-swap idiom)
+        segmented_array<T> &operator=(segmented_array<T> other);
+
+        // Destructor
+        ~segmented_array();
+
+        ///
+        // Basic Operations
+
+        // Add one element to the back
+        void push_back(const T &el);
+
+        // Insert an element
+        void insert(unsigned int position, const T &val);
+
+        // Access operators
+        const T &operator[](unsigned int index) const;
+        T &operator[](unsigned int index);
+
+        const T &at(unsigned int index) const;
+        T &at(unsigned int index);
+
+        // Access first element
+        const T &front() const;
+        T &front();
+
+        // Access last element
+        const T &back() const;
+        T &back();
+
+        ///
+        // Remove operations
+        void pop_back();
+
+        // Erease an element from selected position
+        void erase(unsigned int position);
+
+        void clear();
+
+        ///
+        // Information methods
+        unsigned int size() const;
+
+        unsigned int capacity() const;
+
+        bool empty() const;
+
+        // Number of allocated segments
+        unsigned int segments() const;
+
+        // Comparison operators
+        bool operator==(const segmented_array &other) const;
+
+        ///
+        // Iterator - walks a segment like a pointer, then jumps to the next one
+        class Iterator
+        {
+            friend class segmented_array;
+
+        public:
+            Iterator &operator++() // prefix
+            {
+                ++m_index;
+                if (++m_ptr == m_segment_end)
+                    locate();
+                return *this;
+            }
+
+            Iterator operator++(int) // postfix
+            {
+                Iterator copy(*this);
+                ++(*this);
+                return copy;
+            }
+
+            Iterator &operator--() // prefix
+            {
+                --m_index;
+                locate();
+                return *this;
+            }
+
+            Iterator operator--(int) // postfix
+            {
+                Iterator copy(*this);
+                --(*this);
+                return copy;
+            }
+
+            // Operator[] is consciously omitted
+
+            const T &operator*() const
+            {
+                return *m_ptr;
+            }
+
+            T &operator*()
+            {
+                return *m_ptr;
+            }
+
+            const T *operator->() const
+            {
+                return m_ptr;
+            }
+
+            T *operator->()
+            {
+                return m_ptr;
+            }
+
+            // Comparison operators
+            bool operator==(const Iterator &other) const
+            {
+                return this->m_index == other.m_index;
+            }
+
+            bool operator!=(const Iterator &other) const
+            {
+                return !(*this == other);
+            }
+
+            bool operator<(const Iterator &other) const
+            {
+                return m_index < other.m_index;
+            }
+
+            bool operator>(const Iterator &other) const
+            {
+                return other < *this;
+            }
+
+            bool operator>=(const Iterator &other) const
+            {
+                return !(*this < other);
+            }
+            bool operator<=(const Iterator &other) const
+            {
+                return !(*this > other);
+            }
+
+        private:
+            // Private ctor - Forbid user to create iterator
+            // The parent class is responsible for the above-mentioned action
+
+            Iterator(segmented_array *m_array, unsigned int m_index)
+                : m_array(m_array), m_index(m_index)
+            {
+                locate();
+            }
+
+            void locate()
+            {
+                if (m_index >= m_array->m_capacity)
+                {
+                    m_ptr = m_segment_end = nullptr; // past the last segment
+                    return;
+                }
+
+                unsigned int segment = segmentOf(m_index);
+                m_ptr = m_array->data[segment] + offsetOf(m_index);
+                m_segment_end = m_array->data[segment] + segmentSize(segment);
+            }
+
+            segmented_array *m_array;
+            unsigned int m_index;
+            T *m_ptr;
+            T *m_segment_end;
+        };
+
+        Iterator begin() { return Iterator(this, 0); }
+        Iterator end() { return Iterator(this, m_size); }
+
+        // Debug info methods
+    public:
+        void printInfo(std::ostream &os) const;
+
+    private:
+        static const unsigned int FIRST_SEGMENT_BITS = 4;
+        static const unsigned int FIRST_SEGMENT = 1u << FIRST_SEGMENT_BITS;
+        static const unsigned int MAX_SEGMENTS = 32 - FIRST_SEGMENT_BITS; // 2^31 elements
+
+        T *data[MAX_SEGMENTS]; // directory; segments beyond m_segments are unused
+        unsigned int m_segments;
+        unsigned int m_size, m_capacity;
+
+        ///
+        // Helpers
+    private:
+        // Segment 0 holds indices [0, 16), segment k > 0 holds [2^(k+3), 2^(k+4)):
+        // the segment is given by the highest set bit of index | 15 and the
+        // offset by the bits below it (all four low bits in segment 0)
+        static unsigned int segmentSize(unsigned int segment)
+        {
+            return FIRST_SEGMENT << (segment ? segment - 1 : 0);
+        }
+
+        static unsigned int highBit(unsigned int index)
+        {
+            return 31 - __builtin_clz(index | (FIRST_SEGMENT - 1));
+        }
+
+        static unsigned int segmentOf(unsigned int index)
+        {
+            return highBit(index) - (FIRST_SEGMENT_BITS - 1);
+        }
+
+        static unsigned int offsetOf(unsigned int index)
+        {
+            return index & (((1u << highBit(index)) - 1) | (FIRST_SEGMENT - 1));
+        }
+
+        T &element(unsigned int index) const
+        {
+            unsigned int segment = segmentOf(index);
+            return data[segment][offsetOf(index)];
+        }
+
+        void init();
+        void copyFrom(const segmented_array<T> &src);
+        friend void swap(segmented_array &first, segmented_array &second)
+        {
+            using std::swap;
+            swap(first.data, second.data);             // Swaps the directories
+            swap(first.m_segments, second.m_segments); // Swaps segment count
+            swap(first.m_capacity, second.m_capacity); // Swaps m_capacity
+            swap(first.m_size, second.m_size);         // Swaps m_size
+        }
+        void reserve_size();
+    };
+
+    /* one-definition rule (ODR) <=> inline */
+    /* new T <=> throws bad_alloc if allocation functions report failure to allocate storage.*/
+
+    template <class T>
+    inline segmented_array<T>::segmented_array(unsigned int m_capacity)
+    {
+        if (m_capacity == 0)
+            throw std::invalid_argument("Invalid initial m_capacity!");
+
+        init();
+        while (this->m_capacity < m_capacity)
+            reserve_size();
+    }
+
+    template <class T>
+    inline segmented_array<T>::segmented_array(unsigned int m_size, const T &element)
+        : segmented_array(m_size ? m_size : FIRST_SEGMENT)
+    {
+        for (unsigned int i = 0; i < m_size; i++)
+            push_back(element);
+    }
+
+    template <class T>
+    inline segmented_array<T>::segmented_array(const std::initializer_list<T> &i_list)
+        : segmented_array(i_list.size() ? i_list.size() : FIRST_SEGMENT)
+    {
+        for (const T &el : i_list)
+            push_back(el);
+    }
+
+    template <class T>
+    inline segmented_array<T>::segmented_array(const segmented_array<T> &other)
+    {
+        init();
+        this->copyFrom(other);
+    }
+
+    // Copy-And-Swap idiom, as in dynamic_array
+    template <class T>
+    inline segmented_array<T> &segmented_array<T>::operator=(segmented_array<T> other)
+    {
+        swap(*this, other);
+
+        return *this;
+    }
+
+    template <class T>
+    inline segmented_array<T>::~segmented_array()
+    {
+        this->clear();
+    }
+
+    // Default Segmented Array Operations
+
+    // Constant complexity O(1) - growth allocates one segment, nothing is copied
+    template <class T>
+    inline void segmented_array<T>::push_back(const T &el)
+    {
+        if (m_size >= m_capacity)
+        {
+            reserve_size();
+        }
+
+        element(m_size) = el;
+        ++m_size;
+    }
+
+    // O(n) - Linear time
+    template <class T>
+    inline void segmented_array<T>::insert(unsigned int position, const T &val)
+    {
+        if (position >= m_size)
+        {
+            throw std::invalid_argument("Invalid insert position!");
+        }
+
+        this->push_back(val); // Guarantee enough capacity
+        for (unsigned int i = m_size - 1; i > position; i--)
+        {
+            element(i) = element(i - 1);
+        }
+
+        element(position) = val;
+    }
+
+    // O(n) - Linear time
+    template <class T>
+    inline void segmented_array<T>::erase(unsigned int position)
+    {
+        if (position >= m_size)
+        {
+            throw std::invalid_argument("Invalid insert position!");
+        }
+
+        for (unsigned int i = position; i < m_size - 1; i++)
+        {
+            element(i) = element(i + 1);
+        }
+        --m_size;
+    }
+
+    // O(1) - Constant time
+    template <class T>
+    inline void segmented_array<T>::pop_back()
+    {
+        if (m_size == 0)
+            throw std::logic_error("Invalid opration: Cannot pop from empty array!");
+
+        --m_size;
+    }
+
+    // O(segments) - frees every segment
+    template <class T>
+    inline void segmented_array<T>::clear()
+    {
+        for (unsigned int i = 0; i < m_segments; i++)
+            delete[] data[i];
+
+        init();
+    }
+
+    // Helpers
+
+    template <class T>
+    inline void segmented_array<T>::init()
+    {
+        m_segments = 0;
+        m_size = 0;
+        m_capacity = 0;
+    }
+
+    // O(n) - Linear time
+    template <class T>
+    inline void segmented_array<T>::copyFrom(const segmented_array<T> &src)
+    {
+        while (m_capacity < src.m_capacity)
+            reserve_size(); // Might throw bad_alloc
+
+        for (unsigned int i = 0; i < src.m_size; i++)
+        {
+            element(i) = src.element(i);
+        }
+
+        // Sets m_size after successfully assignment of the data
+        m_size = src.m_size;
+    }
+
+    // O(1) - allocates the next segment, which doubles the capacity
+    template <class T>
+    inline void segmented_array<T>::reserve_size()
+    {
+        if (m_segments == MAX_SEGMENTS)
+            throw std::length_error("Invalid operation: segmented_array is full!");
+
+        data[m_segments] = new T[segmentSize(m_segments)];
+        m_capacity += segmentSize(m_segments);
+        ++m_segments;
+    }
+
+    // Random access operations (operator [], front, back, at)
+
+    // O(1) - Constant time
+    template <class T>
+    inline const T &segmented_array<T>::operator[](unsigned int index) const
+    {
+        if (index >= m_size)
+            throw std::out_of_range("Invalid index!");
+
+        return element(index);
+    }
+
+    // O(1) - Constant time
+    template <class T>
+    inline T &segmented_array<T>::operator[](unsigned int index)
+    {
+        if (index >= m_size)
+            throw std::out_of_range("Invalid index!");
+
+        return element(index);
+    }
+
+    // O(1) - Constant time
+    template <class T>
+    inline const T &segmented_array<T>::at(unsigned int index) const
+    {
+        return this->operator[](index);
+    }
+
+    // O(1) - Constant time
+    template <class T>
+    inline T &segmented_array<T>::at(unsigned int index)
+    {
+        return this->operator[](index);
+    }
+
+    // O(1) - Constant time
+    template <class T>
+    inline T &segmented_array<T>::front()
+    {
+        if (m_size == 0)
+            throw std::logic_error("Invalid opration: empty array!");
+
+        return data[0][0];
+    }
+
+    // O(1) - Constant time
+    template <class T>
+    inline const T &segmented_array<T>::front() const
+    {
+        if (m_size == 0)
+            throw std::logic_error("Invalid opration: empty array!");
+
+        return data[0][0];
+    }
+
+    // O(1) - Constant time
+    template <class T>
+    inline T &segmented_array<T>::back()
+    {
+        if (m_size == 0)
+            throw std::logic_error("Invalid opration: empty array!");
+
+        return element(m_size - 1);
+    }
+
+    // O(1) - Constant time
+    template <class T>
+    inline const T &segmented_array<T>::back() const
+    {
+        if (m_size == 0)
+            throw std::logic_error("Invalid opration: empty array!");
+
+        return element(m_size - 1);
+    }
+
+    template <class T>
+    inline bool segmented_array<T>::operator==(const segmented_array &other) const
+    {
+        if (this->m_size != other.m_size)
+            return false;
+
+        for (unsigned int i = 0; i < other.m_size; i++)
+        {
+            if (element(i) != other.element(i))
+                return false;
+        }
+
+        return true;
+    }
+
+    template <class T>
+    inline unsigned int segmented_array<T>::size() const
+    {
+        return m_size;
+    }
+
+    template <class T>
+    inline unsigned int segmented_array<T>::capacity() const
+    {
+        return m_capacity;
+    }
+
+    template <class T>
+    inline bool segmented_array<T>::empty() const
+    {
+        return m_size == 0;
+    }
+
+    template <class T>
+    inline unsigned int segmented_array<T>::segments() const
+    {
+        return m_segments;
+    }
+
+    // Debug Info
+    template <typename T>
+    inline void segmented_array<T>::printInfo(std::ostream &os) const
+    {
+        os << "Address: 0x" << this << "\nSegments: " << m_segments << "\nm_size: " << m_size << "\nm_capacity: " << m_capacity << std::endl;
+    }
+
+} // namespace ds
+
+#endif // SEGMENTED_ARRAY_GUARD
@@ -0,0 +1,81 @@
+// Growth latency of dynamic_array (copies the buffer on every doubling)
+// against segmented_array (allocates one more segment): total time, p99.9
+// and the slowest single push_back while filling 32M ints, then the price of
+// the segmented layout on sequential iteration and random access.
+//
+// g++ -std=c++17 -O2 segmented_array_bench.cpp -o segmented_array_bench
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "dynamic_array.hpp"
+#include "segmented_array.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+static const unsigned int N = 1u << 25;
+
+static long long checksum = 0;
+
+template <typename Array>
+static void fill(const char *name, Array &array)
+{
+    // Clock reads cost more than a push_back, so time batches of 64
+    std::vector<double> batches;
+    batches.reserve(N / 64);
+
+    auto start = Clock::now();
+    for (unsigned int i = 0; i < N; i += 64)
+    {
+        auto before = Clock::now();
+        for (unsigned int j = i; j < i + 64; j++)
+            array.push_back(j);
+        batches.push_back(std::chrono::duration<double, std::micro>(Clock::now() - before).count());
+    }
+    double total = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    std::sort(batches.begin(), batches.end());
+    std::cout << name << " fill: " << total << " ms, batch of 64 p99.9 "
+              << batches[batches.size() * 999 / 1000] << " us, max " << batches.back() << " us\n";
+}
+
+template <typename Array>
+static void scan(const char *name, Array &array, const std::vector<unsigned int> &indices)
+{
+    auto start = Clock::now();
+    for (auto el : array)
+        checksum += el;
+    double iterate = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / N;
+
+    start = Clock::now();
+    for (unsigned int index : indices)
+        checksum += array[index];
+    double random = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / indices.size();
+
+    std::cout << name << " iterate: " << iterate << " ns/element, random operator[]: " << random << " ns\n";
+}
+
+int main()
+{
+    std::mt19937 rng(1);
+    std::vector<unsigned int> indices(1 << 22);
+    for (unsigned int &index : indices)
+        index = rng() % N;
+
+    {
+        ds::dynamic_array<unsigned int> array;
+        fill("dynamic_array  ", array);
+        scan("dynamic_array  ", array, indices);
+    }
+    {
+        ds::segmented_array<unsigned int> array;
+        fill("segmented_array", array);
+        scan("segmented_array", array, indices);
+    }
+
+    std::cout << "(checksum " << checksum << ")\n";
+    return 0;
+}
@@ -0,0 +1,196 @@
+#define CATCH_CONFIG_MAIN
+#include "../Catch2/catch.hpp"
+#include "segmented_array.hpp"
+
+#include <string>
+#include <vector>
+
+using namespace ds;
+
+TEST_CASE("CONSTRUCTORS_DESTRUCTOR", "[CONSTRUCTOR][DESTRUCTOR]")
+{
+    SECTION("DEFAULT")
+    {
+        segmented_array<int> def;
+
+        REQUIRE(def.size() == 0);
+        REQUIRE(def.empty());
+        REQUIRE(def.capacity() == 16);
+        REQUIRE(def.segments() == 1);
+        REQUIRE_THROWS(def.at(0));
+    }
+
+    SECTION("CONSTRUCTOR WITH CAPACITY PARAMETER")
+    {
+        segmented_array<double> foo(100);
+
+        REQUIRE(foo.size() == 0);
+        REQUIRE(foo.capacity() == 128); // 16 + 16 + 32 + 64
+        REQUIRE(foo.segments() == 4);
+        REQUIRE_THROWS_AS(segmented_array<int>(0), std::invalid_argument);
+    }
+
+    SECTION("FILL CONSTRUCTOR")
+    {
+        const unsigned int SIZE = 40;
+        const double ELEMENT = 3.141592;
+
+        segmented_array<double> foo(SIZE, ELEMENT);
+
+        REQUIRE(foo.size() == SIZE);
+        for (unsigned int i = 0; i < SIZE; i++)
+            REQUIRE(foo.at(i) == ELEMENT);
+    }
+
+    SECTION("CONSTRUCTOR WITH IL")
+    {
+        segmented_array<char> foo = {'a', 'b', 'c'};
+
+        REQUIRE(foo.size() == 3);
+        REQUIRE((foo[0] == 'a' && foo[1] == 'b' && foo[2] == 'c'));
+    }
+
+    SECTION("COPY CONSTRUCTOR AND OPERATOR=")
+    {
+        segmented_array<std::string> foo;
+        for (int i = 0; i < 100; i++)
+            foo.push_back(std::to_string(i));
+
+        segmented_array<std::string> bar(foo);
+        segmented_array<std::string> baz;
+        baz = bar;
+
+        REQUIRE(bar == foo);
+        REQUIRE(baz == foo);
+        REQUIRE(baz.capacity() == foo.capacity());
+
+        bar[50] = "changed";
+        REQUIRE(foo[50] == "50");
+    }
+}
+
+TEST_CASE("DEFAULT OPERATIONS", "[OPERATIONS]")
+{
+    SECTION("RANDOM ACCESS ACROSS SEGMENTS")
+    {
+        segmented_array<unsigned int> foo;
+        for (unsigned int i = 0; i < 100000; i++)
+            foo.push_back(i * 7);
+
+        REQUIRE(foo.size() == 100000);
+        for (unsigned int i = 0; i < 100000; i++)
+            REQUIRE(foo[i] == i * 7);
+        REQUIRE_THROWS_AS(foo[100000], std::out_of_range);
+    }
+
+    SECTION("GROWTH KEEPS ELEMENTS IN PLACE")
+    {
+        segmented_array<int> foo;
+        std::vector<int *> addresses;
+        for (int i = 0; i < 5000; i++)
+        {
+            foo.push_back(i);
+            addresses.push_back(&foo.back());
+        }
+
+        for (int i = 0; i < 5000; i++)
+        {
+            REQUIRE(&foo[i] == addresses[i]);
+            REQUIRE(*addresses[i] == i);
+        }
+    }
+
+    SECTION("POP BACK, FRONT, BACK")
+    {
+        segmented_array<int> def;
+
+        def.push_back(1);
+        def.push_back(2);
+
+        REQUIRE(def.front() == 1);
+        REQUIRE(def.back() == 2);
+
+        REQUIRE_NOTHROW(def.pop_back());
+        CHECK(def.front() == def.back());
+        REQUIRE_NOTHROW(def.pop_back());
+
+        REQUIRE_THROWS(def.front());
+        REQUIRE_THROWS(def.back());
+        REQUIRE_THROWS(def.pop_back());
+    }
+
+    SECTION("INSERT")
+    {
+        segmented_array<int> foo;
+        for (int i = 0; i < 20; i++)
+            foo.push_back(i);
+
+        foo.insert(0, 56);
+        foo.insert(17, 57); // across the first segment boundary
+
+        REQUIRE(foo.size() == 22);
+        REQUIRE(foo[0] == 56);
+        REQUIRE(foo[16] == 15);
+        REQUIRE(foo[17] == 57);
+        REQUIRE(foo[18] == 16);
+        REQUIRE(foo.back() == 19);
+        REQUIRE_THROWS(foo.insert(foo.size(), 1));
+    }
+
+    SECTION("ERASE AND CLEAR")
+    {
+        segmented_array<int> foo = {1, 2, 3, 4, 5};
+        segmented_array<int> expect = {2, 3, 5};
+
+        foo.erase(0);
+        foo.erase(2);
+        REQUIRE(foo == expect);
+
+        foo.clear();
+        REQUIRE(foo.size() == 0);
+        REQUIRE(foo.capacity() == 0);
+        REQUIRE_THROWS(foo.at(0));
+
+        foo.push_back(9);
+        REQUIRE(foo.front() == 9);
+    }
+}
+
+TEST_CASE("ITERATOR", "[ITERATOR]")
+{
+    SECTION("RANGE-BASED-FOR")
+    {
+        segmented_array<int> vec;
+        for (int i = 0; i < 1000; i++)
+            vec.push_back(i);
+
+        int num = 0;
+        for (auto el : vec)
+            REQUIRE(el == num++);
+        REQUIRE(num == 1000);
+    }
+
+    SECTION("FULL LAST SEGMENT")
+    {
+        segmented_array<int> vec;
+        for (int i = 0; i < 32; i++) // exactly two segments
+            vec.push_back(i);
+
+        int count = 0;
+        for (auto it = vec.begin(); it != vec.end(); ++it)
+            ++count;
+        REQUIRE(count == 32);
+    }
+
+    SECTION("BACKWARDS")
+    {
+        segmented_array<int> vec;
+        for (int i = 0; i < 100; i++)
+            vec.push_back(i);
+
+        auto it = vec.end();
+        for (int i = 99; i >= 0; i--)
+            REQUIRE(*--it == i);
+        REQUIRE(it == vec.begin());
+    }
+}
@@ -0,0 +1,381 @@
+/**
+ * @file external_priority_queue.hpp
+ * @author Ivan Penev
+ * @brief Min-priority queue that spills to disk when it outgrows its memory
+ * @date 2026-10-18
+ *
+ * A simplified sequence heap. New elements go to an in-memory ds::BinaryHeap.
+ * When it is full, its contents are written out as one sorted run. The
+ * smallest element of the queue is either the top of the in-memory heap or
+ * the smallest head of the runs, which are merged lazily: only the current
+ * block of each run is in memory and the next one is read in the background.
+ *
+ * Every run costs two blocks of memory, so the number of runs R is bounded by
+ * the budget, which covers every allocation of the queue. The runs are merged in levels, like the buffers of a sequence
+ * heap: a spill is a run of level 0, and whenever k = max(2, R / 4) runs
+ * share a level, what is left of them is merged into one run of the next
+ * level. An element is therefore rewritten at most once per level, and N
+ * pushes cost O((N/B) * log_k(N/M)) block writes (M - elements in memory,
+ * B - elements per block), the bound of external sorting. Only if the levels
+ * outgrow R (k^(R/(k-1)) spills, or a very small budget) are all runs merged
+ * into one before the next spill. Consumed ranges of the spill file are given
+ * back to the file system (hole punching) and the file is emptied whenever no
+ * run is left, so disk usage follows the queue size.
+ *
+ *     ds::ExternalPriorityQueue<Job> jobs("/var/tmp", 512 << 20);
+ *     jobs.push(job);
+ *     Job next = jobs.top();
+ *     jobs.pop();
+ */
+
+#ifndef EXTERNAL_PRIORITY_QUEUE_HPP_GUARD_
+#define EXTERNAL_PRIORITY_QUEUE_HPP_GUARD_
+
+#include <cstdint>
+#include <memory>
+#include <stdexcept> // Exception handling
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>  // fallocate
+#include <stdlib.h> // mkstemp
+#include <unistd.h> // ftruncate, unlink, close
+
+#include "../Heap/binary_heap.hpp"
+#include "external_sort.hpp" // spill file readers and writers
+
+namespace ds
+{
+    /**
+     * @brief Priority queue of the smallest element (operator<) bounded in
+     * memory, the rest is kept in a temporary file
+     * @param DataType must be trivially copyable
+     */
+    template <typename DataType>
+    class ExternalPriorityQueue
+    {
+        static_assert(std::is_trivially_copyable<DataType>::value, "ExternalPriorityQueue: elements are stored as raw bytes");
+
+    private:
+        using Run = external_detail::Run;
+        using Reader = external_detail::RunReader<DataType>;
+        using Writer = external_detail::RunWriter<DataType>;
+
+        // The current element of a run
+        struct Head
+        {
+            DataType value;
+            size_t run;
+
+            bool operator<(const Head &other) const { return value < other.value; }
+        };
+
+    public:
+        /**
+         * @brief Creates an empty queue spilling to a temporary file in directory
+         *
+         * @param directory - where the temporary file is created
+         * @param memoryBudget - bytes; half for the in-memory heap, half for the
+         * run buffers and the block being written
+         * @param blockSize - bytes per read and write
+         * @throws std::invalid_argument when the budget does not fit ten blocks
+         * @throws std::runtime_error when the file cannot be created
+         */
+        ExternalPriorityQueue(const std::string &directory, size_t memoryBudget, size_t blockSize = 1 << 20)
+            : hot(BinaryHeap<DataType>::less), heads(BinaryHeap<Head>::less), merging(BinaryHeap<Head>::less),
+              spare(BinaryHeap<Head>::less)
+        {
+            blockElements = std::max<size_t>(1, blockSize / sizeof(DataType));
+            size_t blockBytes = blockElements * sizeof(DataType);
+            // A run takes two blocks and an entry in each heap of heads (see
+            // merge()), a spill or a merge writes through one more block
+            const size_t perRun = 2 * blockBytes + 3 * sizeof(Head);
+            const size_t runBudget = memoryBudget - memoryBudget / 2;
+            if (runBudget < blockBytes + 2 * perRun)
+            {
+                throw std::invalid_argument("ExternalPriorityQueue: The memory budget must fit ten blocks!");
+            }
+
+            hotCapacity = memoryBudget / 2 / sizeof(DataType);
+            maxRuns = (runBudget - blockBytes) / perRun;
+            fanout = std::max<size_t>(2, maxRuns / 4);
+
+            // Allocated whole - growing by doubling would hold 1.5 times as much
+            hot.reserve(hotCapacity);
+            heads.reserve(maxRuns);
+            merging.reserve(maxRuns);
+            spare.reserve(maxRuns);
+            runs.reserve(maxRuns);
+            readers.reserve(maxRuns);
+            levels.reserve(maxRuns);
+
+            std::string path = directory + "/ds-queue-XXXXXX";
+            fd = ::mkstemp(&path[0]);
+            if (fd < 0)
+                external_detail::fail("Cannot create a file in " + directory);
+            ::unlink(path.c_str());
+        }
+
+        ExternalPriorityQueue(const ExternalPriorityQueue &) = delete;
+        ExternalPriorityQueue &operator=(const ExternalPriorityQueue &) = delete;
+
+        ~ExternalPriorityQueue()
+        {
+            readers.clear(); // before the I/O thread and the file go away
+            ::close(fd);
+        }
+
+        /**
+         * @brief Inserts element into the queue
+         * @note Time complexity: amortized O(logM) plus O(1) block writes per
+         * block of elements, M - elements in memory
+         */
+        void push(const DataType &element)
+        {
+            if (hot.size() >= hotCapacity)
+                spill();
+
+            hot.push(element);
+            ++count;
+        }
+
+        /**
+         * @brief Accesses the smallest element
+         * @note Time complexity: O(1)
+         * @throws std::underflow_error - when the queue is empty
+         */
+        const DataType &top() const
+        {
+            if (count == 0)
+            {
+                throw std::underflow_error("ExternalPriorityQueue: Queue is empty!");
+            }
+
+            return fromHot() ? hot.top() : heads.top().value;
+        }
+
+        /**
+         * @brief Removes the smallest element
+         * @note Time complexity: O(log(M + runs)) plus amortized block reads
+         * @throws std::underflow_error - when the queue is empty
+         */
+        void pop()
+        {
+            if (count == 0)
+            {
+                throw std::underflow_error("ExternalPriorityQueue: Queue is empty!");
+            }
+
+            --count;
+            if (fromHot())
+            {
+                hot.pop();
+                return;
+            }
+
+            Head head = heads.top();
+            heads.pop();
+            if (readers[head.run]->next(head.value))
+                heads.push(head);
+            else
+                release(head.run);
+        }
+
+        /**
+         * @brief Returns the number of elements in the queue
+         */
+        uint64_t size() const { return count; }
+
+        /**
+         * @brief Checks if the queue is empty
+         */
+        bool isEmpty() const { return count == 0; }
+
+        /**
+         * @brief Returns the number of elements kept on disk
+         */
+        uint64_t spilledSize() const { return count - hot.size(); }
+
+        /**
+         * @brief Returns the number of runs the in-memory heap was written to
+         */
+        size_t spillCount() const { return spills; }
+
+        /**
+         * @brief Returns how many times runs were merged
+         */
+        size_t compactionCount() const { return compactions; }
+
+        /**
+         * @brief Returns the number of elements written to disk, by spills
+         * and merges
+         */
+        uint64_t writtenCount() const { return written; }
+
+        //
+        /* Helpers */
+    private:
+        bool fromHot() const
+        {
+            return heads.size() == 0 || (hot.size() > 0 && !(heads.top().value < hot.top()));
+        }
+
+        // Writes the in-memory heap out as a new sorted run of level 0, then
+        // merges every level which has reached fanout runs
+        void spill()
+        {
+            if (live == maxRuns)
+                merge([](unsigned) { return true; }, topLevel() + 1);
+
+            Writer writer(fd, end, blockElements);
+            written += hot.size();
+            while (hot.size() > 0)
+            {
+                writer.push(hot.top());
+                hot.pop();
+            }
+            open(writer.close(), 0);
+            ++spills;
+
+            for (unsigned level = 0; runsAt(level) >= fanout; level++)
+                merge([level](unsigned runLevel) { return runLevel == level; }, level + 1);
+        }
+
+        // Merges what is left of the runs whose level is selected into one
+        // run of the given level
+        template <typename Select>
+        void merge(Select selected, unsigned level)
+        {
+            // The heads of the merged runs move to a heap of their own, the
+            // others to the spare heap, which then takes the place of heads
+            while (heads.size() > 0)
+            {
+                if (selected(levels[heads.top().run]))
+                    merging.push(heads.top());
+                else
+                    spare.push(heads.top());
+                heads.pop();
+            }
+            std::swap(heads, spare);
+
+            Writer writer(fd, end, blockElements);
+            while (merging.size() > 0)
+            {
+                Head head = merging.top();
+                merging.pop();
+                writer.push(head.value);
+                ++written;
+
+                if (readers[head.run]->next(head.value))
+                    merging.push(head);
+            }
+
+            // Not release() - the file must not be truncated under the new run
+            Run merged = writer.close();
+            for (size_t i = 0; i < readers.size(); i++)
+            {
+                if (readers[i] && selected(levels[i]))
+                {
+                    readers[i].reset();
+                    punch(runs[i]);
+                    --live;
+                }
+            }
+
+            open(merged, level);
+            ++compactions;
+        }
+
+        void open(const Run &run, unsigned level)
+        {
+            // Reuses the slot of a released run
+            size_t index = 0;
+            while (index < readers.size() && readers[index])
+                ++index;
+            if (index == readers.size())
+            {
+                runs.emplace_back();
+                readers.emplace_back();
+                levels.push_back(0);
+            }
+
+            runs[index] = run;
+            readers[index].reset(new Reader(io, fd, run, blockElements));
+            levels[index] = level;
+            ++live;
+
+            DataType value;
+            if (readers[index]->next(value))
+                heads.push(Head{value, index});
+        }
+
+        size_t runsAt(unsigned level) const
+        {
+            size_t found = 0;
+            for (size_t i = 0; i < readers.size(); i++)
+                found += readers[i] && levels[i] == level;
+            return found;
+        }
+
+        unsigned topLevel() const
+        {
+            unsigned top = 0;
+            for (size_t i = 0; i < readers.size(); i++)
+                if (readers[i] && levels[i] > top)
+                    top = levels[i];
+            return top;
+        }
+
+        // Drops an exhausted (or compacted) run and frees its disk space
+        void release(size_t index)
+        {
+            readers[index].reset();
+            --live;
+
+            if (live == 0)
+            {
+                readers.clear();
+                runs.clear();
+                levels.clear();
+                end = 0;
+                if (::ftruncate(fd, 0) != 0)
+                    external_detail::fail("Truncate failed");
+                return;
+            }
+
+            punch(runs[index]);
+        }
+
+        void punch(const Run &run)
+        {
+#ifdef FALLOC_FL_PUNCH_HOLE
+            // Best effort - without it the space is reclaimed once the queue drains
+            ::fallocate(fd, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE, run.offset, run.count * sizeof(DataType));
+#else
+            (void)run;
+#endif
+        }
+
+        BinaryHeap<DataType> hot;
+        BinaryHeap<Head> heads;   // one per non-empty run
+        BinaryHeap<Head> merging; // the heads of the runs being merged
+        BinaryHeap<Head> spare;   // empty, reserved like heads
+        size_t hotCapacity, maxRuns, fanout, blockElements;
+
+        int fd;
+        off_t end = 0;
+        external_detail::IoThread io;
+        std::vector<Run> runs;                       // indexed like readers
+        std::vector<std::unique_ptr<Reader>> readers; // null when released
+        std::vector<unsigned> levels;                 // indexed like readers
+        size_t live = 0;
+
+        uint64_t count = 0;
+        size_t spills = 0, compactions = 0;
+        uint64_t written = 0;
+    };
+} // namespace ds
+
+#endif // EXTERNAL_PRIORITY_QUEUE_HPP_GUARD_
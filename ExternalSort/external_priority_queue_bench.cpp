@@ -0,0 +1,93 @@
+// Fills an ExternalPriorityQueue with ten times its memory budget of random
+// keys and drains it, then runs a scheduling-like mix (two pushes of later
+// deadlines per pop). The in-memory BinaryHeap is timed on the same
+// operations for reference.
+//
+// g++ -std=c++17 -O2 -pthread external_priority_queue_bench.cpp -o external_priority_queue_bench
+// ./external_priority_queue_bench [directory] [budget MB]
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+
+#include "../Heap/binary_heap.hpp"
+#include "external_priority_queue.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+static double nsPer(Clock::time_point since, size_t operations)
+{
+    return std::chrono::duration<double, std::nano>(Clock::now() - since).count() / operations;
+}
+
+// Returns ns per push and ns per pop for filling with n keys and draining
+template <typename Queue>
+std::pair<double, double> fillAndDrain(Queue &queue, size_t n)
+{
+    std::mt19937_64 rng(1);
+    auto start = Clock::now();
+    for (size_t i = 0; i < n; i++)
+        queue.push(rng());
+    double push = nsPer(start, n);
+
+    start = Clock::now();
+    uint64_t previous = 0;
+    while (queue.size() > 0)
+    {
+        if (queue.top() < previous)
+            std::cout << "NOT ORDERED" << std::endl;
+        previous = queue.top();
+        queue.pop();
+    }
+    return {push, nsPer(start, n)};
+}
+
+template <typename Queue>
+double scheduling(Queue &queue, size_t n)
+{
+    std::mt19937_64 rng(2);
+    uint64_t now = 0;
+    auto start = Clock::now();
+    for (size_t i = 0; i < n; i++)
+    {
+        queue.push(now + rng() % (1 << 30));
+        queue.push(now + rng() % (1 << 30));
+        now = queue.top();
+        queue.pop();
+    }
+    return nsPer(start, 3 * n);
+}
+
+int main(int argc, char **argv)
+{
+    const std::string directory = argc > 1 ? argv[1] : "/tmp";
+    const size_t budget = (argc > 2 ? std::atoi(argv[2]) : 32) << 20;
+    const size_t N = 10 * budget / sizeof(uint64_t);
+
+    {
+        ds::ExternalPriorityQueue<uint64_t> queue(directory, budget);
+        auto external = fillAndDrain(queue, N);
+        std::cout << "fill/drain " << N << " keys (" << N * 8 / 1e6 << " MB), budget " << (budget >> 20) << " MiB"
+                  << "\tExternalPriorityQueue push: " << external.first << " ns, pop: " << external.second << " ns"
+                  << "\t(spills: " << queue.spillCount() << ", compactions: " << queue.compactionCount() << ")" << std::endl;
+    }
+    {
+        ds::BinaryHeap<uint64_t> heap(ds::BinaryHeap<uint64_t>::less);
+        auto memory = fillAndDrain(heap, N);
+        std::cout << "\t\t\t\t\t\tBinaryHeap in memory push: " << memory.first << " ns, pop: " << memory.second << " ns" << std::endl;
+    }
+    {
+        ds::ExternalPriorityQueue<uint64_t> queue(directory, budget);
+        double external = scheduling(queue, N / 2);
+        ds::BinaryHeap<uint64_t> heap(ds::BinaryHeap<uint64_t>::less);
+        double memory = scheduling(heap, N / 2);
+        std::cout << "scheduling mix, " << N / 2 << " keys left"
+                  << "\tExternalPriorityQueue: " << external << " ns/op"
+                  << "\tBinaryHeap: " << memory << " ns/op"
+                  << "\t(spills: " << queue.spillCount() << ", compactions: " << queue.compactionCount() << ")" << std::endl;
+    }
+
+    return 0;
+}
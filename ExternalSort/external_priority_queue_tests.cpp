@@ -0,0 +1,189 @@
+#define CATCH_CONFIG_MAIN
+#include "../Catch2/catch.hpp"
+#include "external_priority_queue.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <new>
+#include <queue>
+#include <random>
+#include <vector>
+
+using namespace ds;
+
+static const std::string TEMP = std::filesystem::temp_directory_path().string();
+
+// Live and peak heap bytes of the program, to check the memory budget. Every
+// block carries its size in a 16 byte header (keeps malloc's alignment).
+static std::atomic<size_t> liveBytes{0}, peakBytes{0};
+
+static void *allocate(size_t size)
+{
+    char *block = static_cast<char *>(std::malloc(size + 16));
+    if (!block)
+        throw std::bad_alloc();
+    *reinterpret_cast<size_t *>(block) = size;
+
+    size_t live = liveBytes += size;
+    for (size_t peak = peakBytes; live > peak && !peakBytes.compare_exchange_weak(peak, live);)
+    {
+    }
+    return block + 16;
+}
+
+static void deallocate(void *ptr)
+{
+    if (!ptr)
+        return;
+    char *block = static_cast<char *>(ptr) - 16;
+    liveBytes -= *reinterpret_cast<size_t *>(block);
+    std::free(block);
+}
+
+void *operator new(size_t size) { return allocate(size); }
+void *operator new[](size_t size) { return allocate(size); }
+void operator delete(void *ptr) noexcept { deallocate(ptr); }
+void operator delete[](void *ptr) noexcept { deallocate(ptr); }
+void operator delete(void *ptr, size_t) noexcept { deallocate(ptr); }
+void operator delete[](void *ptr, size_t) noexcept { deallocate(ptr); }
+
+TEST_CASE("CONSTRUCTOR", "[DEFAULT]")
+{
+    REQUIRE_THROWS_AS(ExternalPriorityQueue<int>(TEMP, 4096, 1024), std::invalid_argument);
+    REQUIRE_THROWS_AS(ExternalPriorityQueue<int>("/nonexistent/directory", 1 << 20, 1024), std::runtime_error);
+
+    ExternalPriorityQueue<int> queue(TEMP, 1 << 20, 1024);
+    REQUIRE(queue.isEmpty());
+    REQUIRE_THROWS_AS(queue.top(), std::underflow_error);
+    REQUIRE_THROWS_AS(queue.pop(), std::underflow_error);
+}
+
+TEST_CASE("ABSTRACT OPERATIONS", "[PUSH][TOP][POP]")
+{
+    // 1024 elements in memory, at most 3 runs
+    ExternalPriorityQueue<uint32_t> queue(TEMP, 8 * 1024, 512);
+    std::mt19937 rng(3);
+
+    SECTION("IN MEMORY")
+    {
+        queue.push(5);
+        queue.push(1);
+        queue.push(3);
+
+        REQUIRE(queue.top() == 1);
+        queue.pop();
+        REQUIRE(queue.top() == 3);
+        REQUIRE(queue.size() == 2);
+        REQUIRE(queue.spillCount() == 0);
+    }
+
+    SECTION("SPILLS, COMPACTS AND DRAINS IN ORDER")
+    {
+        std::vector<uint32_t> input(20000);
+        for (uint32_t &x : input)
+            x = rng();
+
+        for (uint32_t x : input)
+            queue.push(x);
+        REQUIRE(queue.size() == input.size());
+        REQUIRE(queue.spilledSize() > 0);
+        REQUIRE(queue.spillCount() >= 19);
+        REQUIRE(queue.compactionCount() > 0);
+
+        std::sort(input.begin(), input.end());
+        for (uint32_t x : input)
+        {
+            REQUIRE(queue.top() == x);
+            queue.pop();
+        }
+        REQUIRE(queue.isEmpty());
+    }
+
+    SECTION("MERGES IN LEVELS")
+    {
+        // 1024 elements in memory, at most 16 runs, merged 4 at a time. About
+        // 400 spills: 5 levels, where merging every run into one at each
+        // overflow would write every element 13 times on average
+        ExternalPriorityQueue<uint32_t> wide(TEMP, 8 * 1024, 128);
+        const uint32_t N = 400000;
+        for (uint32_t i = 0; i < N; i++)
+            wide.push(rng());
+
+        double levels = std::log(double(wide.spillCount())) / std::log(4.0);
+        REQUIRE(wide.spillCount() >= 390);
+        REQUIRE(wide.writtenCount() <= uint64_t(N * (1 + std::ceil(levels))));
+
+        uint32_t last = 0;
+        for (uint32_t i = 0; i < N; i++)
+        {
+            REQUIRE(wide.top() >= last);
+            last = wide.top();
+            wide.pop();
+        }
+        REQUIRE(wide.isEmpty());
+    }
+
+    SECTION("MATCHES std::priority_queue UNDER MIXED OPERATIONS")
+    {
+        std::priority_queue<uint32_t, std::vector<uint32_t>, std::greater<uint32_t>> reference;
+        uint32_t clock = 0;
+
+        for (int i = 0; i < 100000; i++)
+        {
+            // Mostly growing with bursts of pops - like a scheduling backlog
+            if (reference.empty() || rng() % 3 != 0)
+            {
+                uint32_t x = clock + rng() % 100000;
+                queue.push(x);
+                reference.push(x);
+            }
+            else
+            {
+                REQUIRE(queue.top() == reference.top());
+                clock = reference.top();
+                queue.pop();
+                reference.pop();
+            }
+            REQUIRE(queue.size() == reference.size());
+        }
+
+        while (!reference.empty())
+        {
+            REQUIRE(queue.top() == reference.top());
+            queue.pop();
+            reference.pop();
+        }
+        REQUIRE(queue.isEmpty());
+    }
+}
+
+TEST_CASE("MEMORY BUDGET", "[PUSH][POP]")
+{
+    const size_t BUDGET = 66 * 1024;
+    std::mt19937_64 rng(9);
+
+    size_t before = liveBytes;
+    peakBytes = before;
+    {
+        // 4224 elements in memory, which doubling would grow to 8192, at most
+        // 15 runs, merged 3 at a time
+        ExternalPriorityQueue<uint64_t> queue(TEMP, BUDGET, 1024);
+        for (size_t i = 0; i < 400000; i++)
+            queue.push(rng());
+        REQUIRE(queue.compactionCount() > 0);
+
+        uint64_t last = 0;
+        while (!queue.isEmpty())
+        {
+            REQUIRE(queue.top() >= last);
+            last = queue.top();
+            queue.pop();
+        }
+    }
+
+    // The budget plus the bookkeeping: the I/O thread and the readers
+    REQUIRE(peakBytes - before <= BUDGET + 4 * 1024);
+}
@@ -0,0 +1,573 @@
+/**
+ * @file external_sort.hpp
+ * @author Ivan Penev
+ * @brief Streaming merge sort for inputs larger than the memory
+ * @date 2026-10-18
+ *
+ * Runs are generated by replacement selection on a ds::BinaryHeap: the heap
+ * holds as many elements as the memory budget allows, the smallest one is
+ * written out and replaced by the next input element. An element smaller than
+ * the last one written cannot join the current run and is tagged for the next
+ * one. On random input the runs are about twice the size of the heap, on
+ * already sorted input there is a single run.
+ *
+ * The runs are appended to one unlinked temporary file in large blocks. They
+ * are merged with a k-way merge whose fan-in is limited by the budget (each
+ * run needs two blocks); while one block of a run is consumed, the next one is
+ * read by a background thread. When there are too many runs, groups of them
+ * are merged into longer runs first.
+ *
+ *     ds::ExternalSorter<uint64_t> sorter("/tmp", 256 << 20);
+ *     for (...) sorter.push(x);
+ *     sorter.finish();
+ *     for (uint64_t x; sorter.next(x);) ...
+ */
+
+#ifndef EXTERNAL_SORT_HPP_GUARD_
+#define EXTERNAL_SORT_HPP_GUARD_
+
+#include <algorithm> // std::min, std::max
+#include <cerrno>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <stdexcept> // Exception handling
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <stdlib.h> // mkstemp
+#include <unistd.h> // pread, pwrite, unlink, close
+
+#include "../Heap/binary_heap.hpp"
+
+namespace ds
+{
+    namespace external_detail
+    {
+        inline void fail(const std::string &what)
+        {
+            throw std::runtime_error("ExternalSorter: " + what + ": " + std::strerror(errno));
+        }
+
+        inline void writeAll(int fd, const void *data, size_t size, off_t offset)
+        {
+            const char *bytes = static_cast<const char *>(data);
+            while (size > 0)
+            {
+                ssize_t written = ::pwrite(fd, bytes, size, offset);
+                if (written < 0)
+                {
+                    if (errno == EINTR)
+                        continue;
+                    fail("Write failed");
+                }
+                bytes += written;
+                size -= written;
+                offset += written;
+            }
+        }
+
+        inline ssize_t readAll(int fd, void *data, size_t size, off_t offset)
+        {
+            char *bytes = static_cast<char *>(data);
+            size_t done = 0;
+            while (done < size)
+            {
+                ssize_t got = ::pread(fd, bytes + done, size - done, offset + done);
+                if (got < 0 && errno == EINTR)
+                    continue;
+                if (got < 0)
+                    return -1;
+                if (got == 0)
+                    break;
+                done += got;
+            }
+            return done;
+        }
+
+        /**
+         * @brief A read issued to the I/O thread
+         */
+        struct ReadRequest
+        {
+            int fd;
+            void *buffer;
+            size_t size;
+            off_t offset;
+
+            ssize_t result = 0;
+            int error = 0;
+            bool done = true;
+        };
+
+        /**
+         * @brief One background thread serving reads in FIFO order
+         */
+        class IoThread
+        {
+        public:
+            IoThread() : worker([this]
+                                { run(); }) {}
+
+            ~IoThread()
+            {
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    stopping = true;
+                }
+                wake.notify_all();
+                worker.join();
+            }
+
+            void submit(ReadRequest &request)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    request.done = false;
+                    queue.push_back(&request);
+                }
+                wake.notify_all();
+            }
+
+            void wait(ReadRequest &request)
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                finished.wait(lock, [&request]
+                              { return request.done; });
+            }
+
+        private:
+            void run()
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                for (;;)
+                {
+                    wake.wait(lock, [this]
+                              { return stopping || !queue.empty(); });
+                    if (queue.empty())
+                        return;
+
+                    ReadRequest *request = queue.front();
+                    queue.pop_front();
+                    lock.unlock();
+
+                    ssize_t got = readAll(request->fd, request->buffer, request->size, request->offset);
+                    int error = got < 0 ? errno : 0;
+
+                    lock.lock();
+                    request->result = got;
+                    request->error = error;
+                    request->done = true;
+                    finished.notify_all();
+                }
+            }
+
+            std::mutex mutex;
+            std::condition_variable wake, finished;
+            std::deque<ReadRequest *> queue;
+            bool stopping = false;
+            std::thread worker; // last - started after the rest is ready
+        };
+
+        /**
+         * @brief A sorted run: a range of elements in the spill file
+         */
+        struct Run
+        {
+            off_t offset;
+            uint64_t count;
+        };
+
+        /**
+         * @brief Reads a run block by block with the next block in flight
+         */
+        template <typename T>
+        class RunReader
+        {
+        public:
+            RunReader(IoThread &io, int fd, const Run &run, size_t blockElements)
+                : io(io), fd(fd), offset(run.offset), left(run.count)
+            {
+                buffers[0].resize(blockElements);
+                buffers[1].resize(blockElements);
+                request(0);
+                flip();
+            }
+
+            RunReader(const RunReader &) = delete;
+            RunReader &operator=(const RunReader &) = delete;
+
+            ~RunReader()
+            {
+                io.wait(pending); // the I/O thread may still write into a buffer
+            }
+
+            /**
+             * @brief Takes the next element of the run
+             * @return false when the run is exhausted
+             */
+            bool next(T &value)
+            {
+                if (position == available)
+                {
+                    if (available == 0)
+                        return false;
+                    flip();
+                    if (available == 0)
+                        return false;
+                }
+
+                value = buffers[current][position++];
+                return true;
+            }
+
+        private:
+            void request(int buffer)
+            {
+                size_t elements = std::min<uint64_t>(left, buffers[buffer].size());
+                pending.fd = fd;
+                pending.buffer = buffers[buffer].data();
+                pending.size = elements * sizeof(T);
+                pending.offset = offset;
+
+                offset += pending.size;
+                left -= elements;
+                io.submit(pending);
+            }
+
+            // Switches to the block in flight and requests the following one
+            void flip()
+            {
+                io.wait(pending);
+                if (pending.result < 0 || (size_t)pending.result != pending.size)
+                {
+                    errno = pending.error;
+                    fail("Read failed");
+                }
+
+                current = pending.buffer == buffers[0].data() ? 0 : 1;
+                available = pending.size / sizeof(T);
+                position = 0;
+
+                if (left > 0)
+                    request(1 - current);
+                else
+                    pending.size = pending.result = 0; // the next flip yields an empty block
+            }
+
+            IoThread &io;
+            const int fd;
+            off_t offset;  // of the next block to request
+            uint64_t left; // elements not requested yet
+
+            std::vector<T> buffers[2];
+            int current = 0;
+            size_t position = 0, available = 0;
+            ReadRequest pending;
+        };
+
+        /**
+         * @brief Appends a run to the spill file in whole blocks
+         */
+        template <typename T>
+        class RunWriter
+        {
+        public:
+            RunWriter(int fd, off_t &end, size_t blockElements)
+                : fd(fd), end(end), start(end)
+            {
+                buffer.reserve(blockElements);
+            }
+
+            void push(const T &value)
+            {
+                buffer.push_back(value);
+                if (buffer.size() == buffer.capacity())
+                    flush();
+            }
+
+            Run close()
+            {
+                flush();
+                return Run{start, (uint64_t)(end - start) / sizeof(T)};
+            }
+
+        private:
+            void flush()
+            {
+                writeAll(fd, buffer.data(), buffer.size() * sizeof(T), end);
+                end += buffer.size() * sizeof(T);
+                buffer.clear();
+            }
+
+            const int fd;
+            off_t &end;
+            const off_t start;
+            std::vector<T> buffer;
+        };
+    } // namespace external_detail
+
+    /**
+     * @brief Sorts a stream of elements in ascending order (operator<) using
+     * a bounded amount of memory and a temporary file
+     * @param DataType must be trivially copyable
+     */
+    template <typename DataType>
+    class ExternalSorter
+    {
+        static_assert(std::is_trivially_copyable<DataType>::value, "ExternalSorter: elements are stored as raw bytes");
+
+    private:
+        using Run = external_detail::Run;
+        using Reader = external_detail::RunReader<DataType>;
+        using Writer = external_detail::RunWriter<DataType>;
+
+        // Heap entry of the run generation - ordered by run first
+        struct Pending
+        {
+            uint64_t run;
+            DataType value;
+
+            bool operator<(const Pending &other) const
+            {
+                return run < other.run || (run == other.run && value < other.value);
+            }
+        };
+
+        // Heap entry of the merge - the current element of a run
+        struct Head
+        {
+            DataType value;
+            size_t reader;
+
+            bool operator<(const Head &other) const
+            {
+                return value < other.value || (!(other.value < value) && reader < other.reader);
+            }
+        };
+
+    public:
+        /**
+         * @brief Creates a sorter spilling to a temporary file in directory
+         *
+         * @param directory - where the temporary file is created
+         * @param memoryBudget - bytes for the selection heap, later for the merge
+         * buffers; the allocations of the sorter stay within it
+         * @param blockSize - bytes per read and write
+         * @throws std::invalid_argument when the budget does not fit a two-way
+         * merge (five blocks)
+         * @throws std::runtime_error when the file cannot be created
+         */
+        ExternalSorter(const std::string &directory, size_t memoryBudget, size_t blockSize = 1 << 20)
+            : selection(BinaryHeap<Pending>::less), merge(BinaryHeap<Head>::less)
+        {
+            blockElements = std::max<size_t>(1, blockSize / sizeof(DataType));
+            size_t blockBytes = blockElements * sizeof(DataType);
+            // A merge input takes two blocks and a heap entry, the output one block
+            const size_t perRun = 2 * blockBytes + sizeof(Head);
+            if (memoryBudget < blockBytes + 2 * perRun)
+            {
+                throw std::invalid_argument("ExternalSorter: The memory budget must fit five blocks!");
+            }
+
+            // The run writer takes one block of the budget. The heap is
+            // allocated whole - growing by doubling would hold 1.5 times it.
+            heapCapacity = (memoryBudget - blockBytes) / sizeof(Pending);
+            fanIn = (memoryBudget - blockBytes) / perRun;
+            selection.reserve(heapCapacity);
+
+            std::string path = directory + "/ds-sort-XXXXXX";
+            fd = ::mkstemp(&path[0]);
+            if (fd < 0)
+                external_detail::fail("Cannot create a file in " + directory);
+            ::unlink(path.c_str()); // removed with the last descriptor
+        }
+
+        ExternalSorter(const ExternalSorter &) = delete;
+        ExternalSorter &operator=(const ExternalSorter &) = delete;
+
+        ~ExternalSorter()
+        {
+            readers.clear(); // before the I/O thread and the file go away
+            ::close(fd);
+        }
+
+        /**
+         * @brief Adds an element
+         * @note Time complexity: amortized O(logM), M - elements in memory
+         * @throws std::logic_error after finish()
+         */
+        void push(const DataType &value)
+        {
+            if (finished)
+            {
+                throw std::logic_error("ExternalSorter: Push after finish!");
+            }
+
+            ++count;
+            if (selection.size() < heapCapacity)
+            {
+                selection.push(Pending{0, value});
+                return;
+            }
+
+            Pending smallest = selection.top();
+            selection.pop();
+            emit(smallest);
+
+            // Smaller than what was just written - it has to wait for the next run
+            selection.push(Pending{value < smallest.value ? smallest.run + 1 : smallest.run, value});
+        }
+
+        /**
+         * @brief Ends the input. Merges the runs until at most fanIn are left.
+         */
+        void finish()
+        {
+            if (finished)
+                return;
+            finished = true;
+
+            if (!writer)
+                return; // everything fits in memory - next() pops the heap
+
+            while (!selection.isEmpty())
+            {
+                emit(selection.top());
+                selection.pop();
+            }
+            runs.push_back(writer->close());
+            writer.reset();
+
+            // The merge buffers take the place of the heap in the budget
+            selection = BinaryHeap<Pending>(BinaryHeap<Pending>::less);
+            merge.reserve(fanIn);
+
+            while (runs.size() > fanIn)
+            {
+                std::vector<Run> group(runs.begin(), runs.begin() + fanIn);
+                runs.erase(runs.begin(), runs.begin() + fanIn);
+
+                startMerge(group);
+                Writer merged(fd, end, blockElements);
+                for (DataType value; pop(value);)
+                    merged.push(value);
+                runs.push_back(merged.close());
+                ++passes;
+            }
+
+            startMerge(runs);
+        }
+
+        /**
+         * @brief Takes the next element in ascending order
+         * @note Time complexity: O(log(runs)) plus amortized block I/O
+         * @throws std::logic_error before finish()
+         * @return false when every element was taken
+         */
+        bool next(DataType &value)
+        {
+            if (!finished)
+            {
+                throw std::logic_error("ExternalSorter: Call finish first!");
+            }
+
+            if (runs.empty())
+            {
+                if (selection.isEmpty())
+                    return false;
+                value = selection.top().value;
+                selection.pop();
+                return true;
+            }
+
+            return pop(value);
+        }
+
+        /**
+         * @brief Returns the number of pushed elements
+         */
+        uint64_t size() const { return count; }
+
+        /**
+         * @brief Returns the number of runs written by replacement selection
+         */
+        size_t runCount() const { return generated; }
+
+        /**
+         * @brief Returns the number of intermediate merges
+         */
+        size_t mergePasses() const { return passes; }
+
+        //
+        /* Helpers */
+    private:
+        // Writes the smallest element to the run it belongs to
+        void emit(const Pending &entry)
+        {
+            if (!writer || entry.run != currentRun)
+            {
+                if (writer)
+                {
+                    runs.push_back(writer->close());
+                    writer.reset(); // its block is reused by the next writer
+                }
+                writer.reset(new Writer(fd, end, blockElements));
+                currentRun = entry.run;
+                ++generated;
+            }
+            writer->push(entry.value);
+        }
+
+        void startMerge(const std::vector<Run> &group)
+        {
+            readers.clear();
+            for (const Run &run : group)
+            {
+                readers.emplace_back(new Reader(io, fd, run, blockElements));
+
+                DataType value;
+                if (readers.back()->next(value))
+                    merge.push(Head{value, readers.size() - 1});
+            }
+        }
+
+        bool pop(DataType &value)
+        {
+            if (merge.size() == 0)
+                return false;
+
+            Head head = merge.top();
+            merge.pop();
+            value = head.value;
+
+            if (readers[head.reader]->next(head.value))
+                merge.push(head);
+            return true;
+        }
+
+        BinaryHeap<Pending> selection;
+        BinaryHeap<Head> merge;
+        size_t heapCapacity, fanIn, blockElements;
+
+        int fd;
+        off_t end = 0; // of the spill file
+        std::vector<Run> runs;
+
+        external_detail::IoThread io;
+        std::vector<std::unique_ptr<Reader>> readers;
+        std::unique_ptr<Writer> writer;
+        uint64_t currentRun = 0;
+
+        uint64_t count = 0;
+        size_t generated = 0, passes = 0;
+        bool finished = false;
+    };
+} // namespace ds
+
+#endif // EXTERNAL_SORT_HPP_GUARD_
@@ -0,0 +1,72 @@
+// Sorts an input ten times larger than the memory budget and reports the
+// throughput of the run generation and of the merge, the number of runs and
+// the intermediate merge passes. std::sort of the same data in memory is
+// printed for reference.
+//
+// g++ -std=c++17 -O2 -pthread external_sort_bench.cpp -o external_sort_bench
+// ./external_sort_bench [directory] [budget MB]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "external_sort.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+static double seconds(Clock::time_point since)
+{
+    return std::chrono::duration<double>(Clock::now() - since).count();
+}
+
+int main(int argc, char **argv)
+{
+    const std::string directory = argc > 1 ? argv[1] : "/tmp";
+    const size_t budget = (argc > 2 ? std::atoi(argv[2]) : 32) << 20;
+    const size_t N = 10 * budget / sizeof(uint64_t);
+    const double MB = N * sizeof(uint64_t) / 1e6;
+
+    for (size_t block : {64 << 10, 1 << 20})
+    {
+        ds::ExternalSorter<uint64_t> sorter(directory, budget, block);
+        std::mt19937_64 rng(1);
+
+        auto start = Clock::now();
+        for (size_t i = 0; i < N; i++)
+            sorter.push(rng());
+        double generate = seconds(start);
+
+        start = Clock::now();
+        sorter.finish();
+        uint64_t previous = 0, checksum = 0;
+        bool sorted = true;
+        for (uint64_t x; sorter.next(x);)
+        {
+            sorted &= previous <= x;
+            previous = x;
+            checksum += x;
+        }
+        double merge = seconds(start);
+
+        std::cout << "block " << (block >> 10) << " KiB, " << MB << " MB input, budget " << (budget >> 20) << " MiB"
+                  << "\truns: " << sorter.runCount() << "\tpasses: " << sorter.mergePasses()
+                  << "\trun generation: " << MB / generate << " MB/s"
+                  << "\tmerge: " << MB / merge << " MB/s"
+                  << "\ttotal: " << MB / (generate + merge) << " MB/s"
+                  << (sorted ? "" : "\tNOT SORTED") << " (" << checksum % 1000 << ")" << std::endl;
+    }
+
+    std::vector<uint64_t> data(N);
+    std::mt19937_64 rng(1);
+    for (uint64_t &x : data)
+        x = rng();
+    auto start = Clock::now();
+    std::sort(data.begin(), data.end());
+    std::cout << "std::sort in memory: " << MB / seconds(start) << " MB/s" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,202 @@
+#define CATCH_CONFIG_MAIN
+#include "../Catch2/catch.hpp"
+#include "external_sort.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <filesystem>
+#include <new>
+#include <random>
+#include <vector>
+
+using namespace ds;
+
+static const std::string TEMP = std::filesystem::temp_directory_path().string();
+
+// Live and peak heap bytes of the program, to check the memory budget. Every
+// block carries its size in a 16 byte header (keeps malloc's alignment).
+static std::atomic<size_t> liveBytes{0}, peakBytes{0};
+
+static void *allocate(size_t size)
+{
+    char *block = static_cast<char *>(std::malloc(size + 16));
+    if (!block)
+        throw std::bad_alloc();
+    *reinterpret_cast<size_t *>(block) = size;
+
+    size_t live = liveBytes += size;
+    for (size_t peak = peakBytes; live > peak && !peakBytes.compare_exchange_weak(peak, live);)
+    {
+    }
+    return block + 16;
+}
+
+static void deallocate(void *ptr)
+{
+    if (!ptr)
+        return;
+    char *block = static_cast<char *>(ptr) - 16;
+    liveBytes -= *reinterpret_cast<size_t *>(block);
+    std::free(block);
+}
+
+void *operator new(size_t size) { return allocate(size); }
+void *operator new[](size_t size) { return allocate(size); }
+void operator delete(void *ptr) noexcept { deallocate(ptr); }
+void operator delete[](void *ptr) noexcept { deallocate(ptr); }
+void operator delete(void *ptr, size_t) noexcept { deallocate(ptr); }
+void operator delete[](void *ptr, size_t) noexcept { deallocate(ptr); }
+
+// Pushes everything, finishes and collects the output
+template <typename T>
+std::vector<T> sortAll(ExternalSorter<T> &sorter, const std::vector<T> &input)
+{
+    for (const T &value : input)
+        sorter.push(value);
+    sorter.finish();
+
+    std::vector<T> output;
+    for (T value; sorter.next(value);)
+        output.push_back(value);
+    return output;
+}
+
+TEST_CASE("CONSTRUCTOR", "[DEFAULT]")
+{
+    REQUIRE_THROWS_AS(ExternalSorter<int>(TEMP, 1000, 1024), std::invalid_argument);
+    REQUIRE_THROWS_AS(ExternalSorter<int>("/nonexistent/directory", 1 << 20, 1024), std::runtime_error);
+
+    ExternalSorter<int> sorter(TEMP, 1 << 20, 1024);
+    REQUIRE(sorter.size() == 0);
+
+    int value;
+    REQUIRE_THROWS_AS(sorter.next(value), std::logic_error);
+    sorter.finish();
+    REQUIRE_FALSE(sorter.next(value));
+    REQUIRE_THROWS_AS(sorter.push(1), std::logic_error);
+}
+
+TEST_CASE("SORTING", "[PUSH][NEXT]")
+{
+    std::mt19937_64 rng(5);
+
+    SECTION("FITS IN MEMORY - NOTHING IS SPILLED")
+    {
+        std::vector<uint64_t> input(1000);
+        for (uint64_t &x : input)
+            x = rng();
+
+        ExternalSorter<uint64_t> sorter(TEMP, 1 << 20, 4096);
+        std::vector<uint64_t> output = sortAll(sorter, input);
+
+        std::sort(input.begin(), input.end());
+        REQUIRE(output == input);
+        REQUIRE(sorter.runCount() == 0);
+    }
+
+    SECTION("RUNS ARE ABOUT TWICE THE MEMORY")
+    {
+        std::vector<uint64_t> input(200000);
+        for (uint64_t &x : input)
+            x = rng();
+
+        // ~4000 entries in the heap, 7 runs can be merged at once
+        ExternalSorter<uint64_t> sorter(TEMP, 64 * 1024, 4096);
+        std::vector<uint64_t> output = sortAll(sorter, input);
+
+        std::sort(input.begin(), input.end());
+        REQUIRE(output == input);
+        REQUIRE(sorter.size() == input.size());
+
+        // 200000 / (2 * ~4000) ~ 25 runs
+        REQUIRE(sorter.runCount() >= 20);
+        REQUIRE(sorter.runCount() <= 30);
+        REQUIRE(sorter.mergePasses() > 0);
+    }
+
+    SECTION("SORTED INPUT IS A SINGLE RUN")
+    {
+        std::vector<uint64_t> input(100000);
+        for (size_t i = 0; i < input.size(); i++)
+            input[i] = i;
+
+        ExternalSorter<uint64_t> sorter(TEMP, 64 * 1024, 4096);
+        REQUIRE(sortAll(sorter, input) == input);
+        REQUIRE(sorter.runCount() == 1);
+        REQUIRE(sorter.mergePasses() == 0);
+    }
+
+    SECTION("DUPLICATES AND A RUN SHORTER THAN A BLOCK")
+    {
+        std::vector<int> input;
+        for (int i = 0; i < 50000; i++)
+            input.push_back((int)(rng() % 100) - 50);
+
+        ExternalSorter<int> sorter(TEMP, 32 * 1024, 1000);
+        std::vector<int> output = sortAll(sorter, input);
+
+        std::sort(input.begin(), input.end());
+        REQUIRE(output == input);
+    }
+}
+
+struct Record
+{
+    uint32_t key;
+    uint32_t payload;
+
+    bool operator<(const Record &other) const { return key < other.key; }
+};
+
+TEST_CASE("MEMORY BUDGET", "[PUSH][NEXT]")
+{
+    const size_t BUDGET = 64 * 1024;
+    std::mt19937_64 rng(9);
+    std::vector<uint64_t> input(300000);
+    for (uint64_t &x : input)
+        x = rng();
+
+    size_t before = liveBytes;
+    peakBytes = before;
+    {
+        ExternalSorter<uint64_t> sorter(TEMP, BUDGET, 4096);
+        for (uint64_t x : input)
+            sorter.push(x);
+        sorter.finish();
+
+        uint64_t last = 0, value;
+        size_t taken = 0;
+        for (; sorter.next(value); taken++)
+        {
+            REQUIRE(value >= last);
+            last = value;
+        }
+        REQUIRE(taken == input.size());
+        REQUIRE(sorter.mergePasses() > 0);
+    }
+
+    // The budget plus the bookkeeping: the I/O thread, readers and the run list
+    REQUIRE(peakBytes - before <= BUDGET + 4 * 1024);
+}
+
+TEST_CASE("RECORDS", "[PUSH][NEXT]")
+{
+    std::mt19937 rng(11);
+    std::vector<Record> input(30000);
+    for (uint32_t i = 0; i < input.size(); i++)
+        input[i] = Record{(uint32_t)(rng() % 1000), i};
+
+    ExternalSorter<Record> sorter(TEMP, 16 * 1024, 1024);
+    std::vector<Record> output = sortAll(sorter, input);
+
+    REQUIRE(output.size() == input.size());
+    uint64_t payloads = 0;
+    for (size_t i = 0; i < output.size(); i++)
+    {
+        if (i > 0)
+            REQUIRE_FALSE(output[i] < output[i - 1]);
+        payloads += output[i].payload;
+    }
+    REQUIRE(payloads == (uint64_t)input.size() * (input.size() - 1) / 2);
+}
@@ -0,0 +1,247 @@
+/**
+ * @file cuckoo_filter.hpp
+ * @author Ivan Penev
+ * @brief Cuckoo filter - approximate set which supports deletion
+ * @date 2026-10-18
+ *
+ * Stores a short fingerprint of every key in one of two candidate buckets of
+ * four slots. The second bucket is computed from the first one and the
+ * fingerprint alone (partial-key cuckoo hashing), so a fingerprint can be
+ * moved to its other bucket without knowing the key. A lookup reads two
+ * buckets; removing a key removes one copy of its fingerprint.
+ *
+ * The false positive rate is about 8 / 2^bits for bits-wide fingerprints:
+ * ~3% for uint8_t, ~0.012% for uint16_t. Insertion fails once the table is
+ * around 95% full.
+ */
+
+#ifndef CUCKOO_FILTER_HPP_GUARD_
+#define CUCKOO_FILTER_HPP_GUARD_
+
+#include <cstdint>
+#include <stdexcept> // Exception handling
+#include <type_traits>
+#include <utility> // std::swap
+#include <vector>
+
+#include "filter_hash.hpp"
+
+namespace ds
+{
+    template <typename DataType, typename Fingerprint = uint16_t>
+    class CuckooFilter
+    {
+        static_assert(std::is_unsigned<Fingerprint>::value, "CuckooFilter: Fingerprint must be an unsigned integer");
+
+    private:
+        static const size_t SLOTS = 4;
+        static const int MAX_KICKS = 500;
+
+        struct Bucket
+        {
+            Fingerprint slot[SLOTS]; // 0 - empty
+        };
+
+        std::vector<Bucket> buckets; // power of two
+        size_t mask;
+        size_t count = 0;
+
+        // A fingerprint evicted by a failed insertion is kept here, so no
+        // inserted key is ever lost
+        Fingerprint victim = 0;
+        size_t victimBucket = 0;
+
+    public:
+        static const bool DELETABLE = true;
+
+        /**
+         * @brief Constructs an empty filter
+         *
+         * @param capacity - number of keys the filter must hold; the table is
+         * sized for at most 90% load
+         */
+        explicit CuckooFilter(size_t capacity)
+        {
+            size_t n = 1;
+            while (n * SLOTS * 9 < capacity * 10)
+                n <<= 1;
+
+            buckets.assign(n, Bucket{});
+            mask = n - 1;
+        }
+
+        /**
+         * @brief Adds a key. Adding a key twice stores two fingerprints.
+         * @note Time complexity: O(1) amortized
+         * @return false when the filter is full; the filter is unchanged
+         */
+        bool insert(const DataType &key)
+        {
+            if (victim)
+                return false;
+
+            Fingerprint fp;
+            size_t i1, i2;
+            locate(key, fp, i1, i2);
+
+            if (place(i1, fp) || place(i2, fp))
+            {
+                ++count;
+                return true;
+            }
+
+            // Evict fingerprints to their other buckets until one finds room
+            size_t i = (fp & 1) ? i1 : i2;
+            for (int kick = 0; kick < MAX_KICKS; kick++)
+            {
+                Fingerprint &slot = buckets[i].slot[kick % SLOTS];
+                std::swap(fp, slot);
+                i = alternate(i, fp);
+                if (place(i, fp))
+                {
+                    ++count;
+                    return true;
+                }
+            }
+
+            // The key is in, but one other fingerprint is homeless
+            victim = fp;
+            victimBucket = i;
+            ++count;
+            return true;
+        }
+
+        /**
+         * @brief Checks whether the key may have been added
+         * @note Time complexity: O(1), two buckets
+         * @return false if the key is certainly not in the filter
+         */
+        bool mayContain(const DataType &key) const
+        {
+            Fingerprint fp;
+            size_t i1, i2;
+            locate(key, fp, i1, i2);
+
+            return has(i1, fp) || has(i2, fp) ||
+                   (victim == fp && (victimBucket == i1 || victimBucket == i2));
+        }
+
+        /**
+         * @brief Removes one copy of the key's fingerprint. Only keys which
+         * were inserted may be removed, otherwise another key could be lost.
+         * @note Time complexity: O(1)
+         * @return false if no matching fingerprint was found
+         */
+        bool remove(const DataType &key)
+        {
+            Fingerprint fp;
+            size_t i1, i2;
+            locate(key, fp, i1, i2);
+
+            if (victim == fp && (victimBucket == i1 || victimBucket == i2))
+            {
+                victim = 0;
+            }
+            else if (!erase(i1, fp) && !erase(i2, fp))
+            {
+                return false;
+            }
+            --count;
+
+            // Room was made - try to give the homeless fingerprint a place
+            if (victim)
+            {
+                Fingerprint homeless = victim;
+                size_t i = victimBucket;
+                victim = 0;
+                if (!place(i, homeless) && !place(alternate(i, homeless), homeless))
+                {
+                    victim = homeless;
+                    victimBucket = i;
+                }
+            }
+            return true;
+        }
+
+        /**
+         * @brief Removes every key
+         */
+        void clear()
+        {
+            buckets.assign(buckets.size(), Bucket{});
+            count = 0;
+            victim = 0;
+        }
+
+        /**
+         * @brief Returns the number of stored fingerprints
+         */
+        size_t size() const { return count; }
+
+        /**
+         * @brief Returns the fraction of the slots in use
+         */
+        double loadFactor() const { return (double)count / (buckets.size() * SLOTS); }
+
+        /**
+         * @brief Returns the memory used by the table
+         */
+        size_t bytes() const { return buckets.size() * sizeof(Bucket); }
+
+        //
+        /* Helpers */
+    private:
+        void locate(const DataType &key, Fingerprint &fp, size_t &i1, size_t &i2) const
+        {
+            uint64_t h = filterHash(key);
+
+            // Taken from the high bits, never 0 - 0 marks an empty slot
+            fp = (Fingerprint)(h >> (64 - 8 * sizeof(Fingerprint)));
+            if (fp == 0)
+                fp = 1;
+
+            i1 = (size_t)h & mask;
+            i2 = alternate(i1, fp);
+        }
+
+        // The other bucket of fp; applying it twice gives back i
+        size_t alternate(size_t i, Fingerprint fp) const
+        {
+            return (i ^ (size_t)(fp * 0x5bd1e995u)) & mask;
+        }
+
+        bool place(size_t i, Fingerprint fp)
+        {
+            for (Fingerprint &slot : buckets[i].slot)
+            {
+                if (slot == 0)
+                {
+                    slot = fp;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        bool has(size_t i, Fingerprint fp) const
+        {
+            const Fingerprint *slot = buckets[i].slot;
+            return (slot[0] == fp) | (slot[1] == fp) | (slot[2] == fp) | (slot[3] == fp);
+        }
+
+        bool erase(size_t i, Fingerprint fp)
+        {
+            for (Fingerprint &slot : buckets[i].slot)
+            {
+                if (slot == fp)
+                {
+                    slot = 0;
+                    return true;
+                }
+            }
+            return false;
+        }
+    };
+} // namespace ds
+
+#endif // CUCKOO_FILTER_HPP_GUARD_
@@ -0,0 +1,34 @@
+/**
+ * @file filter_hash.hpp
+ * @author Ivan Penev
+ * @brief Hashing shared by the approximate membership filters
+ * @date 2026-10-18
+ */
+
+#ifndef FILTER_HASH_HPP_GUARD_
+#define FILTER_HASH_HPP_GUARD_
+
+#include <cstdint>
+#include <functional> // std::hash
+
+namespace ds
+{
+    /**
+     * @brief 64-bit hash of a key. std::hash is the identity for integers on
+     * common implementations, so its result goes through the murmur3 finalizer
+     * to spread every input bit over the whole word.
+     */
+    template <typename DataType>
+    inline uint64_t filterHash(const DataType &key)
+    {
+        uint64_t h = std::hash<DataType>()(key);
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdull;
+        h ^= h >> 33;
+        h *= 0xc4ceb9fe1a85ec53ull;
+        h ^= h >> 33;
+        return h;
+    }
+} // namespace ds
+
+#endif // FILTER_HASH_HPP_GUARD_
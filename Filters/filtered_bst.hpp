@@ -0,0 +1,176 @@
+/**
+ * @file filtered_bst.hpp
+ * @author Ivan Penev
+ * @brief BST with an approximate membership filter in front of contains()
+ * @date 2026-10-18
+ *
+ * A lookup of an absent key walks the whole depth of a BST. The filter answers
+ * most of these from a single cache line: when it says "no" the tree is not
+ * touched. Keys it lets through are looked up in the tree as usual, so the
+ * answers are exact. Counters report how many walks were avoided and how many
+ * were wasted on false positives.
+ *
+ *     ds::FilteredBST<int, ds::CuckooFilter<int>> set(1000000);
+ *     ds::FilteredBST<int, ds::BlockedBloomFilter<int>> set(1000000, 0.01);
+ *
+ * The constructor arguments are passed to the filter. A Bloom filter cannot
+ * forget removed keys; they keep passing it until rebuildFilter().
+ */
+
+#ifndef FILTERED_BST_HPP_GUARD_
+#define FILTERED_BST_HPP_GUARD_
+
+#include <cstddef>
+#include <stdexcept> // Exception handling
+#include <utility>   // std::forward
+
+#include "../BinarySerachTree/BST.hpp"
+#include "blocked_bloom_filter.hpp"
+#include "cuckoo_filter.hpp"
+
+namespace ds
+{
+    template <typename DataType, typename Filter = BlockedBloomFilter<DataType>>
+    class FilteredBST
+    {
+    private:
+        BST<DataType> tree;
+        Filter filter;
+        size_t count = 0;
+        bool filterComplete = true; // false after a failed rebuild - lookups walk the tree
+
+        size_t lookups = 0, avoided = 0, falsePositives = 0;
+
+    public:
+        /**
+         * @brief Constructs an empty set
+         * @param filterArguments - passed to the filter constructor
+         */
+        template <typename... Arguments>
+        explicit FilteredBST(Arguments &&...filterArguments)
+            : filter(std::forward<Arguments>(filterArguments)...) {}
+
+        /**
+         * @brief Inserts an element
+         * @note Time complexity: O(h)
+         * @throws std::logic_error if the element is already in the set
+         * @throws std::length_error if the filter is full
+         */
+        void insert(const DataType &data)
+        {
+            tree.insert(data);
+            if (filterComplete && !addToFilter(data))
+            {
+                tree.remove(data);
+                throw std::length_error("FilteredBST: The filter is full!");
+            }
+            ++count;
+        }
+
+        /**
+         * @brief Removes an element
+         * @note Time complexity: O(h)
+         * @throws std::logic_error if the element is not in the set
+         */
+        void remove(const DataType &data)
+        {
+            if (!tree.contains(data))
+            {
+                throw std::logic_error("FilteredBST: The element is not in the set!");
+            }
+
+            tree.remove(data);
+            if constexpr (Filter::DELETABLE)
+                if (filterComplete)
+                    filter.remove(data);
+            --count;
+        }
+
+        /**
+         * @brief Checks whether the element is in the set
+         * @note Time complexity: O(1) when the filter rejects it, O(h) otherwise
+         */
+        bool contains(const DataType &data)
+        {
+            ++lookups;
+            if (filterComplete && !filter.mayContain(data))
+            {
+                ++avoided;
+                return false;
+            }
+
+            bool found = tree.contains(data);
+            falsePositives += !found;
+            return found;
+        }
+
+        /**
+         * @brief Rebuilds the filter from the elements of the tree, dropping
+         * the keys a Bloom filter still remembers after remove()
+         * @note Time complexity: O(N)
+         * @throws std::length_error if the filter cannot hold all elements (a
+         * nearly full cuckoo filter may fail in another insertion order); the
+         * set stays exact, contains() walks the tree until a rebuild succeeds
+         */
+        void rebuildFilter()
+        {
+            filter.clear();
+            bool complete = true;
+            tree.inorder([this, &complete](const DataType &value)
+                         { complete = complete && addToFilter(value); });
+
+            filterComplete = complete;
+            if (!complete)
+            {
+                filter.clear();
+                throw std::length_error("FilteredBST: The filter is full!");
+            }
+        }
+
+        /**
+         * @brief Returns the number of elements
+         */
+        size_t size() const { return count; }
+
+        /**
+         * @brief Checks if the set is empty
+         */
+        bool isEmpty() const { return count == 0; }
+
+        /**
+         * @brief Returns the number of contains() calls
+         */
+        size_t lookupCount() const { return lookups; }
+
+        /**
+         * @brief Returns the number of tree walks the filter avoided
+         */
+        size_t avoidedWalks() const { return avoided; }
+
+        /**
+         * @brief Returns the number of tree walks for keys which were not there
+         */
+        size_t falsePositiveCount() const { return falsePositives; }
+
+        /**
+         * @brief Resets the counters
+         */
+        void resetCounters() { lookups = avoided = falsePositives = 0; }
+
+        const Filter &membershipFilter() const { return filter; }
+
+        //
+        /* Helpers */
+    private:
+        bool addToFilter(const DataType &data)
+        {
+            if constexpr (Filter::DELETABLE)
+                return filter.insert(data);
+
+            filter.insert(data);
+            return true;
+        }
+    };
+} // namespace ds
+
+#endif // FILTERED_BST_HPP_GUARD_
@@ -0,0 +1,88 @@
+// BST::contains with mostly absent keys, with and without a filter in front
+// of it. The set holds 1M random keys; 90% of the lookups miss.
+//
+// g++ -std=c++17 -O2 -march=native filters_bench.cpp -o filters_bench
+// (without AVX2 the Bloom filter probes its block with a scalar loop)
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "filtered_bst.hpp"
+
+template <typename Lookup>
+double nsPerLookup(const std::vector<int> &keys, Lookup lookup, size_t &found)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (int key : keys)
+        found += lookup(key);
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / keys.size();
+}
+
+template <typename Set>
+void report(const std::string &name, Set &set, const std::vector<int> &lookups, size_t elements)
+{
+    size_t found = 0;
+    double ns = nsPerLookup(lookups, [&set](int key)
+                            { return set.contains(key); }, found);
+    std::cout << name << ":\t" << ns << " ns/lookup"
+              << "\tavoided walks: " << set.avoidedWalks()
+              << "\tfalse positives: " << set.falsePositiveCount()
+              << "\tfilter: " << 8.0 * set.membershipFilter().bytes() / elements << " bits/key"
+              << "\t(found " << found << ")" << std::endl;
+}
+
+int main()
+{
+    const size_t N = 1000000, LOOKUPS = 5000000;
+    std::mt19937 rng(3);
+
+    std::unordered_set<int> unique;
+    std::vector<int> keys;
+    while (keys.size() < N)
+    {
+        int key = rng() & 0x7fffffff;
+        if (unique.insert(key).second)
+            keys.push_back(key);
+    }
+
+    std::vector<int> lookups(LOOKUPS);
+    for (int &key : lookups)
+        key = rng() % 10 == 0 ? keys[rng() % N] : (int)(rng() & 0x7fffffff);
+
+    {
+        ds::BST<int> bst;
+        for (int key : keys)
+            bst.insert(key);
+        size_t found = 0;
+        double ns = nsPerLookup(lookups, [&bst](int key)
+                                { return bst.contains(key); }, found);
+        std::cout << "BST:\t\t\t" << ns << " ns/lookup\t(found " << found << ")" << std::endl;
+    }
+
+    for (double rate : {0.01, 0.001})
+    {
+        ds::FilteredBST<int, ds::BlockedBloomFilter<int>> set(N, rate);
+        for (int key : keys)
+            set.insert(key);
+        report("Bloom " + std::to_string(rate).substr(0, 5), set, lookups, N);
+    }
+    {
+        ds::FilteredBST<int, ds::CuckooFilter<int, uint8_t>> set(N);
+        for (int key : keys)
+            set.insert(key);
+        report("Cuckoo 8-bit", set, lookups, N);
+    }
+    {
+        ds::FilteredBST<int, ds::CuckooFilter<int, uint16_t>> set(N);
+        for (int key : keys)
+            set.insert(key);
+        report("Cuckoo 16-bit", set, lookups, N);
+    }
+
+    return 0;
+}
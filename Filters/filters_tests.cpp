@@ -0,0 +1,236 @@
+#define CATCH_CONFIG_MAIN
+#include "../Catch2/catch.hpp"
+#include "filtered_bst.hpp"
+
+#include <random>
+#include <set>
+#include <vector>
+
+using namespace ds;
+
+// Fraction of n keys never inserted (odd numbers) the filter lets through
+template <typename Filter>
+double measuredRate(const Filter &filter, int n)
+{
+    int passed = 0;
+    for (int i = 0; i < n; i++)
+        passed += filter.mayContain(2 * i + 1);
+    return (double)passed / n;
+}
+
+TEST_CASE("BLOCKED BLOOM FILTER", "[FILTER]")
+{
+    const int N = 100000;
+
+    for (double rate : {0.1, 0.01, 0.001})
+    {
+        BlockedBloomFilter<int> filter(N, rate);
+        for (int i = 0; i < N; i++)
+            filter.insert(2 * i);
+
+        for (int i = 0; i < N; i++)
+            REQUIRE(filter.mayContain(2 * i));
+
+        double measured = measuredRate(filter, N);
+        REQUIRE(measured < rate * 1.5);
+        REQUIRE(measured > rate * 0.3); // sized for the rate, not far more bits
+    }
+
+    BlockedBloomFilter<int> filter(10);
+    filter.insert(42);
+    REQUIRE(filter.mayContain(42));
+    filter.clear();
+    REQUIRE_FALSE(filter.mayContain(42));
+
+    REQUIRE_THROWS_AS(BlockedBloomFilter<int>(10, 0), std::invalid_argument);
+    REQUIRE_THROWS_AS(BlockedBloomFilter<int>(10, 1), std::invalid_argument);
+}
+
+TEST_CASE("CUCKOO FILTER", "[FILTER]")
+{
+    const int N = 100000;
+    CuckooFilter<int> filter(N);
+
+    SECTION("NO FALSE NEGATIVES, FEW FALSE POSITIVES")
+    {
+        for (int i = 0; i < N; i++)
+            REQUIRE(filter.insert(2 * i));
+        REQUIRE(filter.size() == N);
+
+        for (int i = 0; i < N; i++)
+            REQUIRE(filter.mayContain(2 * i));
+        REQUIRE(measuredRate(filter, N) < 0.001);
+    }
+
+    SECTION("REMOVE")
+    {
+        for (int i = 0; i < N; i++)
+            filter.insert(2 * i);
+        for (int i = 0; i < N; i += 2)
+            REQUIRE(filter.remove(2 * i));
+
+        for (int i = 1; i < N; i += 2)
+            REQUIRE(filter.mayContain(2 * i));
+
+        int stillPassing = 0;
+        for (int i = 0; i < N; i += 2)
+            stillPassing += filter.mayContain(2 * i);
+        REQUIRE(stillPassing < N / 1000);
+        REQUIRE(filter.size() == N / 2);
+    }
+
+    SECTION("FULL")
+    {
+        CuckooFilter<int, uint8_t> small(100); // 32 buckets, 128 slots
+        int inserted = 0;
+        while (small.insert(inserted))
+            ++inserted;
+
+        REQUIRE(small.loadFactor() > 0.8);
+        for (int i = 0; i < inserted; i++)
+            REQUIRE(small.mayContain(i));
+
+        // Removing makes room again
+        for (int i = 0; i < inserted; i += 2)
+            REQUIRE(small.remove(i));
+        REQUIRE(small.insert(0));
+        for (int i = 1; i < inserted; i += 2)
+            REQUIRE(small.mayContain(i));
+    }
+}
+
+template <typename Filter>
+void checkFilteredBST(FilteredBST<int, Filter> &set)
+{
+    std::mt19937 rng(29);
+    std::set<int> expected;
+
+    for (int i = 0; i < 20000; i++)
+    {
+        int key = rng() % 1000000;
+        if (expected.insert(key).second)
+            set.insert(key);
+    }
+    REQUIRE_THROWS_AS(set.insert(*expected.begin()), std::logic_error);
+
+    // Mostly absent keys
+    for (int i = 0; i < 100000; i++)
+    {
+        int key = rng() % 1000000;
+        REQUIRE(set.contains(key) == (expected.count(key) == 1));
+    }
+    REQUIRE(set.lookupCount() == 100000);
+    REQUIRE(set.avoidedWalks() > 90000);
+    REQUIRE(set.falsePositiveCount() < 2000);
+
+    // Removed keys are reported absent
+    std::vector<int> removed(expected.begin(), expected.end());
+    removed.resize(5000);
+    for (int key : removed)
+    {
+        set.remove(key);
+        expected.erase(key);
+    }
+    REQUIRE_THROWS_AS(set.remove(removed.front()), std::logic_error);
+    for (int key : removed)
+        REQUIRE_FALSE(set.contains(key));
+    for (int key : expected)
+        REQUIRE(set.contains(key));
+    REQUIRE(set.size() == expected.size());
+}
+
+TEST_CASE("FILTERED BST", "[CONTAINS][COUNTERS]")
+{
+    SECTION("BLOOM")
+    {
+        FilteredBST<int, BlockedBloomFilter<int>> set(20000, 0.01);
+        checkFilteredBST(set);
+
+        // The Bloom filter still remembers the removed keys until it is rebuilt
+        set.resetCounters();
+        std::mt19937 rng(31);
+        for (int i = 0; i < 1000; i++)
+            set.contains(rng() % 1000000);
+        size_t before = set.falsePositiveCount();
+
+        set.rebuildFilter();
+        set.resetCounters();
+        rng.seed(31);
+        for (int i = 0; i < 1000; i++)
+            set.contains(rng() % 1000000);
+        REQUIRE(set.falsePositiveCount() <= before);
+    }
+
+    SECTION("CUCKOO")
+    {
+        FilteredBST<int, CuckooFilter<int>> set(20000);
+        checkFilteredBST(set);
+    }
+
+    SECTION("FULL FILTER")
+    {
+        FilteredBST<int, CuckooFilter<int, uint8_t>> set(10);
+        REQUIRE_THROWS_AS([&set]
+                          { for (int i = 0;; i++) set.insert(i); }(),
+                          std::length_error);
+
+        // The rejected element was taken back out of the tree
+        REQUIRE(set.size() > 0);
+        for (int i = 0; i < (int)set.size(); i++)
+            REQUIRE(set.contains(i));
+        REQUIRE_FALSE(set.contains((int)set.size()));
+    }
+
+    SECTION("REBUILD OF A FULL FILTER")
+    {
+        // Refilled in sorted order, a nearly full cuckoo filter may not fit
+        // the keys it held; the set must stay exact either way
+        bool failed = false;
+        for (int seed = 0; seed < 50; seed++)
+        {
+            FilteredBST<int, CuckooFilter<int, uint8_t>> set(100);
+            std::mt19937 rng(seed);
+            std::set<int> expected;
+            try
+            {
+                for (;;)
+                {
+                    int key = rng() % 100000;
+                    if (expected.count(key) == 0)
+                    {
+                        set.insert(key);
+                        expected.insert(key);
+                    }
+                }
+            }
+            catch (const std::length_error &)
+            {
+            }
+
+            try
+            {
+                set.rebuildFilter();
+            }
+            catch (const std::length_error &)
+            {
+                failed = true;
+                for (int key : expected)
+                    REQUIRE(set.contains(key));
+                REQUIRE(set.avoidedWalks() == 0);
+
+                // Room again after removals
+                for (int i = 0; i < 20; i++)
+                {
+                    set.remove(*expected.begin());
+                    expected.erase(expected.begin());
+                }
+                set.rebuildFilter();
+            }
+
+            for (int key : expected)
+                REQUIRE(set.contains(key));
+            REQUIRE_FALSE(set.contains(100001));
+        }
+        REQUIRE(failed);
+    }
+}
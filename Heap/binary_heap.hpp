@@ -13,14 +13,23 @@
 #include <stdexcept> // Exception handling
 #include <vector>    // Used as main heap container
 
+#include "../Common/allocation_seal.hpp" // reserve/seal
+#include "../Common/expected.hpp"         // try_* results
+#include "../Common/latency_histogram.hpp" // setLatencyRecorder
+
 namespace ds
 {
     template <typename DataType>
     class BinaryHeap
     {
+    public:
+        typedef bool (*Compare)(const DataType &lhs, const DataType &rhs);
+
     private:
         std::vector<DataType> container;
-        bool (*cmp)(const DataType &lhs, const DataType &rhs);
+        Compare cmp;
+        bool sealed = false;
+        LatencyRecorder *latency = nullptr;
 
     public:
         /**
@@ -65,6 +74,13 @@ namespace ds
      */
         void push(const DataType &element)
         {
+            LatencyScope timer(latency, LatencyOp::push);
+
+            if (sealed && container.size() == container.capacity())
+            {
+                detail::sealedAllocation("BinaryHeap", (container.capacity() ? 2 * container.capacity() : 1) * sizeof(DataType));
+            }
+
             container.push_back(element);
             siftUp(container.size() - 1);
         }
@@ -75,9 +91,11 @@ namespace ds
      */
         void pop()
         {
+            LatencyScope timer(latency, LatencyOp::pop);
+
             if (container.empty())
             {
-                throw std::underflow_error("BinaryHeap: Heap is empty!");
+                DS_THROW(std::underflow_error, "BinaryHeap: Heap is empty!");
             }
 
             std::swap(container.front(), container.back());
@@ -100,12 +118,73 @@ namespace ds
         {
             if (container.empty())
             {
-                throw std::underflow_error("BinaryHeap: Heap is empty!");
+                DS_THROW(std::underflow_error, "BinaryHeap: Heap is empty!");
+            }
+
+            return container.front();
+        }
+
+        /**
+     * @brief Removes the top element of the heap without throwing
+     * @note Time complexity: O(logN)
+     * @return Errc::empty when the heap is empty
+     */
+        Expected<void> try_pop()
+        {
+            if (container.empty())
+            {
+                return Unexpected(Errc::empty);
+            }
+
+            pop();
+            return Expected<void>();
+        }
+
+        /**
+     * @brief Accesses the top element of the heap without throwing
+     * @note Time complexity: O(1)
+     * @return Expected<const DataType &> - the top element or Errc::empty
+     */
+        Expected<const DataType &> try_top() const
+        {
+            if (container.empty())
+            {
+                return Unexpected(Errc::empty);
             }
 
             return container.front();
         }
 
+        /**
+     * @brief Grows the buffer, so that count elements fit without allocating
+     * @note Time complexity: O(N)
+     */
+        void reserve(size_t count)
+        {
+            if (sealed && count > container.capacity())
+            {
+                detail::sealedAllocation("BinaryHeap", count * sizeof(DataType));
+            }
+
+            container.reserve(count);
+        }
+
+        /**
+     * @brief Reports every following allocation to the seal hook
+     * (see Common/allocation_seal.hpp)
+     */
+        void seal() { sealed = true; }
+
+        void unseal() { sealed = false; }
+
+        bool isSealed() const { return sealed; }
+
+        /**
+     * @brief Times push and pop into recorder (see
+     * Common/latency_histogram.hpp); nullptr turns it off
+     */
+        void setLatencyRecorder(LatencyRecorder *recorder) { latency = recorder; }
+
         /**
      * @brief Returns the number of elements in the heap
      *
@@ -118,7 +197,13 @@ namespace ds
      *
      * @return bool - true if empty, false otherwise
      */
-        bool isEmpty() const { return container.isEmpty(); }
+        bool isEmpty() const { return container.empty(); }
+
+        /**
+     * @brief Returns the comparison function the heap was constructed with,
+     * e.g. to tell BinaryHeap::less from BinaryHeap::greater
+     */
+        Compare comparator() const { return cmp; }
 
         //
         /* Helpers */
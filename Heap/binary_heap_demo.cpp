@@ -44,6 +44,23 @@ void testRemove()
     std::cout << "TEST REMOVE: PASSED" << std::endl;
 }
 
+void testTryApi()
+{
+    std::cout << "TEST TRY API" << std::endl;
+
+    Heap heap(Heap::less);
+    assert(heap.try_top().error() == ds::Errc::empty);
+    assert(heap.try_pop().error() == ds::Errc::empty);
+
+    heap.push(3);
+    heap.push(1);
+    assert(*heap.try_top() == 1);
+    assert(heap.try_pop());
+    assert(heap.try_top().value() == 3);
+
+    std::cout << "TEST TRY API: PASSED" << std::endl;
+}
+
 //
 // Driver
 int main()
@@ -65,6 +82,7 @@ int main()
 
     testInsert();
     testRemove();
+    testTryApi();
 
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,341 @@
+/**
+ * @file indirect_heap.hpp
+ * @author Ivan Penev
+ * @brief Binary heap which sifts (key, slot) pairs while payloads stay put
+ * @date 2026-10-18
+ *
+ * BinaryHeap swaps whole elements on every level of a sift, which for large
+ * elements means moving kilobytes per push or pop. Here the heap array holds
+ * only the key and the index of a slot in a slab where the payload was
+ * constructed. Payloads are never moved or copied by the heap, their address
+ * stays valid until they are released, and the cost of a sift depends only
+ * on the size of the key.
+ *
+ *     ds::IndirectHeap<uint64_t, Job> jobs;
+ *     jobs.push(job.deadline, job);
+ *     auto handle = jobs.popHandle();
+ *     run(jobs[handle]);
+ *     jobs.release(handle);
+ */
+
+#ifndef INDIRECT_HEAP_HPP_GUARD_
+#define INDIRECT_HEAP_HPP_GUARD_
+
+#include <cassert>   // Used to validate invariants
+#include <cstdint>
+#include <memory>    // std::unique_ptr
+#include <new>       // placement new
+#include <stdexcept> // Exception handling
+#include <utility>   // std::move
+#include <vector>    // Used as main heap container
+
+namespace ds
+{
+    template <typename KeyType, typename Payload>
+    class IndirectHeap
+    {
+    public:
+        /**
+         * @brief Identifies a payload in the slab until it is released
+         */
+        using Handle = uint32_t;
+
+    private:
+        struct Entry
+        {
+            KeyType key;
+            Handle slot;
+        };
+
+        // The slab grows by chunks, so payloads are never relocated
+        static const size_t CHUNK_BITS = 8;
+        static const size_t CHUNK = (size_t)1 << CHUNK_BITS;
+
+        struct Chunk
+        {
+            alignas(Payload) unsigned char bytes[CHUNK * sizeof(Payload)];
+        };
+
+        std::vector<Entry> container;
+        std::vector<std::unique_ptr<Chunk>> chunks;
+        std::vector<Handle> freeSlots;
+        size_t used = 0; // slots handed out so far (live or free)
+        bool (*cmp)(const KeyType &lhs, const KeyType &rhs);
+
+    public:
+        /**
+         * @brief A comparison function that checks whether lhs is less than rhs.
+         *
+         * @param lhs - left hand side
+         * @param rhs - right hand side
+         * @return true if the lhs is less than rhs.
+         */
+        static bool less(const KeyType &lhs, const KeyType &rhs)
+        {
+            return lhs < rhs;
+        }
+
+        /**
+         * @brief A comparison function that checks whether lhs is greater than rhs.
+         *
+         * @param lhs - left hand side
+         * @param rhs - right hand side
+         * @return true if the lhs is greater than rhs.
+         */
+        static bool greater(const KeyType &lhs, const KeyType &rhs)
+        {
+            return lhs > rhs;
+        }
+
+        /**
+         * @brief Constructs an empty Indirect Heap
+         *
+         * @param cmp - the comparison function of the keys
+         */
+        IndirectHeap(bool (*cmp)(const KeyType &lhs, const KeyType &rhs) = less)
+            : cmp(cmp) {}
+
+        IndirectHeap(const IndirectHeap &) = delete;
+        IndirectHeap &operator=(const IndirectHeap &) = delete;
+
+        /**
+         * @brief Destroys the payloads still in the heap. Popped payloads
+         * which were not released are destroyed as well.
+         */
+        ~IndirectHeap()
+        {
+            std::vector<bool> live(used, true);
+            for (Handle slot : freeSlots)
+                live[slot] = false;
+
+            for (size_t slot = 0; slot < used; slot++)
+            {
+                if (live[slot])
+                    at(slot).~Payload();
+            }
+        }
+
+        /**
+         * @brief Inserts a payload with the given key
+         * @note Time complexity: O(logN) moves of keys, the payload is
+         * constructed once in its slot
+         *
+         * @return Handle - where the payload lives until it is released
+         */
+        Handle push(const KeyType &key, const Payload &payload)
+        {
+            Handle slot = allocate();
+            try
+            {
+                new (&at(slot)) Payload(payload);
+            }
+            catch (...)
+            {
+                freeSlots.push_back(slot);
+                throw;
+            }
+            insert(key, slot);
+            return slot;
+        }
+
+        /**
+         * @brief Inserts a payload with the given key
+         * @note Time complexity: O(logN) moves of keys
+         */
+        Handle push(const KeyType &key, Payload &&payload)
+        {
+            Handle slot = allocate();
+            try
+            {
+                new (&at(slot)) Payload(std::move(payload));
+            }
+            catch (...)
+            {
+                freeSlots.push_back(slot);
+                throw;
+            }
+            insert(key, slot);
+            return slot;
+        }
+
+        /**
+         * @brief Accesses the key of the top element
+         * @note Time complexity: O(1)
+         * @throws std::underflow_error - when the heap is empty
+         */
+        const KeyType &topKey() const
+        {
+            return front().key;
+        }
+
+        /**
+         * @brief Accesses the payload of the top element
+         * @note Time complexity: O(1)
+         * @throws std::underflow_error - when the heap is empty
+         */
+        Payload &top()
+        {
+            return at(front().slot);
+        }
+
+        /**
+         * @brief Removes the top element and moves its payload out
+         * @note Time complexity: O(logN) moves of keys
+         * @throws std::underflow_error - when the heap is empty
+         */
+        Payload pop()
+        {
+            Handle slot = popHandle();
+            Payload payload(std::move(at(slot)));
+            release(slot);
+            return payload;
+        }
+
+        /**
+         * @brief Removes the top element from the heap, but keeps its payload
+         * in place. Call release() when done with it.
+         * @note Time complexity: O(logN) moves of keys
+         * @throws std::underflow_error - when the heap is empty
+         */
+        Handle popHandle()
+        {
+            Handle slot = front().slot;
+
+            Entry last = container.back();
+            container.pop_back();
+            if (!container.empty())
+                siftDown(0, last);
+
+            return slot;
+        }
+
+        /**
+         * @brief Destroys a popped payload and recycles its slot
+         * @note Time complexity: O(1)
+         */
+        void release(Handle handle)
+        {
+            assert(handle < used);
+            at(handle).~Payload();
+            freeSlots.push_back(handle);
+        }
+
+        /**
+         * @brief Accesses a payload which is in the heap or popped but not released
+         * @note Time complexity: O(1)
+         */
+        Payload &operator[](Handle handle)
+        {
+            assert(handle < used);
+            return at(handle);
+        }
+
+        const Payload &operator[](Handle handle) const
+        {
+            assert(handle < used);
+            return at(handle);
+        }
+
+        /**
+         * @brief Returns the number of elements in the heap
+         */
+        size_t size() const { return container.size(); }
+
+        /**
+         * @brief Checks if the heap is empty
+         */
+        bool isEmpty() const { return container.empty(); }
+
+        //
+        /* Helpers */
+    private:
+        const Entry &front() const
+        {
+            if (container.empty())
+            {
+                throw std::underflow_error("IndirectHeap: Heap is empty!");
+            }
+
+            return container.front();
+        }
+
+        Payload &at(size_t slot) const
+        {
+            Chunk &chunk = *chunks[slot >> CHUNK_BITS];
+            return reinterpret_cast<Payload *>(chunk.bytes)[slot & (CHUNK - 1)];
+        }
+
+        Handle allocate()
+        {
+            if (!freeSlots.empty())
+            {
+                Handle slot = freeSlots.back();
+                freeSlots.pop_back();
+                return slot;
+            }
+
+            if (used == chunks.size() * CHUNK)
+                chunks.emplace_back(new Chunk);
+
+            return (Handle)used++;
+        }
+
+        void insert(const KeyType &key, Handle slot)
+        {
+            container.push_back(Entry{key, slot});
+            siftUp(container.size() - 1);
+        }
+
+        /**
+         * @brief Moves the new last entry up. Parents are shifted down into
+         * the hole, the entry is written once at its final position.
+         *
+         * @param pos - Position of the sifted entry
+         */
+        void siftUp(size_t pos)
+        {
+            Entry entry = container[pos];
+            while (pos > 0 && cmp(entry.key, container[parent(pos)].key))
+            {
+                container[pos] = container[parent(pos)];
+                pos = parent(pos);
+            }
+            container[pos] = entry;
+        }
+
+        /**
+         * @brief Places entry into the hole at pos, moving the preferred
+         * child up while it comes before the entry
+         *
+         * @param pos - Position of the hole
+         * @param entry - The entry to place
+         */
+        void siftDown(size_t pos, const Entry &entry)
+        {
+            const size_t n = container.size();
+            while (leftChild(pos) < n)
+            {
+                size_t child = leftChild(pos);
+                if (child + 1 < n && cmp(container[child + 1].key, container[child].key))
+                    ++child;
+
+                if (!cmp(container[child].key, entry.key))
+                    break;
+
+                container[pos] = container[child];
+                pos = child;
+            }
+            container[pos] = entry;
+        }
+
+        static size_t parent(size_t i)
+        {
+            assert(i > 0);
+            return (i - 1) / 2;
+        }
+
+        static size_t leftChild(size_t i) { return 2 * i + 1; }
+    };
+} // namespace ds
+
+#endif // INDIRECT_HEAP_HPP_GUARD_
@@ -0,0 +1,88 @@
+// 256-byte job descriptors ordered by a 64-bit deadline: BinaryHeap moves
+// whole descriptors on every level of a sift, IndirectHeap moves 16-byte
+// (key, slot) entries. The workload keeps N jobs queued and repeatedly pops
+// the earliest one and schedules a new one.
+//
+// g++ -std=c++17 -O2 indirect_heap_bench.cpp -o indirect_heap_bench
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+
+#include "binary_heap.hpp"
+#include "indirect_heap.hpp"
+
+struct Job
+{
+    uint64_t deadline;
+    char descriptor[248];
+};
+
+static bool earlier(const Job &lhs, const Job &rhs)
+{
+    return lhs.deadline < rhs.deadline;
+}
+
+template <typename Work>
+double nsPerOp(size_t operations, Work work)
+{
+    auto start = std::chrono::steady_clock::now();
+    work();
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / operations;
+}
+
+int main()
+{
+    const size_t OPS = 2000000;
+
+    for (size_t queued : {1000, 100000, 1000000})
+    {
+        uint64_t checksum = 0;
+
+        double direct = nsPerOp(OPS, [&]
+                                {
+                                    std::mt19937_64 rng(1);
+                                    ds::BinaryHeap<Job> heap(earlier);
+                                    Job job{};
+                                    for (size_t i = 0; i < queued; i++)
+                                    {
+                                        job.deadline = rng() % (1 << 30);
+                                        heap.push(job);
+                                    }
+                                    for (size_t i = 0; i < OPS; i++)
+                                    {
+                                        job = heap.top();
+                                        heap.pop();
+                                        checksum += job.deadline;
+                                        job.deadline += rng() % (1 << 20);
+                                        heap.push(job);
+                                    } });
+
+        double indirect = nsPerOp(OPS, [&]
+                                  {
+                                      std::mt19937_64 rng(1);
+                                      ds::IndirectHeap<uint64_t, Job> heap;
+                                      Job job{};
+                                      for (size_t i = 0; i < queued; i++)
+                                      {
+                                          job.deadline = rng() % (1 << 30);
+                                          heap.push(job.deadline, job);
+                                      }
+                                      for (size_t i = 0; i < OPS; i++)
+                                      {
+                                          job = heap.pop();
+                                          checksum -= job.deadline;
+                                          job.deadline += rng() % (1 << 20);
+                                          heap.push(job.deadline, job);
+                                      } });
+
+        std::cout << queued << " jobs queued"
+                  << "\tBinaryHeap<Job>: " << direct << " ns/op"
+                  << "\tIndirectHeap<uint64_t, Job>: " << indirect << " ns/op"
+                  << "\t(" << (checksum == 0 ? "same order" : "DIFFERENT ORDER") << ")" << std::endl;
+    }
+
+    return 0;
+}
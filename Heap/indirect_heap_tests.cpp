@@ -0,0 +1,134 @@
+#define CATCH_CONFIG_MAIN
+#include "../Catch2/catch.hpp"
+#include "indirect_heap.hpp"
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace ds;
+
+// Counts live instances to check that every payload is destroyed exactly once
+struct Job
+{
+    static int alive;
+
+    std::string name;
+    char descriptor[200];
+
+    Job(const std::string &name) : name(name) { ++alive; }
+    Job(const Job &other) : name(other.name) { ++alive; }
+    Job(Job &&other) : name(std::move(other.name)) { ++alive; }
+    ~Job() { --alive; }
+};
+
+int Job::alive = 0;
+
+TEST_CASE("CONSTRUCTOR", "[DEFAULT]")
+{
+    IndirectHeap<int, Job> heap;
+
+    REQUIRE(heap.isEmpty());
+    REQUIRE_THROWS_AS(heap.topKey(), std::underflow_error);
+    REQUIRE_THROWS_AS(heap.pop(), std::underflow_error);
+    REQUIRE_THROWS_AS(heap.popHandle(), std::underflow_error);
+}
+
+TEST_CASE("ABSTRACT OPERATIONS", "[PUSH][POP][HANDLE]")
+{
+    SECTION("ORDER BY KEY")
+    {
+        IndirectHeap<int, Job> heap;
+        heap.push(5, Job("five"));
+        heap.push(1, Job("one"));
+        heap.push(3, Job("three"));
+
+        REQUIRE(heap.size() == 3);
+        REQUIRE(heap.topKey() == 1);
+        REQUIRE(heap.top().name == "one");
+        REQUIRE(heap.pop().name == "one");
+        REQUIRE(heap.pop().name == "three");
+        REQUIRE(heap.pop().name == "five");
+        REQUIRE(heap.isEmpty());
+    }
+
+    SECTION("GREATER")
+    {
+        IndirectHeap<int, int> heap(IndirectHeap<int, int>::greater);
+        for (int i = 0; i < 10; i++)
+            heap.push(i, i * 10);
+
+        REQUIRE(heap.topKey() == 9);
+        REQUIRE(heap.pop() == 90);
+    }
+
+    SECTION("PAYLOADS STAY PUT")
+    {
+        IndirectHeap<int, Job> heap;
+        IndirectHeap<int, Job>::Handle handle = heap.push(50, Job("fifty"));
+        Job *address = &heap[handle];
+
+        for (int i = 0; i < 1000; i++)
+            heap.push(i, Job(std::to_string(i)));
+        REQUIRE(&heap[handle] == address);
+
+        while (heap.topKey() < 50)
+            heap.pop();
+
+        // Key 50 exists twice - find the named one
+        IndirectHeap<int, Job>::Handle top = heap.popHandle();
+        if (heap[top].name != "fifty")
+        {
+            heap.release(top);
+            top = heap.popHandle();
+        }
+        REQUIRE(top == handle);
+        REQUIRE(&heap[top] == address);
+        REQUIRE(heap[top].name == "fifty");
+        heap.release(top);
+
+        // The slot is recycled
+        REQUIRE(heap.push(7, Job("seven")) == handle);
+    }
+
+    SECTION("DESTROYS EVERY PAYLOAD ONCE")
+    {
+        {
+            IndirectHeap<int, Job> heap;
+            for (int i = 0; i < 600; i++)
+                heap.push(i, Job("job"));
+
+            heap.pop();
+            heap.release(heap.popHandle());
+            heap.popHandle(); // popped but not released
+            REQUIRE(Job::alive == 598);
+        }
+        REQUIRE(Job::alive == 0);
+    }
+}
+
+TEST_CASE("MATCHES SORTING", "[PUSH][POP]")
+{
+    std::mt19937 rng(17);
+    IndirectHeap<uint32_t, uint32_t> heap;
+    std::vector<uint32_t> keys;
+
+    for (int round = 0; round < 20; round++)
+    {
+        for (int i = 0; i < 500; i++)
+        {
+            uint32_t key = rng() % 1000;
+            keys.push_back(key);
+            heap.push(key, key * 2);
+        }
+
+        std::sort(keys.begin(), keys.end());
+        for (int i = 0; i < 250; i++)
+        {
+            REQUIRE(heap.topKey() == keys.front());
+            REQUIRE(heap.pop() == keys.front() * 2);
+            keys.erase(keys.begin());
+        }
+    }
+}
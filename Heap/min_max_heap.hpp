@@ -0,0 +1,266 @@
+/**
+ * @file min_max_heap.hpp
+ * @author Ivan Penev
+ * @brief Implementation of min-max heap (double-ended priority queue)
+ * @date 2026-10-18
+ *
+ * A complete binary tree stored in an array, like BinaryHeap, whose levels
+ * alternate: every node on an even level (the root is level 0) is not greater
+ * than its descendants, every node on an odd level is not less than them.
+ * The smallest element is the root and the largest is one of its children.
+ */
+
+#ifndef MIN_MAX_HEAP_HPP_GUARD_
+#define MIN_MAX_HEAP_HPP_GUARD_
+
+#include <cassert>   // Used to validate invariants
+#include <stdexcept> // Exception handling
+#include <utility>   // std::swap
+#include <vector>    // Used as main heap container
+
+namespace ds
+{
+    template <typename DataType>
+    class MinMaxHeap
+    {
+    private:
+        std::vector<DataType> container;
+        bool (*cmp)(const DataType &lhs, const DataType &rhs);
+
+    public:
+        /**
+         * @brief A comparison function that checks whether lhs is less than rhs.
+         *
+         * @param lhs - left hand side
+         * @param rhs - right hand side
+         * @return true if the lhs is less than rhs.
+         */
+        static bool less(const DataType &lhs, const DataType &rhs)
+        {
+            return lhs < rhs;
+        }
+
+        /**
+         * @brief Constructs an empty Min-Max Heap
+         *
+         * @param cmp - strict ordering; min() is the first and max() the last
+         * element in this order
+         */
+        MinMaxHeap(bool (*cmp)(const DataType &lhs, const DataType &rhs) = less)
+            : cmp(cmp) {}
+
+        /**
+         * @brief Constructs a heap from the given elements
+         * @note Time complexity: O(N)
+         */
+        MinMaxHeap(const std::vector<DataType> &elements,
+                   bool (*cmp)(const DataType &lhs, const DataType &rhs) = less)
+            : container(elements), cmp(cmp)
+        {
+            for (size_t i = container.size() / 2; i-- > 0;)
+                siftDown(i);
+        }
+
+        /**
+         * @brief Inserts element into the heap
+         * @note Time complexity: O(logN)
+         * @param element - The element to insert
+         */
+        void push(const DataType &element)
+        {
+            container.push_back(element);
+            siftUp(container.size() - 1);
+        }
+
+        /**
+         * @brief Accesses the smallest element
+         * @note Time complexity: O(1)
+         * @throws std::underflow_error - when the heap is empty
+         */
+        const DataType &min() const
+        {
+            return container[minIndex()];
+        }
+
+        /**
+         * @brief Accesses the largest element
+         * @note Time complexity: O(1)
+         * @throws std::underflow_error - when the heap is empty
+         */
+        const DataType &max() const
+        {
+            return container[maxIndex()];
+        }
+
+        /**
+         * @brief Removes the smallest element
+         * @note Time complexity: O(logN)
+         * @throws std::underflow_error - when the heap is empty
+         */
+        void pop_min()
+        {
+            removeAt(minIndex());
+        }
+
+        /**
+         * @brief Removes the largest element
+         * @note Time complexity: O(logN)
+         * @throws std::underflow_error - when the heap is empty
+         */
+        void pop_max()
+        {
+            removeAt(maxIndex());
+        }
+
+        /**
+         * @brief Returns the number of elements in the heap
+         */
+        size_t size() const { return container.size(); }
+
+        /**
+         * @brief Checks if the heap is empty
+         */
+        bool isEmpty() const { return container.empty(); }
+
+        //
+        /* Helpers */
+    private:
+        size_t minIndex() const
+        {
+            if (container.empty())
+            {
+                throw std::underflow_error("MinMaxHeap: Heap is empty!");
+            }
+
+            return 0;
+        }
+
+        size_t maxIndex() const
+        {
+            if (container.empty())
+            {
+                throw std::underflow_error("MinMaxHeap: Heap is empty!");
+            }
+
+            if (container.size() == 1)
+                return 0;
+            if (container.size() == 2)
+                return 1;
+
+            return cmp(container[1], container[2]) ? 2 : 1;
+        }
+
+        void removeAt(size_t pos)
+        {
+            std::swap(container[pos], container.back());
+            container.pop_back();
+
+            if (pos < container.size())
+                siftDown(pos);
+        }
+
+        /**
+         * @brief Orders a and b the way the level of a requires: on a min
+         * level "a before b" means a is less, on a max level - greater
+         */
+        bool before(size_t a, size_t b, bool minLevel) const
+        {
+            return minLevel ? cmp(container[a], container[b]) : cmp(container[b], container[a]);
+        }
+
+        /**
+         * @brief Moves a new element up. It first decides whether it belongs
+         * to the min or to the max levels, then climbs only those levels.
+         *
+         * @param pos - Position of the sifted element
+         */
+        void siftUp(size_t pos)
+        {
+            if (pos == 0)
+                return;
+
+            bool minLevel = isMinLevel(pos);
+            size_t p = parent(pos);
+
+            if (before(p, pos, minLevel))
+            {
+                // Belongs to the other kind of levels
+                std::swap(container[pos], container[p]);
+                pos = p;
+                minLevel = !minLevel;
+            }
+
+            while (pos > 2 && before(pos, grandparent(pos), minLevel))
+            {
+                std::swap(container[pos], container[grandparent(pos)]);
+                pos = grandparent(pos);
+            }
+        }
+
+        /**
+         * @brief Moves the value down, jumping two levels at a time to the
+         * most extreme descendant of its kind
+         *
+         * @param pos - Position of the sifted element
+         */
+        void siftDown(size_t pos)
+        {
+            const bool minLevel = isMinLevel(pos);
+
+            while (leftChild(pos) < container.size())
+            {
+                // The most extreme among children and grandchildren
+                size_t best = leftChild(pos);
+                size_t candidates[] = {rightChild(pos),
+                                       leftChild(leftChild(pos)), rightChild(leftChild(pos)),
+                                       leftChild(rightChild(pos)), rightChild(rightChild(pos))};
+                for (size_t c : candidates)
+                {
+                    if (c < container.size() && before(c, best, minLevel))
+                        best = c;
+                }
+
+                if (!before(best, pos, minLevel))
+                    break;
+
+                std::swap(container[best], container[pos]);
+
+                if (best <= rightChild(pos))
+                    break; // a child - nothing below it can be out of order
+
+                // The element may now be on the wrong side of its new parent
+                size_t p = parent(best);
+                if (before(p, best, minLevel))
+                    std::swap(container[best], container[p]);
+
+                pos = best;
+            }
+        }
+
+        static bool isMinLevel(size_t i)
+        {
+            size_t level = 0;
+            for (size_t n = i + 1; n > 1; n >>= 1)
+                ++level;
+
+            return level % 2 == 0;
+        }
+
+        static size_t parent(size_t i)
+        {
+            assert(i > 0);
+            return (i - 1) / 2;
+        }
+
+        static size_t grandparent(size_t i)
+        {
+            return parent(parent(i));
+        }
+
+        static size_t leftChild(size_t i) { return 2 * i + 1; }
+
+        static size_t rightChild(size_t i) { return 2 * i + 2; }
+    };
+} // namespace ds
+
+#endif // MIN_MAX_HEAP_HPP_GUARD_
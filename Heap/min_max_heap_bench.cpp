@@ -0,0 +1,105 @@
+// Double-ended priority queue: MinMaxHeap against the two BinaryHeaps with
+// lazy cross-deletion it replaces. The workload pushes and alternately pops
+// the smallest and the largest element.
+//
+// g++ -std=c++17 -O2 min_max_heap_bench.cpp -o min_max_heap_bench
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "binary_heap.hpp"
+#include "min_max_heap.hpp"
+
+// (value, id) - the id tells the two heaps which entries were already taken
+using Entry = std::pair<int, unsigned>;
+
+class DualHeap
+{
+public:
+    DualHeap() : minHeap(ds::BinaryHeap<Entry>::less), maxHeap(ds::BinaryHeap<Entry>::greater) {}
+
+    void push(int value)
+    {
+        minHeap.push({value, nextId});
+        maxHeap.push({value, nextId});
+        taken.push_back(false);
+        ++nextId;
+    }
+
+    int pop_min() { return pop(minHeap); }
+    int pop_max() { return pop(maxHeap); }
+
+private:
+    int pop(ds::BinaryHeap<Entry> &heap)
+    {
+        // Skip the entries popped from the other heap
+        while (taken[heap.top().second])
+            heap.pop();
+
+        Entry top = heap.top();
+        heap.pop();
+        taken[top.second] = true;
+        return top.first;
+    }
+
+    ds::BinaryHeap<Entry> minHeap, maxHeap;
+    std::vector<bool> taken;
+    unsigned nextId = 0;
+};
+
+template <typename Work>
+double nsPerOp(size_t ops, Work work)
+{
+    auto start = std::chrono::steady_clock::now();
+    work();
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / ops;
+}
+
+int main()
+{
+    const size_t N = 1000000;
+
+    std::mt19937 rng(5);
+    std::vector<int> values(N);
+    for (int &v : values)
+        v = rng();
+
+    long long sink = 0;
+
+    double minMax = nsPerOp(2 * N, [&]
+                            {
+                                ds::MinMaxHeap<int> heap;
+                                for (int v : values)
+                                    heap.push(v);
+                                for (size_t i = 0; i < N; i++)
+                                {
+                                    if (i % 2)
+                                    {
+                                        sink += heap.min();
+                                        heap.pop_min();
+                                    }
+                                    else
+                                    {
+                                        sink += heap.max();
+                                        heap.pop_max();
+                                    }
+                                } });
+
+    double dual = nsPerOp(2 * N, [&]
+                          {
+                              DualHeap heap;
+                              for (int v : values)
+                                  heap.push(v);
+                              for (size_t i = 0; i < N; i++)
+                                  sink += i % 2 ? heap.pop_min() : heap.pop_max(); });
+
+    std::cout << "MinMaxHeap:        " << minMax << " ns/op\n"
+              << "2 x BinaryHeap:    " << dual << " ns/op\n"
+              << "(checksum " << sink << ")" << std::endl;
+
+    return 0;
+}
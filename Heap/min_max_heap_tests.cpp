@@ -0,0 +1,115 @@
+#define CATCH_CONFIG_MAIN
+#include "../Catch2/catch.hpp"
+#include "min_max_heap.hpp"
+
+#include <algorithm>
+#include <random>
+#include <set>
+#include <vector>
+
+using namespace ds;
+using Heap = MinMaxHeap<int>;
+
+TEST_CASE("CONSTRUCTORS", "[DEFAULT][BUILD]")
+{
+    SECTION("DEFAULT")
+    {
+        Heap heap;
+
+        REQUIRE(heap.isEmpty());
+        REQUIRE(heap.size() == 0);
+        REQUIRE_THROWS(heap.min());
+        REQUIRE_THROWS(heap.max());
+        REQUIRE_THROWS(heap.pop_min());
+        REQUIRE_THROWS(heap.pop_max());
+    }
+
+    SECTION("BUILD")
+    {
+        std::vector<int> v{7, 3, 9, -2, 15, 4, 8, 1, 0, 11};
+        Heap heap(v);
+
+        std::sort(v.begin(), v.end());
+        for (int expected : v)
+        {
+            REQUIRE(heap.min() == expected);
+            heap.pop_min();
+        }
+        REQUIRE(heap.isEmpty());
+    }
+}
+
+TEST_CASE("ABSTRACT OPERATIONS", "[PUSH][POP_MIN][POP_MAX]")
+{
+    SECTION("PUSH")
+    {
+        Heap heap;
+        std::vector<int> v{1, 5, -1, 11, 23, 48, 73, -7};
+
+        for (auto it = v.begin(); it != v.end(); ++it)
+        {
+            heap.push(*it);
+            REQUIRE(heap.min() == *std::min_element(v.begin(), it + 1));
+            REQUIRE(heap.max() == *std::max_element(v.begin(), it + 1));
+        }
+    }
+
+    SECTION("POP MAX")
+    {
+        std::vector<int> v{1, 5, -1, 11, 23, 48, 73, -7};
+        Heap heap(v);
+
+        std::sort(v.rbegin(), v.rend());
+        for (int expected : v)
+        {
+            REQUIRE(heap.max() == expected);
+            heap.pop_max();
+        }
+        REQUIRE(heap.isEmpty());
+    }
+
+    SECTION("CUSTOM COMPARATOR")
+    {
+        auto greater = [](const int &a, const int &b)
+        { return a > b; };
+        Heap heap(greater);
+
+        for (int i = 0; i < 10; i++)
+            heap.push(i);
+
+        REQUIRE(heap.min() == 9);
+        REQUIRE(heap.max() == 0);
+    }
+
+    SECTION("RANDOM MIX")
+    {
+        std::mt19937 rng(11);
+        std::uniform_int_distribution<int> dist(0, 1000);
+        std::multiset<int> reference;
+        Heap heap;
+
+        for (int i = 0; i < 20000; i++)
+        {
+            int op = dist(rng) % 4;
+            if (op < 2 || reference.empty())
+            {
+                int value = dist(rng);
+                heap.push(value);
+                reference.insert(value);
+            }
+            else if (op == 2)
+            {
+                REQUIRE(heap.min() == *reference.begin());
+                heap.pop_min();
+                reference.erase(reference.begin());
+            }
+            else
+            {
+                REQUIRE(heap.max() == *reference.rbegin());
+                heap.pop_max();
+                reference.erase(std::prev(reference.end()));
+            }
+            REQUIRE(heap.size() == reference.size());
+        }
+    }
+}
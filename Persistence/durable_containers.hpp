@@ -0,0 +1,331 @@
+/**
+ * @file durable_containers.hpp
+ * @author Ivan Penev
+ * @brief BST and dynamic_array that survive a crash
+ * @date 2026-10-18
+ *
+ * Every mutation is applied to the in-memory container and recorded in a
+ * WriteAheadLog. Every checkpointInterval records (or on checkpoint()) the
+ * contents are written as a snapshot and the log is emptied. Opening the
+ * directory again loads the last snapshot and replays the records after it.
+ *
+ * What is lost in a crash is bounded by the group commit: records of the
+ * group which was not synced yet. Call sync() to make everything so far
+ * durable.
+ *
+ *     ds::DurableBST<int> set("state/set");
+ *     set.insert(42);
+ *     set.sync();
+ */
+
+#ifndef DURABLE_CONTAINERS_HPP_GUARD_
+#define DURABLE_CONTAINERS_HPP_GUARD_
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem> // C++ 17
+#include <stdexcept>  // Exception handling
+#include <string>
+#include <vector>
+
+#include "../BinarySerachTree/BST.hpp"
+#include "../DynamicArray/dynamic_array.hpp"
+#include "snapshot.hpp"
+#include "write_ahead_log.hpp"
+
+namespace ds
+{
+    /**
+     * @brief What both durable containers share: the directory, the log and
+     * the checkpoint policy
+     */
+    class DurableStore
+    {
+    public:
+        DurableStore(const std::string &directory, size_t groupSize, size_t checkpointInterval)
+            : snapshotPath(prepare(directory) + "/snapshot"),
+              log(directory + "/wal", groupSize),
+              checkpointInterval(checkpointInterval) {}
+
+        // Record kinds
+        enum : uint8_t
+        {
+            INSERT = 1,
+            REMOVE = 2,
+            ASSIGN = 3
+        };
+
+        // Appends a record and tells whether a checkpoint is due
+        bool record(uint8_t type, const void *payload, uint32_t size)
+        {
+            log.append(type, payload, size);
+            return checkpointInterval != 0 && ++sinceCheckpoint >= checkpointInterval;
+        }
+
+        template <typename T>
+        void checkpoint(const std::vector<T> &elements)
+        {
+            log.sync();
+            writeSnapshot(snapshotPath, log.lastLsn(), elements);
+            log.truncate();
+            sinceCheckpoint = 0;
+        }
+
+        // Loads the last snapshot (if any) and remembers its LSN
+        template <typename T>
+        void load(std::vector<T> &elements)
+        {
+            readSnapshot(snapshotPath, checkpointLsn, elements);
+        }
+
+        // Replays the log records newer than the loaded snapshot through apply
+        template <typename Apply>
+        void replay(Apply apply)
+        {
+            log.replay([&](uint64_t lsn, uint8_t type, const unsigned char *payload, uint32_t size)
+                       {
+                           // Records already in the snapshot survive a crash between
+                           // the snapshot rename and the log truncation
+                           if (lsn > checkpointLsn)
+                               apply(type, payload, size); });
+            log.startAfter(checkpointLsn);
+        }
+
+        WriteAheadLog &wal() { return log; }
+
+    private:
+        static const std::string &prepare(const std::string &directory)
+        {
+            std::filesystem::create_directories(directory);
+            return directory;
+        }
+
+        const std::string snapshotPath;
+        WriteAheadLog log;
+        const size_t checkpointInterval;
+        size_t sinceCheckpoint = 0;
+        uint64_t checkpointLsn = 0;
+    };
+
+    /**
+     * @brief Crash-consistent ordered set on top of ds::BST
+     * @param DataType must be trivially copyable
+     */
+    template <typename DataType>
+    class DurableBST
+    {
+    public:
+        /**
+         * @brief Opens or creates the set stored in directory
+         *
+         * @param groupSize - log records per fdatasync
+         * @param checkpointInterval - log records between automatic checkpoints (0 - never)
+         */
+        explicit DurableBST(const std::string &directory, size_t groupSize = 64, size_t checkpointInterval = 100000)
+            : store(directory, groupSize, checkpointInterval)
+        {
+            // The snapshot is sorted - insert it middle first to get a balanced tree
+            std::vector<DataType> sorted;
+            store.load(sorted);
+            build(sorted, 0, sorted.size());
+
+            store.replay([this](uint8_t type, const unsigned char *payload, uint32_t)
+                         {
+                             DataType value;
+                             std::memcpy(&value, payload, sizeof(DataType));
+                             if (type == DurableStore::INSERT)
+                                 applyInsert(value);
+                             else
+                                 applyRemove(value); });
+        }
+
+        /**
+         * @throws std::logic_error if the element is already in the set
+         */
+        void insert(const DataType &value)
+        {
+            applyInsert(value);
+            if (store.record(DurableStore::INSERT, &value, sizeof(DataType)))
+                checkpoint();
+        }
+
+        /**
+         * @throws std::logic_error if the element is not in the set
+         */
+        void remove(const DataType &value)
+        {
+            if (!tree.contains(value))
+            {
+                throw std::logic_error("DurableBST: The element is not in the set!");
+            }
+
+            applyRemove(value);
+            if (store.record(DurableStore::REMOVE, &value, sizeof(DataType)))
+                checkpoint();
+        }
+
+        bool contains(const DataType &value) { return tree.contains(value); }
+
+        size_t size() const { return count; }
+
+        /**
+         * @brief Makes every mutation so far durable
+         */
+        void sync() { store.wal().sync(); }
+
+        /**
+         * @brief Writes a snapshot and empties the log
+         */
+        void checkpoint() { store.checkpoint(contents()); }
+
+        /**
+         * @brief Elements in ascending order
+         */
+        std::vector<DataType> contents() const
+        {
+            std::vector<DataType> elements;
+            elements.reserve(count);
+            tree.inorder([&elements](const DataType &value)
+                         { elements.push_back(value); });
+            return elements;
+        }
+
+    private:
+        void applyInsert(const DataType &value)
+        {
+            tree.insert(value);
+            ++count;
+        }
+
+        void applyRemove(const DataType &value)
+        {
+            tree.remove(value);
+            --count;
+        }
+
+        void build(const std::vector<DataType> &sorted, size_t from, size_t to)
+        {
+            if (from < to)
+            {
+                size_t mid = from + (to - from) / 2;
+                applyInsert(sorted[mid]);
+                build(sorted, from, mid);
+                build(sorted, mid + 1, to);
+            }
+        }
+
+        DurableStore store;
+        BST<DataType> tree;
+        size_t count = 0;
+    };
+
+    /**
+     * @brief Crash-consistent ds::dynamic_array
+     * @param T must be trivially copyable
+     */
+    template <typename T>
+    class DurableArray
+    {
+    private:
+        struct Assignment
+        {
+            uint32_t index;
+            T value;
+        };
+
+    public:
+        /**
+         * @brief Opens or creates the array stored in directory
+         *
+         * @param groupSize - log records per fdatasync
+         * @param checkpointInterval - log records between automatic checkpoints (0 - never)
+         */
+        explicit DurableArray(const std::string &directory, size_t groupSize = 64, size_t checkpointInterval = 100000)
+            : store(directory, groupSize, checkpointInterval)
+        {
+            std::vector<T> elements;
+            store.load(elements);
+            for (const T &value : elements)
+                array.push_back(value);
+
+            store.replay([this](uint8_t type, const unsigned char *payload, uint32_t)
+                         {
+                             if (type == DurableStore::INSERT)
+                             {
+                                 T value;
+                                 std::memcpy(&value, payload, sizeof(T));
+                                 array.push_back(value);
+                             }
+                             else if (type == DurableStore::REMOVE)
+                             {
+                                 array.pop_back();
+                             }
+                             else
+                             {
+                                 Assignment a;
+                                 std::memcpy(&a, payload, sizeof(a));
+                                 array[a.index] = a.value;
+                             } });
+        }
+
+        void push_back(const T &value)
+        {
+            array.push_back(value);
+            if (store.record(DurableStore::INSERT, &value, sizeof(T)))
+                checkpoint();
+        }
+
+        /**
+         * @throws std::logic_error if the array is empty
+         */
+        void pop_back()
+        {
+            array.pop_back();
+            if (store.record(DurableStore::REMOVE, nullptr, 0))
+                checkpoint();
+        }
+
+        /**
+         * @brief Replaces the element at index (the logged counterpart of operator[] =)
+         * @throws std::out_of_range for an invalid index
+         */
+        void set(unsigned int index, const T &value)
+        {
+            array[index] = value;
+
+            Assignment a{index, value};
+            if (store.record(DurableStore::ASSIGN, &a, sizeof(a)))
+                checkpoint();
+        }
+
+        const T &operator[](unsigned int index) const { return array[index]; }
+
+        unsigned int size() const { return array.size(); }
+
+        bool empty() const { return array.empty(); }
+
+        /**
+         * @brief Makes every mutation so far durable
+         */
+        void sync() { store.wal().sync(); }
+
+        /**
+         * @brief Writes a snapshot and empties the log
+         */
+        void checkpoint()
+        {
+            std::vector<T> elements;
+            elements.reserve(array.size());
+            for (unsigned int i = 0; i < array.size(); i++)
+                elements.push_back(array[i]);
+
+            store.checkpoint(elements);
+        }
+
+    private:
+        DurableStore store;
+        dynamic_array<T> array;
+    };
+} // namespace ds
+
+#endif // DURABLE_CONTAINERS_HPP_GUARD_
@@ -0,0 +1,184 @@
+#define CATCH_CONFIG_MAIN
+#include "../Catch2/catch.hpp"
+#include "durable_containers.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <set>
+#include <vector>
+
+using namespace ds;
+
+// Fresh directory in the temp directory, removed at the end of the test
+struct TempDir
+{
+    std::string path;
+
+    explicit TempDir(const std::string &name)
+        : path((std::filesystem::temp_directory_path() / name).string())
+    {
+        std::filesystem::remove_all(path);
+        std::filesystem::create_directories(path);
+    }
+
+    ~TempDir() { std::filesystem::remove_all(path); }
+};
+
+TEST_CASE("WRITE AHEAD LOG", "[APPEND][REPLAY][GROUP COMMIT]")
+{
+    TempDir dir("ds_wal_tests");
+    const std::string path = dir.path + "/wal";
+
+    SECTION("GROUP COMMIT")
+    {
+        WriteAheadLog log(path, 4);
+
+        for (int i = 0; i < 10; i++)
+            log.append(1, &i, sizeof(i));
+
+        REQUIRE(log.lastLsn() == 10);
+        REQUIRE(log.durableLsn() == 8); // two full groups
+        REQUIRE(log.syncCount() == 2);
+
+        log.sync();
+        REQUIRE(log.durableLsn() == 10);
+    }
+
+    SECTION("REPLAY")
+    {
+        {
+            WriteAheadLog log(path);
+            for (int i = 0; i < 100; i++)
+                log.append((uint8_t)(i % 3), &i, sizeof(i));
+        }
+
+        WriteAheadLog log(path);
+        int expected = 0;
+        size_t records = log.replay([&](uint64_t lsn, uint8_t type, const unsigned char *payload, uint32_t size)
+                                    {
+                                        int value;
+                                        std::memcpy(&value, payload, size);
+                                        REQUIRE(lsn == (uint64_t)expected + 1);
+                                        REQUIRE(type == expected % 3);
+                                        REQUIRE(value == expected++); });
+
+        REQUIRE(records == 100);
+        REQUIRE(log.append(0, nullptr, 0) == 101);
+    }
+
+    SECTION("TORN TAIL")
+    {
+        {
+            WriteAheadLog log(path, 1);
+            for (int i = 0; i < 10; i++)
+                log.append(1, &i, sizeof(i));
+        }
+
+        // A crash in the middle of the next write
+        std::filesystem::resize_file(path, std::filesystem::file_size(path) - 3);
+
+        WriteAheadLog log(path);
+        REQUIRE(log.replay([](uint64_t, uint8_t, const unsigned char *, uint32_t) {}) == 9);
+        REQUIRE(log.lastLsn() == 9);
+    }
+}
+
+TEST_CASE("DURABLE BST", "[RECOVERY][CHECKPOINT]")
+{
+    TempDir dir("ds_durable_bst");
+    std::set<int> reference;
+    std::mt19937 rng(3);
+    std::uniform_int_distribution<int> dist(0, 5000);
+
+    {
+        // Small interval - several automatic checkpoints happen on the way
+        DurableBST<int> set(dir.path, 16, 1000);
+        for (int i = 0; i < 5000; i++)
+        {
+            int value = dist(rng);
+            if (reference.count(value))
+            {
+                set.remove(value);
+                reference.erase(value);
+            }
+            else
+            {
+                set.insert(value);
+                reference.insert(value);
+            }
+        }
+        set.sync();
+    }
+
+    DurableBST<int> recovered(dir.path);
+    REQUIRE(recovered.size() == reference.size());
+    REQUIRE(recovered.contents() == std::vector<int>(reference.begin(), reference.end()));
+
+    REQUIRE_THROWS(recovered.insert(*reference.begin()));
+    REQUIRE_THROWS(recovered.remove(-1));
+}
+
+TEST_CASE("DURABLE ARRAY", "[RECOVERY][CHECKPOINT]")
+{
+    TempDir dir("ds_durable_array");
+
+    {
+        DurableArray<double> array(dir.path, 8, 0);
+        for (int i = 0; i < 100; i++)
+            array.push_back(i * 0.5);
+
+        array.checkpoint();
+
+        array.pop_back();
+        array.set(0, -1.0);
+        array.push_back(42.0);
+        array.sync();
+    }
+
+    DurableArray<double> array(dir.path);
+    REQUIRE(array.size() == 100);
+    REQUIRE(array[0] == -1.0);
+    REQUIRE(array[98] == 49.0);
+    REQUIRE(array[99] == 42.0);
+
+    REQUIRE_THROWS(array.set(100, 0.0));
+}
+
+// Descriptors open in the process
+static size_t openFiles()
+{
+    size_t count = 0;
+    for (auto it = std::filesystem::directory_iterator("/proc/self/fd"); it != std::filesystem::directory_iterator(); ++it)
+        ++count;
+    return count;
+}
+
+TEST_CASE("DAMAGED SNAPSHOT", "[SNAPSHOT]")
+{
+    TempDir dir("ds_damaged_snapshot");
+    const std::string path = dir.path + "/snapshot";
+    writeSnapshot(path, 7, std::vector<int>{1, 2, 3});
+
+    uint64_t lsn = 0;
+    std::vector<int> elements;
+    REQUIRE(readSnapshot(path, lsn, elements));
+    REQUIRE(lsn == 7);
+    REQUIRE(elements == std::vector<int>{1, 2, 3});
+
+    size_t files = openFiles();
+    for (uint64_t count : {uint64_t(1) << 62, uint64_t(4), uint64_t(2)})
+    {
+        // The count field follows the magic and the LSN
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(16);
+        file.write(reinterpret_cast<const char *>(&count), sizeof(count));
+        file.close();
+
+        REQUIRE_THROWS_AS(readSnapshot(path, lsn, elements), std::runtime_error);
+    }
+
+    std::filesystem::resize_file(path, 10); // cuts the header
+    REQUIRE_THROWS_AS(readSnapshot(path, lsn, elements), std::runtime_error);
+    REQUIRE(openFiles() == files);
+}
@@ -0,0 +1,200 @@
+/**
+ * @file snapshot.hpp
+ * @author Ivan Penev
+ * @brief Crash-consistent binary snapshots of container contents
+ * @date 2026-10-18
+ *
+ * A snapshot is written to a temporary file, synced and then renamed over the
+ * previous one, so after a crash either the old or the new snapshot is found,
+ * never a half-written one.
+ *
+ * File: [u64 magic][u64 lsn][u64 count][u32 element size][u32 crc][elements]
+ */
+
+#ifndef SNAPSHOT_HPP_GUARD_
+#define SNAPSHOT_HPP_GUARD_
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>    // rename
+#include <cstring>
+#include <stdexcept> // Exception handling
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <fcntl.h>    // open
+#include <sys/stat.h> // fstat
+#include <unistd.h>   // write, fsync, close
+
+#include "write_ahead_log.hpp" // ds::crc32
+
+namespace ds
+{
+    namespace snapshot_detail
+    {
+        const uint64_t MAGIC = 0x544f4853504e5344ull; // "DSNPSHOT"
+
+        struct Header
+        {
+            uint64_t magic;
+            uint64_t lsn;
+            uint64_t count;
+            uint32_t elementSize;
+            uint32_t crc;
+        };
+
+        inline void fail(const std::string &what)
+        {
+            throw std::runtime_error("Snapshot: " + what + ": " + std::strerror(errno));
+        }
+
+        inline void writeAll(int fd, const void *data, size_t size)
+        {
+            const char *bytes = static_cast<const char *>(data);
+            while (size > 0)
+            {
+                ssize_t written = ::write(fd, bytes, size);
+                if (written < 0)
+                {
+                    if (errno == EINTR)
+                        continue;
+                    fail("Write failed");
+                }
+                bytes += written;
+                size -= written;
+            }
+        }
+
+        inline bool readAll(int fd, void *data, size_t size)
+        {
+            char *bytes = static_cast<char *>(data);
+            while (size > 0)
+            {
+                ssize_t got = ::read(fd, bytes, size);
+                if (got <= 0)
+                {
+                    if (got < 0 && errno == EINTR)
+                        continue;
+                    return false;
+                }
+                bytes += got;
+                size -= got;
+            }
+            return true;
+        }
+
+        // Makes the rename itself durable
+        inline void syncDirectory(const std::string &path)
+        {
+            size_t slash = path.find_last_of('/');
+            std::string dir = slash == std::string::npos ? "." : path.substr(0, slash + 1);
+
+            int fd = ::open(dir.c_str(), O_RDONLY);
+            if (fd >= 0)
+            {
+                ::fsync(fd);
+                ::close(fd);
+            }
+        }
+    } // namespace snapshot_detail
+
+    /**
+     * @brief Atomically replaces the snapshot at path
+     *
+     * @param lsn - the last log record reflected in the elements
+     * @param elements - container contents in the container's own order
+     */
+    template <typename T>
+    void writeSnapshot(const std::string &path, uint64_t lsn, const std::vector<T> &elements)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "Snapshot: elements are stored as raw bytes");
+        using namespace snapshot_detail;
+
+        Header header{MAGIC, lsn, elements.size(), (uint32_t)sizeof(T),
+                      crc32(elements.data(), elements.size() * sizeof(T))};
+
+        std::string temp = path + ".tmp";
+        int fd = ::open(temp.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0)
+            fail("Cannot open " + temp);
+
+        try
+        {
+            writeAll(fd, &header, sizeof(header));
+            writeAll(fd, elements.data(), elements.size() * sizeof(T));
+            if (::fsync(fd) != 0)
+                fail("fsync failed");
+        }
+        catch (...)
+        {
+            ::close(fd);
+            throw;
+        }
+        ::close(fd);
+
+        if (std::rename(temp.c_str(), path.c_str()) != 0)
+            fail("Cannot rename " + temp);
+        syncDirectory(path);
+    }
+
+    /**
+     * @brief Loads the snapshot at path
+     *
+     * @param lsn - receives the LSN stored with the snapshot
+     * @param elements - receives the contents
+     * @return false if there is no snapshot yet
+     * @throws std::runtime_error when the snapshot is damaged
+     */
+    template <typename T>
+    bool readSnapshot(const std::string &path, uint64_t &lsn, std::vector<T> &elements)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "Snapshot: elements are stored as raw bytes");
+        using namespace snapshot_detail;
+
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            if (errno == ENOENT)
+                return false;
+            fail("Cannot open " + path);
+        }
+
+        Header header;
+        bool ok;
+        try
+        {
+            struct stat file;
+            if (::fstat(fd, &file) != 0)
+                fail("Cannot stat " + path);
+
+            // The count must match the file before anything is allocated for it
+            uint64_t payload = uint64_t(file.st_size) - sizeof(header);
+            ok = uint64_t(file.st_size) >= sizeof(header) && readAll(fd, &header, sizeof(header)) &&
+                 header.magic == MAGIC && header.elementSize == sizeof(T) &&
+                 header.count <= payload / sizeof(T) && header.count * sizeof(T) == payload;
+            if (ok)
+            {
+                elements.resize(header.count);
+                ok = readAll(fd, elements.data(), header.count * sizeof(T)) &&
+                     crc32(elements.data(), header.count * sizeof(T)) == header.crc;
+            }
+        }
+        catch (...)
+        {
+            ::close(fd);
+            throw;
+        }
+        ::close(fd);
+
+        if (!ok)
+        {
+            throw std::runtime_error("Snapshot: " + path + " is damaged!");
+        }
+
+        lsn = header.lsn;
+        return true;
+    }
+} // namespace ds
+
+#endif // SNAPSHOT_HPP_GUARD_
@@ -0,0 +1,44 @@
+// Write-ahead log throughput for different group commit sizes.
+// Every group costs one write() and one fdatasync(), so the record rate
+// should grow almost linearly with the group size until the disk bandwidth
+// becomes the limit.
+//
+// g++ -std=c++17 -O2 wal_bench.cpp -o wal_bench && ./wal_bench [directory]
+
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <string>
+
+#include "write_ahead_log.hpp"
+
+int main(int argc, char *argv[])
+{
+    const std::string path = std::string(argc > 1 ? argv[1] : ".") + "/wal_bench.log";
+    const size_t PAYLOAD = 32;
+    const size_t SYNCS = 200; // every run does the same number of fdatasync calls
+
+    char payload[PAYLOAD] = {0};
+
+    for (size_t group : {1, 4, 16, 64, 256, 1024})
+    {
+        std::remove(path.c_str());
+        size_t records = SYNCS * group;
+
+        auto start = std::chrono::steady_clock::now();
+        {
+            ds::WriteAheadLog log(path, group);
+            for (size_t i = 0; i < records; i++)
+                log.append(1, payload, PAYLOAD);
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        std::cout << "group " << group
+                  << "\trecords/s: " << (size_t)(records / elapsed.count())
+                  << "\tMB/s: " << records * (PAYLOAD + 17) / elapsed.count() / 1e6
+                  << std::endl;
+    }
+
+    std::remove(path.c_str());
+    return 0;
+}
@@ -0,0 +1,291 @@
+/**
+ * @file write_ahead_log.hpp
+ * @author Ivan Penev
+ * @brief Append-only write-ahead log with group commit
+ * @date 2026-10-18
+ *
+ * Every record gets a log sequence number (LSN) and a CRC. Appends are
+ * collected in memory and written with one write() + fdatasync() per group,
+ * so the cost of the sync is shared by groupSize records. A record is durable
+ * once sync() returned or its group was flushed.
+ *
+ * Record: [u32 payload size][u32 crc][u64 lsn][u8 type][payload]
+ */
+
+#ifndef WRITE_AHEAD_LOG_HPP_GUARD_
+#define WRITE_AHEAD_LOG_HPP_GUARD_
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept> // Exception handling
+#include <string>
+#include <vector>
+
+#include <fcntl.h>  // open
+#include <unistd.h> // pread, write, fdatasync, ftruncate, close
+
+namespace ds
+{
+    /**
+     * @brief CRC-32 (IEEE 802.3) used to detect torn or corrupted records
+     */
+    inline uint32_t crc32(const void *data, size_t size, uint32_t crc = 0)
+    {
+        // Built once, thread-safe since C++ 11
+        static const struct Table
+        {
+            uint32_t entry[256];
+
+            Table()
+            {
+                for (uint32_t i = 0; i < 256; i++)
+                {
+                    uint32_t c = i;
+                    for (int k = 0; k < 8; k++)
+                        c = c & 1 ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+                    entry[i] = c;
+                }
+            }
+        } table;
+
+        const unsigned char *bytes = static_cast<const unsigned char *>(data);
+        crc = ~crc;
+        for (size_t i = 0; i < size; i++)
+            crc = table.entry[(crc ^ bytes[i]) & 0xFF] ^ (crc >> 8);
+        return ~crc;
+    }
+
+    class WriteAheadLog
+    {
+    private:
+        static const size_t HEADER_SIZE = 4 + 4 + 8 + 1;
+
+    public:
+        /**
+         * @brief Opens (or creates) the log. The existing records are not read
+         * until replay() is called.
+         *
+         * @param path - local file
+         * @param groupSize - records per fdatasync (1 - sync every record)
+         * @throws std::invalid_argument when groupSize is 0
+         * @throws std::runtime_error when the file cannot be opened
+         */
+        WriteAheadLog(const std::string &path, size_t groupSize = 64)
+            : groupSize(groupSize)
+        {
+            if (groupSize == 0)
+            {
+                throw std::invalid_argument("WriteAheadLog: Invalid group size!");
+            }
+
+            fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_APPEND, 0644);
+            if (fd < 0)
+            {
+                throw std::runtime_error("WriteAheadLog: Cannot open " + path + ": " + std::strerror(errno));
+            }
+        }
+
+        WriteAheadLog(const WriteAheadLog &) = delete;
+        WriteAheadLog &operator=(const WriteAheadLog &) = delete;
+
+        /**
+         * @brief Syncs the pending group and closes the log
+         */
+        ~WriteAheadLog()
+        {
+            try
+            {
+                sync();
+            }
+            catch (...)
+            {
+                // Records of the last group are lost - like in a crash
+            }
+            ::close(fd);
+        }
+
+        /**
+         * @brief Appends a record. It is written together with its group.
+         * @note Amortized O(size)
+         *
+         * @param type - record kind, interpreted by the caller
+         * @return uint64_t - LSN of the record
+         */
+        uint64_t append(uint8_t type, const void *payload, uint32_t size)
+        {
+            uint64_t lsn = ++last;
+
+            size_t at = pending.size();
+            pending.resize(at + HEADER_SIZE + size);
+            unsigned char *record = pending.data() + at;
+
+            std::memcpy(record + 8, &lsn, 8);
+            record[16] = type;
+            if (size)
+                std::memcpy(record + HEADER_SIZE, payload, size);
+
+            uint32_t crc = crc32(record + 8, HEADER_SIZE - 8 + size);
+            std::memcpy(record, &size, 4);
+            std::memcpy(record + 4, &crc, 4);
+
+            if (++pendingRecords >= groupSize)
+                sync();
+
+            return lsn;
+        }
+
+        /**
+         * @brief Writes the pending group and waits until it is on disk
+         */
+        void sync()
+        {
+            if (pending.empty())
+                return;
+
+            writeAll(pending.data(), pending.size());
+            if (::fdatasync(fd) != 0)
+            {
+                throw std::runtime_error(std::string("WriteAheadLog: fdatasync failed: ") + std::strerror(errno));
+            }
+
+            pending.clear();
+            pendingRecords = 0;
+            durable = last;
+            ++syncs;
+        }
+
+        /**
+         * @brief Reads the log from the beginning. A torn or corrupted tail
+         * (from a crash in the middle of a write) ends the log and is cut off.
+         * @note Must be called before the first append
+         *
+         * @param visit - called as visit(lsn, type, payload, size)
+         * @return size_t - number of valid records
+         */
+        template <typename Visitor>
+        size_t replay(Visitor visit)
+        {
+            if (!pending.empty())
+            {
+                throw std::logic_error("WriteAheadLog: Replay after append!");
+            }
+
+            std::vector<unsigned char> bytes = readAll();
+            size_t at = 0, records = 0;
+
+            while (at + HEADER_SIZE <= bytes.size())
+            {
+                uint32_t size, crc;
+                uint64_t lsn;
+                std::memcpy(&size, &bytes[at], 4);
+                std::memcpy(&crc, &bytes[at + 4], 4);
+                std::memcpy(&lsn, &bytes[at + 8], 8);
+
+                if (at + HEADER_SIZE + size > bytes.size() ||
+                    crc32(&bytes[at + 8], HEADER_SIZE - 8 + size) != crc)
+                    break;
+
+                visit(lsn, bytes[at + 16], bytes.data() + at + HEADER_SIZE, size);
+                last = durable = lsn;
+                at += HEADER_SIZE + size;
+                ++records;
+            }
+
+            if (at < bytes.size() && ::ftruncate(fd, at) != 0)
+            {
+                throw std::runtime_error(std::string("WriteAheadLog: Cannot cut the torn tail: ") + std::strerror(errno));
+            }
+
+            return records;
+        }
+
+        /**
+         * @brief Drops every record (after a checkpoint). LSNs keep growing.
+         */
+        void truncate()
+        {
+            sync();
+            if (::ftruncate(fd, 0) != 0 || ::fdatasync(fd) != 0)
+            {
+                throw std::runtime_error(std::string("WriteAheadLog: Truncate failed: ") + std::strerror(errno));
+            }
+        }
+
+        /**
+         * @brief Continues the LSN sequence after a checkpoint taken at lsn
+         */
+        void startAfter(uint64_t lsn)
+        {
+            if (lsn > last)
+                last = durable = lsn;
+        }
+
+        /**
+         * @brief Returns the LSN of the last appended record
+         */
+        uint64_t lastLsn() const { return last; }
+
+        /**
+         * @brief Returns the LSN up to which every record is on disk
+         */
+        uint64_t durableLsn() const { return durable; }
+
+        /**
+         * @brief Returns the number of fdatasync calls so far
+         */
+        size_t syncCount() const { return syncs; }
+
+        //
+        /* Helpers */
+    private:
+        void writeAll(const unsigned char *data, size_t size)
+        {
+            while (size > 0)
+            {
+                ssize_t written = ::write(fd, data, size);
+                if (written < 0)
+                {
+                    if (errno == EINTR)
+                        continue;
+                    throw std::runtime_error(std::string("WriteAheadLog: Write failed: ") + std::strerror(errno));
+                }
+                data += written;
+                size -= written;
+            }
+        }
+
+        std::vector<unsigned char> readAll()
+        {
+            std::vector<unsigned char> bytes;
+            unsigned char chunk[1 << 16];
+            off_t offset = 0;
+
+            for (;;)
+            {
+                ssize_t got = ::pread(fd, chunk, sizeof(chunk), offset);
+                if (got < 0)
+                {
+                    throw std::runtime_error(std::string("WriteAheadLog: Read failed: ") + std::strerror(errno));
+                }
+                if (got == 0)
+                    return bytes;
+
+                bytes.insert(bytes.end(), chunk, chunk + got);
+                offset += got;
+            }
+        }
+
+        int fd;
+        const size_t groupSize;
+
+        std::vector<unsigned char> pending; // the current group
+        size_t pendingRecords = 0;
+
+        uint64_t last = 0;    // LSN of the last appended record
+        uint64_t durable = 0; // LSN of the last synced record
+        size_t syncs = 0;
+    };
+} // namespace ds
+
+#endif // WRITE_AHEAD_LOG_HPP_GUARD_
@@ -0,0 +1,307 @@
+/**
+ * @file epoch_reclamation.hpp
+ * @author Ivan Penev
+ * @brief Epoch-based memory reclamation (EBR) for lock-free node containers
+ * @date 2026-10-18
+ *
+ * A lock-free container cannot delete an unlinked node right away, because
+ * another thread may still be reading it. With EBR every thread pins the
+ * current global epoch while it touches shared nodes, and unlinked nodes are
+ * retired into the limbo list of that epoch. The global epoch only advances
+ * when every pinned thread has observed it, so a node retired in epoch e can
+ * be freed once the global epoch reaches e + 2.
+ *
+ *     ds::EpochDomain domain;              // shared by the container
+ *     ds::EpochDomain::Participant me(domain); // one per thread
+ *
+ *     {
+ *         auto guard = me.pin();
+ *         Node *n = head.load();
+ *         ...                               // n cannot be freed meanwhile
+ *         me.retire(n);                     // instead of delete n
+ *     }
+ */
+
+#ifndef EPOCH_RECLAMATION_HPP_GUARD_
+#define EPOCH_RECLAMATION_HPP_GUARD_
+
+#include <atomic>    // Epoch counters
+#include <cassert>   // Used to validate invariants
+#include <cstddef>
+#include <stdexcept> // Exception handling
+#include <vector>    // Limbo lists
+
+namespace ds
+{
+    /**
+     * @brief An object waiting to be freed together with the way to free it
+     */
+    struct Retired
+    {
+        void *ptr;
+        void (*deleter)(void *);
+
+        void reclaim() const { deleter(ptr); }
+
+        template <typename T>
+        static Retired of(T *ptr)
+        {
+            return Retired{ptr, [](void *p)
+                            { delete static_cast<T *>(p); }};
+        }
+    };
+
+    class EpochDomain
+    {
+    private:
+        static const unsigned EPOCHS = 3; // e - 1, e and e + 1 can be live
+
+        // Per-thread state. Records are never freed before the domain, so the
+        // registry can be walked without locks.
+        struct Record
+        {
+            std::atomic<unsigned long long> epoch{0};
+            std::atomic<bool> pinned{false};
+            std::atomic<bool> inUse{false};
+            Record *next = nullptr;
+
+            std::vector<Retired> limbo[EPOCHS];
+            unsigned long long limboEpoch[EPOCHS] = {0, 0, 0};
+            size_t retiredSinceAdvance = 0;
+        };
+
+    public:
+        /**
+         * @brief Constructs a new domain
+         *
+         * @param batchSize - number of retirements after which a thread tries
+         * to advance the epoch and free old limbo lists
+         */
+        explicit EpochDomain(size_t batchSize = 64)
+            : batchSize(batchSize)
+        {
+            if (batchSize == 0)
+            {
+                throw std::invalid_argument("EpochDomain: Invalid batch size!");
+            }
+        }
+
+        EpochDomain(const EpochDomain &) = delete;
+        EpochDomain &operator=(const EpochDomain &) = delete;
+
+        /**
+         * @brief Frees everything that is still retired
+         * @note No participant may be alive at this point
+         */
+        ~EpochDomain()
+        {
+            Record *rec = records.load(std::memory_order_acquire);
+            while (rec)
+            {
+                assert(!rec->inUse.load());
+                for (std::vector<Retired> &list : rec->limbo)
+                    for (const Retired &r : list)
+                        r.reclaim();
+
+                Record *next = rec->next;
+                delete rec;
+                rec = next;
+            }
+        }
+
+        /**
+         * @brief Returns the current global epoch
+         */
+        unsigned long long epoch() const { return globalEpoch.load(std::memory_order_acquire); }
+
+        /**
+         * @brief A thread's membership in the domain. Must not be shared
+         * between threads.
+         */
+        class Participant
+        {
+        public:
+            explicit Participant(EpochDomain &domain)
+                : domain(domain), rec(domain.acquire()) {}
+
+            Participant(const Participant &) = delete;
+            Participant &operator=(const Participant &) = delete;
+
+            /**
+             * @brief Leaves the domain. The limbo lists stay with the record and
+             * are freed by the next thread that takes it or by the domain.
+             */
+            ~Participant()
+            {
+                assert(!rec->pinned.load());
+                rec->inUse.store(false, std::memory_order_release);
+            }
+
+            /**
+             * @brief Critical section guard returned by pin()
+             */
+            class Guard
+            {
+            public:
+                Guard(Guard &&other) noexcept : owner(other.owner) { other.owner = nullptr; }
+                Guard(const Guard &) = delete;
+                Guard &operator=(const Guard &) = delete;
+
+                ~Guard()
+                {
+                    if (owner)
+                        owner->unpin();
+                }
+
+            private:
+                friend Participant;
+                explicit Guard(Participant *owner) : owner(owner) {}
+
+                Participant *owner;
+            };
+
+            /**
+             * @brief Enters a critical section. Shared nodes read inside it stay
+             * valid until the guard is destroyed. Pins may nest.
+             */
+            Guard pin()
+            {
+                if (depth++ == 0)
+                {
+                    rec->pinned.store(true, std::memory_order_relaxed);
+                    // Publish the pin before reading any shared pointer
+                    rec->epoch.store(domain.globalEpoch.load(std::memory_order_relaxed), std::memory_order_relaxed);
+                    std::atomic_thread_fence(std::memory_order_seq_cst);
+                    rec->epoch.store(domain.globalEpoch.load(std::memory_order_relaxed), std::memory_order_release);
+                }
+
+                return Guard(this);
+            }
+
+            /**
+             * @brief Hands an unlinked node to the domain instead of deleting it
+             * @note Amortized O(1); every batchSize calls try to advance the epoch
+             */
+            template <typename T>
+            void retire(T *ptr)
+            {
+                retire(Retired::of(ptr));
+            }
+
+            void retire(Retired r)
+            {
+                unsigned long long e = domain.globalEpoch.load(std::memory_order_acquire);
+                unsigned slot = e % EPOCHS;
+
+                // The slot still holds objects from e - 3 or older - they are safe
+                if (rec->limboEpoch[slot] != e)
+                {
+                    free(slot);
+                    rec->limboEpoch[slot] = e;
+                }
+
+                rec->limbo[slot].push_back(r);
+
+                if (++rec->retiredSinceAdvance >= domain.batchSize)
+                {
+                    rec->retiredSinceAdvance = 0;
+                    collect();
+                }
+            }
+
+            /**
+             * @brief Tries to advance the global epoch and frees every limbo
+             * list that became safe
+             */
+            void collect()
+            {
+                unsigned long long e = domain.tryAdvance();
+
+                for (unsigned slot = 0; slot < EPOCHS; slot++)
+                {
+                    if (!rec->limbo[slot].empty() && rec->limboEpoch[slot] + 2 <= e)
+                        free(slot);
+                }
+            }
+
+            /**
+             * @brief Returns the number of objects retired by this participant
+             * which are not freed yet
+             */
+            size_t pending() const
+            {
+                size_t count = 0;
+                for (const std::vector<Retired> &list : rec->limbo)
+                    count += list.size();
+                return count;
+            }
+
+        private:
+            void unpin()
+            {
+                assert(depth > 0);
+                if (--depth == 0)
+                    rec->pinned.store(false, std::memory_order_release);
+            }
+
+            void free(unsigned slot)
+            {
+                for (const Retired &r : rec->limbo[slot])
+                    r.reclaim();
+                rec->limbo[slot].clear(); // keeps the capacity - no allocation next time
+            }
+
+            EpochDomain &domain;
+            Record *rec;
+            unsigned depth = 0;
+        };
+
+        /* Helpers */
+    private:
+        // Reuses a free record or appends a new one to the registry
+        Record *acquire()
+        {
+            for (Record *rec = records.load(std::memory_order_acquire); rec; rec = rec->next)
+            {
+                bool expected = false;
+                if (!rec->inUse.load(std::memory_order_relaxed) &&
+                    rec->inUse.compare_exchange_strong(expected, true, std::memory_order_acquire))
+                    return rec;
+            }
+
+            Record *rec = new Record;
+            rec->inUse.store(true, std::memory_order_relaxed);
+
+            Record *head = records.load(std::memory_order_relaxed);
+            do
+            {
+                rec->next = head;
+            } while (!records.compare_exchange_weak(head, rec, std::memory_order_release, std::memory_order_relaxed));
+
+            return rec;
+        }
+
+        // Advances the epoch if every pinned thread has already observed it
+        unsigned long long tryAdvance()
+        {
+            unsigned long long e = globalEpoch.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            for (Record *rec = records.load(std::memory_order_acquire); rec; rec = rec->next)
+            {
+                if (rec->pinned.load(std::memory_order_acquire) &&
+                    rec->epoch.load(std::memory_order_acquire) != e)
+                    return e;
+            }
+
+            globalEpoch.compare_exchange_strong(e, e + 1, std::memory_order_acq_rel);
+            return globalEpoch.load(std::memory_order_acquire);
+        }
+
+        const size_t batchSize;
+        std::atomic<unsigned long long> globalEpoch{0};
+        std::atomic<Record *> records{nullptr};
+    };
+} // namespace ds
+
+#endif // EPOCH_RECLAMATION_HPP_GUARD_
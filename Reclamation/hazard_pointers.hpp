@@ -0,0 +1,239 @@
+/**
+ * @file hazard_pointers.hpp
+ * @author Ivan Penev
+ * @brief Hazard pointer based memory reclamation for lock-free node containers
+ * @date 2026-10-18
+ *
+ * Alternative to EpochDomain. Instead of pinning a whole epoch, a thread
+ * announces every single node it is about to dereference in one of its hazard
+ * slots. Retired nodes are freed by a scan once no slot points to them. The
+ * bookkeeping per access is higher than with epochs, but a stalled thread can
+ * only delay the nodes it actually protects.
+ *
+ *     ds::HazardDomain domain;
+ *     ds::HazardDomain::Participant me(domain);
+ *
+ *     Node *n = me.protect(0, head); // stays valid until slot 0 is cleared
+ *     ...
+ *     me.clear(0);
+ *     me.retire(n);
+ */
+
+#ifndef HAZARD_POINTERS_HPP_GUARD_
+#define HAZARD_POINTERS_HPP_GUARD_
+
+#include <algorithm> // Sorting the hazard snapshot
+#include <atomic>
+#include <cassert>   // Used to validate invariants
+#include <cstddef>
+#include <stdexcept> // Exception handling
+#include <vector>
+
+#include "epoch_reclamation.hpp" // ds::Retired
+
+namespace ds
+{
+    class HazardDomain
+    {
+    public:
+        static const unsigned SLOTS = 4; // hazard pointers per thread
+
+    private:
+        struct Record
+        {
+            std::atomic<void *> hazards[SLOTS] = {};
+            std::atomic<bool> inUse{false};
+            Record *next = nullptr;
+
+            std::vector<Retired> retired;
+        };
+
+    public:
+        /**
+         * @brief Constructs a new domain
+         *
+         * @param scanThreshold - number of retired objects a thread collects
+         * before it scans the hazard slots. Every scan frees all but at most
+         * (threads * SLOTS) of them, so the cost is amortized O(1) per retire
+         * when the threshold is above that.
+         */
+        explicit HazardDomain(size_t scanThreshold = 128)
+            : scanThreshold(scanThreshold)
+        {
+            if (scanThreshold == 0)
+            {
+                throw std::invalid_argument("HazardDomain: Invalid scan threshold!");
+            }
+        }
+
+        HazardDomain(const HazardDomain &) = delete;
+        HazardDomain &operator=(const HazardDomain &) = delete;
+
+        /**
+         * @brief Frees everything that is still retired
+         * @note No participant may be alive at this point
+         */
+        ~HazardDomain()
+        {
+            Record *rec = records.load(std::memory_order_acquire);
+            while (rec)
+            {
+                assert(!rec->inUse.load());
+                for (const Retired &r : rec->retired)
+                    r.reclaim();
+
+                Record *next = rec->next;
+                delete rec;
+                rec = next;
+            }
+        }
+
+        /**
+         * @brief A thread's membership in the domain. Must not be shared
+         * between threads.
+         */
+        class Participant
+        {
+        public:
+            explicit Participant(HazardDomain &domain)
+                : domain(domain), rec(domain.acquire()) {}
+
+            Participant(const Participant &) = delete;
+            Participant &operator=(const Participant &) = delete;
+
+            ~Participant()
+            {
+                for (unsigned i = 0; i < SLOTS; i++)
+                    clear(i);
+                rec->inUse.store(false, std::memory_order_release);
+            }
+
+            /**
+             * @brief Loads src and protects the loaded node in the given slot
+             *
+             * @param slot - hazard slot in [0, SLOTS)
+             * @param src - shared link to the node
+             * @return T* - the protected node (may be nullptr)
+             */
+            template <typename T>
+            T *protect(unsigned slot, const std::atomic<T *> &src)
+            {
+                assert(slot < SLOTS);
+
+                T *ptr = src.load(std::memory_order_relaxed);
+                for (;;)
+                {
+                    rec->hazards[slot].store(ptr, std::memory_order_seq_cst);
+
+                    // The node may have been unlinked before the announcement was visible
+                    T *again = src.load(std::memory_order_seq_cst);
+                    if (again == ptr)
+                        return ptr;
+
+                    ptr = again;
+                }
+            }
+
+            /**
+             * @brief Releases the node protected in the slot
+             */
+            void clear(unsigned slot)
+            {
+                assert(slot < SLOTS);
+                rec->hazards[slot].store(nullptr, std::memory_order_release);
+            }
+
+            /**
+             * @brief Hands an unlinked node to the domain instead of deleting it
+             */
+            template <typename T>
+            void retire(T *ptr)
+            {
+                retire(Retired::of(ptr));
+            }
+
+            void retire(Retired r)
+            {
+                rec->retired.push_back(r);
+
+                if (rec->retired.size() >= domain.scanThreshold)
+                    collect();
+            }
+
+            /**
+             * @brief Frees every retired node which no hazard slot points to
+             * @note Time complexity: O(R log H) for R retired nodes and H slots
+             */
+            void collect()
+            {
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+
+                std::vector<void *> &hazards = snapshot;
+                hazards.clear();
+                for (Record *other = domain.records.load(std::memory_order_acquire); other; other = other->next)
+                {
+                    for (unsigned i = 0; i < SLOTS; i++)
+                    {
+                        void *h = other->hazards[i].load(std::memory_order_acquire);
+                        if (h)
+                            hazards.push_back(h);
+                    }
+                }
+                std::sort(hazards.begin(), hazards.end());
+
+                // Keep the protected ones at the front
+                size_t kept = 0;
+                for (size_t i = 0; i < rec->retired.size(); i++)
+                {
+                    const Retired &r = rec->retired[i];
+                    if (std::binary_search(hazards.begin(), hazards.end(), r.ptr))
+                        rec->retired[kept++] = r;
+                    else
+                        r.reclaim();
+                }
+                rec->retired.resize(kept);
+            }
+
+            /**
+             * @brief Returns the number of objects retired by this participant
+             * which are not freed yet
+             */
+            size_t pending() const { return rec->retired.size(); }
+
+        private:
+            HazardDomain &domain;
+            Record *rec;
+            std::vector<void *> snapshot; // reused by collect()
+        };
+
+        /* Helpers */
+    private:
+        // Reuses a free record or appends a new one to the registry
+        Record *acquire()
+        {
+            for (Record *rec = records.load(std::memory_order_acquire); rec; rec = rec->next)
+            {
+                bool expected = false;
+                if (!rec->inUse.load(std::memory_order_relaxed) &&
+                    rec->inUse.compare_exchange_strong(expected, true, std::memory_order_acquire))
+                    return rec;
+            }
+
+            Record *rec = new Record;
+            rec->inUse.store(true, std::memory_order_relaxed);
+
+            Record *head = records.load(std::memory_order_relaxed);
+            do
+            {
+                rec->next = head;
+            } while (!records.compare_exchange_weak(head, rec, std::memory_order_release, std::memory_order_relaxed));
+
+            return rec;
+        }
+
+        const size_t scanThreshold;
+        std::atomic<Record *> records{nullptr};
+    };
+} // namespace ds
+
+#endif // HAZARD_POINTERS_HPP_GUARD_
@@ -0,0 +1,107 @@
+// Reclamation overhead: push/pop pairs on a Treiber stack where popped nodes
+// are (a) leaked - the lower bound, (b) retired through EpochDomain,
+// (c) retired through HazardDomain.
+//
+// g++ -std=c++17 -O2 -pthread reclamation_bench.cpp -o reclamation_bench
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "epoch_reclamation.hpp"
+#include "hazard_pointers.hpp"
+
+struct Node
+{
+    int value;
+    Node *next;
+};
+
+std::atomic<Node *> head{nullptr};
+
+void push(Node *node)
+{
+    Node *old = head.load();
+    do
+    {
+        node->next = old;
+    } while (!head.compare_exchange_weak(old, node));
+}
+
+template <typename Work>
+double run(int threads, int ops, Work work)
+{
+    std::vector<std::thread> pool;
+    auto start = std::chrono::steady_clock::now();
+
+    for (int t = 0; t < threads; t++)
+        pool.emplace_back([&]
+                          { work(ops); });
+    for (std::thread &th : pool)
+        th.join();
+
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / ((double)threads * ops);
+}
+
+int main()
+{
+    const int OPS = 1000000;
+
+    for (int threads : {1, 2, 4, 8})
+    {
+        double leak = run(threads, OPS, [](int ops)
+                          {
+                              for (int i = 0; i < ops; i++)
+                              {
+                                  push(new Node{i, nullptr});
+                                  Node *old = head.load();
+                                  // ABA is harmless here - nodes are never reused
+                                  while (old && !head.compare_exchange_weak(old, old->next))
+                                      ;
+                              } });
+
+        ds::EpochDomain epochs;
+        double ebr = run(threads, OPS, [&](int ops)
+                         {
+                             ds::EpochDomain::Participant me(epochs);
+                             for (int i = 0; i < ops; i++)
+                             {
+                                 push(new Node{i, nullptr});
+                                 auto guard = me.pin();
+                                 Node *old = head.load();
+                                 while (old && !head.compare_exchange_weak(old, old->next))
+                                     ;
+                                 if (old)
+                                     me.retire(old);
+                             } });
+
+        ds::HazardDomain hazards;
+        double hp = run(threads, OPS, [&](int ops)
+                        {
+                            ds::HazardDomain::Participant me(hazards);
+                            for (int i = 0; i < ops; i++)
+                            {
+                                push(new Node{i, nullptr});
+                                Node *old;
+                                for (;;)
+                                {
+                                    old = me.protect(0, head);
+                                    if (!old || head.compare_exchange_strong(old, old->next))
+                                        break;
+                                }
+                                me.clear(0);
+                                if (old)
+                                    me.retire(old);
+                            } });
+
+        std::cout << "threads: " << threads
+                  << "\tleak: " << leak << " ns/op"
+                  << "\tebr: " << ebr << " ns/op"
+                  << "\thazard: " << hp << " ns/op" << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,215 @@
+#define CATCH_CONFIG_MAIN
+#include "../Catch2/catch.hpp"
+#include "epoch_reclamation.hpp"
+#include "hazard_pointers.hpp"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace ds;
+
+// Counts live nodes so leaks and double frees show up in the tests
+struct Tracked
+{
+    static std::atomic<int> alive;
+
+    int value;
+    std::atomic<Tracked *> next{nullptr};
+
+    explicit Tracked(int value = 0) : value(value) { ++alive; }
+    ~Tracked() { --alive; }
+};
+
+std::atomic<int> Tracked::alive{0};
+
+// Treiber stack - the smallest node container that needs deferred freeing
+struct EpochStack
+{
+    std::atomic<Tracked *> head{nullptr};
+
+    void push(EpochDomain::Participant &, int value)
+    {
+        Tracked *node = new Tracked(value);
+        Tracked *old = head.load();
+        do
+        {
+            node->next.store(old);
+        } while (!head.compare_exchange_weak(old, node));
+    }
+
+    bool pop(EpochDomain::Participant &me, int &out)
+    {
+        auto guard = me.pin();
+        Tracked *old = head.load();
+        while (old && !head.compare_exchange_weak(old, old->next.load()))
+            ;
+
+        if (!old)
+            return false;
+
+        out = old->value;
+        me.retire(old);
+        return true;
+    }
+};
+
+struct HazardStack
+{
+    std::atomic<Tracked *> head{nullptr};
+
+    void push(HazardDomain::Participant &, int value)
+    {
+        Tracked *node = new Tracked(value);
+        Tracked *old = head.load();
+        do
+        {
+            node->next.store(old);
+        } while (!head.compare_exchange_weak(old, node));
+    }
+
+    bool pop(HazardDomain::Participant &me, int &out)
+    {
+        Tracked *old;
+        for (;;)
+        {
+            old = me.protect(0, head);
+            if (!old)
+                return false;
+
+            if (head.compare_exchange_strong(old, old->next.load()))
+                break;
+        }
+        me.clear(0);
+
+        out = old->value;
+        me.retire(old);
+        return true;
+    }
+};
+
+template <typename Domain, typename Stack>
+long long stress(Domain &domain, Stack &stack, int threads, int perThread)
+{
+    std::atomic<long long> sum{0};
+    std::vector<std::thread> pool;
+
+    for (int t = 0; t < threads; t++)
+    {
+        pool.emplace_back([&, t]
+                          {
+                              typename Domain::Participant me(domain);
+                              int value;
+                              for (int i = 0; i < perThread; i++)
+                              {
+                                  stack.push(me, t * perThread + i);
+                                  if (stack.pop(me, value))
+                                      sum += value;
+                              }
+                              while (stack.pop(me, value))
+                                  sum += value; });
+    }
+
+    for (std::thread &th : pool)
+        th.join();
+
+    return sum;
+}
+
+TEST_CASE("EPOCH BASED RECLAMATION", "[EBR]")
+{
+    SECTION("RETIRED NODES ARE FREED AFTER TWO EPOCHS")
+    {
+        {
+            EpochDomain domain(1);
+            EpochDomain::Participant me(domain);
+
+            me.retire(new Tracked);
+            REQUIRE(Tracked::alive == 1);
+
+            me.collect();
+            me.collect();
+            REQUIRE(Tracked::alive == 0);
+            REQUIRE(me.pending() == 0);
+        }
+        REQUIRE(Tracked::alive == 0);
+    }
+
+    SECTION("A PINNED THREAD BLOCKS RECLAMATION")
+    {
+        EpochDomain domain(1);
+        EpochDomain::Participant reader(domain), writer(domain);
+        {
+            auto guard = reader.pin();
+            unsigned long long e = domain.epoch();
+
+            writer.retire(new Tracked);
+            for (int i = 0; i < 10; i++)
+                writer.collect();
+
+            REQUIRE(domain.epoch() <= e + 1);
+            REQUIRE(Tracked::alive == 1);
+        }
+
+        writer.collect();
+        writer.collect();
+        REQUIRE(Tracked::alive == 0);
+    }
+
+    SECTION("DOMAIN FREES LEFTOVERS")
+    {
+        {
+            EpochDomain domain;
+            EpochDomain::Participant me(domain);
+            for (int i = 0; i < 10; i++)
+                me.retire(new Tracked);
+        }
+        REQUIRE(Tracked::alive == 0);
+    }
+
+    SECTION("STRESS")
+    {
+        const int THREADS = 8, N = 20000;
+        {
+            EpochDomain domain;
+            EpochStack stack;
+
+            long long sum = stress(domain, stack, THREADS, N);
+            REQUIRE(sum == (long long)THREADS * N * (THREADS * N - 1) / 2);
+        }
+        REQUIRE(Tracked::alive == 0);
+    }
+}
+
+TEST_CASE("HAZARD POINTERS", "[HP]")
+{
+    SECTION("PROTECTED NODES ARE NOT FREED")
+    {
+        HazardDomain domain(1);
+        HazardDomain::Participant reader(domain), writer(domain);
+        std::atomic<Tracked *> shared{new Tracked};
+
+        Tracked *node = reader.protect(0, shared);
+        shared.store(nullptr);
+        writer.retire(node);
+        REQUIRE(Tracked::alive == 1);
+        REQUIRE(writer.pending() == 1);
+
+        reader.clear(0);
+        writer.collect();
+        REQUIRE(Tracked::alive == 0);
+    }
+
+    SECTION("STRESS")
+    {
+        const int THREADS = 8, N = 20000;
+        {
+            HazardDomain domain;
+            HazardStack stack;
+
+            long long sum = stress(domain, stack, THREADS, N);
+            REQUIRE(sum == (long long)THREADS * N * (THREADS * N - 1) / 2);
+        }
+        REQUIRE(Tracked::alive == 0);
+    }
+}
@@ -0,0 +1,153 @@
+/**
+ * @file count_min_sketch.hpp
+ * @author Ivan Penev
+ * @brief Count-min sketch - frequency estimates of a stream in fixed memory
+ * @date 2026-10-18
+ *
+ * depth rows of width counters. A key adds to one counter per row and its
+ * estimate is the smallest of its counters. Collisions only add, so the
+ * estimate never undercounts. With width = ceil(e / epsilon) and
+ * depth = ceil(ln(1 / delta)), an estimate exceeds the true count by more
+ * than epsilon * N (N - total count added) with probability at most delta.
+ *
+ * Sketches with the same dimensions can be merged by adding the counters,
+ * so every thread or shard may count its part of the stream on its own.
+ */
+
+#ifndef COUNT_MIN_SKETCH_HPP_GUARD_
+#define COUNT_MIN_SKETCH_HPP_GUARD_
+
+#include <algorithm> // std::min
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept> // Exception handling
+#include <vector>
+
+#include "../Filters/filter_hash.hpp"
+
+namespace ds
+{
+    template <typename DataType>
+    class CountMinSketch
+    {
+    private:
+        std::vector<uint64_t> counters; // depth rows of width
+        size_t width, depth;
+        uint64_t total = 0;
+
+    public:
+        /**
+         * @brief Constructs a sketch with the given dimensions
+         * @throws std::invalid_argument when a dimension is 0
+         */
+        CountMinSketch(size_t width, size_t depth)
+            : counters(width * depth), width(width), depth(depth)
+        {
+            if (width == 0 || depth == 0)
+            {
+                throw std::invalid_argument("CountMinSketch: Invalid dimensions!");
+            }
+        }
+
+        /**
+         * @brief Constructs a sketch for the error bounds
+         *
+         * @param epsilon - overcount relative to the stream length
+         * @param delta - probability of exceeding that overcount
+         */
+        static CountMinSketch forError(double epsilon, double delta)
+        {
+            if (!(epsilon > 0 && delta > 0 && delta < 1))
+            {
+                throw std::invalid_argument("CountMinSketch: Invalid error bounds!");
+            }
+
+            return CountMinSketch((size_t)std::ceil(std::exp(1.0) / epsilon),
+                                  (size_t)std::ceil(std::log(1 / delta)));
+        }
+
+        /**
+         * @brief Counts a key
+         * @note Time complexity: O(depth)
+         * @return uint64_t - the new estimate of the key
+         */
+        uint64_t add(const DataType &key, uint64_t count = 1)
+        {
+            uint64_t h = filterHash(key);
+            uint64_t estimate = std::numeric_limits<uint64_t>::max();
+            for (size_t row = 0; row < depth; row++)
+            {
+                uint64_t &counter = counters[row * width + column(h, row)];
+                counter += count;
+                estimate = std::min(estimate, counter);
+            }
+            total += count;
+            return estimate;
+        }
+
+        /**
+         * @brief Estimates how many times the key was counted. Never less than
+         * the true count.
+         * @note Time complexity: O(depth)
+         */
+        uint64_t estimate(const DataType &key) const
+        {
+            uint64_t h = filterHash(key);
+            uint64_t estimate = std::numeric_limits<uint64_t>::max();
+            for (size_t row = 0; row < depth; row++)
+                estimate = std::min(estimate, counters[row * width + column(h, row)]);
+            return estimate;
+        }
+
+        /**
+         * @brief Adds the counts of another sketch of the same dimensions
+         * @note Time complexity: O(width * depth)
+         * @throws std::invalid_argument for different dimensions
+         */
+        void merge(const CountMinSketch &other)
+        {
+            if (width != other.width || depth != other.depth)
+            {
+                throw std::invalid_argument("CountMinSketch: Cannot merge sketches of different dimensions!");
+            }
+
+            for (size_t i = 0; i < counters.size(); i++)
+                counters[i] += other.counters[i];
+            total += other.total;
+        }
+
+        /**
+         * @brief Returns the total count added (N)
+         */
+        uint64_t totalCount() const { return total; }
+
+        /**
+         * @brief Returns epsilon: estimates exceed the true counts by at most
+         * epsilon * N with probability 1 - delta()
+         */
+        double epsilon() const { return std::exp(1.0) / width; }
+
+        /**
+         * @brief Returns delta: the probability that an estimate is off by
+         * more than epsilon() * N
+         */
+        double delta() const { return std::exp(-(double)depth); }
+
+        size_t rows() const { return depth; }
+
+        size_t columns() const { return width; }
+
+        //
+        /* Helpers */
+    private:
+        // Row hashes derived from one 64-bit hash (Kirsch-Mitzenmacher)
+        size_t column(uint64_t h, size_t row) const
+        {
+            uint32_t h1 = (uint32_t)h, h2 = (uint32_t)(h >> 32) | 1;
+            return (size_t)(((uint64_t)(uint32_t)(h1 + row * h2) * width) >> 32);
+        }
+    };
+} // namespace ds
+
+#endif // COUNT_MIN_SKETCH_HPP_GUARD_
@@ -0,0 +1,197 @@
+/**
+ * @file heavy_hitters.hpp
+ * @author Ivan Penev
+ * @brief Top-k most frequent keys of a stream in bounded memory
+ * @date 2026-10-18
+ *
+ * Every key is counted in a CountMinSketch. The k keys with the largest
+ * estimates so far are the leaders, kept in a hash map with their estimates
+ * and in a min-ordered ds::BinaryHeap which tells the smallest leader - the
+ * bar a new key has to clear. When a leader's estimate grows, a new heap entry
+ * is pushed and the old one goes stale; stale entries are skipped when they
+ * reach the top and the heap is rebuilt when they outnumber the leaders.
+ *
+ * Error bounds (N - stream length, epsilon and delta of the sketch):
+ *  - a reported count is never below the true count, and exceeds it by more
+ *    than epsilon * N only with probability delta;
+ *  - a key occurring c > N / k + epsilon * N times is reported (with
+ *    probability 1 - delta): had it stayed out, the k leaders would all have
+ *    estimates of at least c and true counts above c - epsilon * N, which
+ *    adds up to more than N.
+ *
+ * Instances with the same sketch dimensions are mergeable: count each shard
+ * or thread separately, then merge() them; the leaders of the result are
+ * chosen from the leaders of both by their estimates in the merged sketch.
+ */
+
+#ifndef HEAVY_HITTERS_HPP_GUARD_
+#define HEAVY_HITTERS_HPP_GUARD_
+
+#include <algorithm> // std::sort
+#include <cstdint>
+#include <stdexcept> // Exception handling
+#include <unordered_map>
+#include <utility> // std::pair
+#include <vector>
+
+#include "../Heap/binary_heap.hpp"
+#include "count_min_sketch.hpp"
+
+namespace ds
+{
+    template <typename DataType>
+    class HeavyHitters
+    {
+    private:
+        struct Entry
+        {
+            uint64_t count;
+            DataType key;
+
+            bool operator<(const Entry &other) const { return count < other.count; }
+        };
+
+        CountMinSketch<DataType> sketch;
+        const size_t k;
+
+        std::unordered_map<DataType, uint64_t> leaders;
+        BinaryHeap<Entry> bar; // smallest leader on top; may hold stale entries
+
+    public:
+        /**
+         * @brief Constructs an empty tracker
+         *
+         * @param k - number of keys to report
+         * @param epsilon, delta - error bounds of the counts (see CountMinSketch)
+         * @throws std::invalid_argument for k = 0 or invalid bounds
+         */
+        HeavyHitters(size_t k, double epsilon = 0.0001, double delta = 0.001)
+            : sketch(CountMinSketch<DataType>::forError(epsilon, delta)), k(k), bar(BinaryHeap<Entry>::less)
+        {
+            if (k == 0)
+            {
+                throw std::invalid_argument("HeavyHitters: k must be positive!");
+            }
+        }
+
+        /**
+         * @brief Counts an occurrence of a key
+         * @note Time complexity: O(depth) + O(logk) when the leaders change
+         */
+        void add(const DataType &key, uint64_t count = 1)
+        {
+            offer(key, sketch.add(key, count));
+        }
+
+        /**
+         * @brief Adds the counts and the leaders of another tracker
+         * @note Time complexity: O(sketch size + k logk)
+         * @throws std::invalid_argument for different sketch dimensions
+         */
+        void merge(const HeavyHitters &other)
+        {
+            sketch.merge(other.sketch);
+
+            std::vector<DataType> candidates;
+            for (const auto &leader : leaders)
+                candidates.push_back(leader.first);
+            for (const auto &leader : other.leaders)
+                candidates.push_back(leader.first);
+
+            leaders.clear();
+            bar = BinaryHeap<Entry>(BinaryHeap<Entry>::less);
+            for (const DataType &key : candidates)
+            {
+                if (!leaders.count(key))
+                    offer(key, sketch.estimate(key));
+            }
+        }
+
+        /**
+         * @brief Returns the leaders with their estimated counts, most
+         * frequent first
+         * @note Time complexity: O(k logk)
+         */
+        std::vector<std::pair<DataType, uint64_t>> top() const
+        {
+            std::vector<std::pair<DataType, uint64_t>> result(leaders.begin(), leaders.end());
+            std::sort(result.begin(), result.end(),
+                      [](const std::pair<DataType, uint64_t> &lhs, const std::pair<DataType, uint64_t> &rhs)
+                      { return lhs.second > rhs.second; });
+            return result;
+        }
+
+        /**
+         * @brief Estimates the count of any key, leader or not
+         */
+        uint64_t estimate(const DataType &key) const { return sketch.estimate(key); }
+
+        /**
+         * @brief Returns the stream length so far (N)
+         */
+        uint64_t totalCount() const { return sketch.totalCount(); }
+
+        /**
+         * @brief Returns the bound of the overcount of the reported counts
+         * (exceeded with probability delta)
+         */
+        double errorBound() const { return sketch.epsilon() * sketch.totalCount(); }
+
+        const CountMinSketch<DataType> &counts() const { return sketch; }
+
+        //
+        /* Helpers */
+    private:
+        // Makes key a leader if its estimate clears the bar
+        void offer(const DataType &key, uint64_t estimate)
+        {
+            auto leader = leaders.find(key);
+            if (leader != leaders.end())
+            {
+                leader->second = estimate;
+                bar.push(Entry{estimate, key});
+            }
+            else if (leaders.size() < k)
+            {
+                leaders.emplace(key, estimate);
+                bar.push(Entry{estimate, key});
+            }
+            else
+            {
+                dropStale();
+                if (estimate <= bar.top().count)
+                    return;
+
+                leaders.erase(bar.top().key);
+                bar.pop();
+                leaders.emplace(key, estimate);
+                bar.push(Entry{estimate, key});
+            }
+
+            if (bar.size() > 4 * k)
+                rebuild();
+        }
+
+        // Pops the entries which no longer describe a leader
+        void dropStale()
+        {
+            for (;;)
+            {
+                const Entry &entry = bar.top();
+                auto leader = leaders.find(entry.key);
+                if (leader != leaders.end() && leader->second == entry.count)
+                    return;
+                bar.pop();
+            }
+        }
+
+        void rebuild()
+        {
+            bar = BinaryHeap<Entry>(BinaryHeap<Entry>::less);
+            for (const auto &leader : leaders)
+                bar.push(Entry{leader.second, leader.first});
+        }
+    };
+} // namespace ds
+
+#endif // HEAVY_HITTERS_HPP_GUARD_
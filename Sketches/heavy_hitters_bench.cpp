@@ -0,0 +1,99 @@
+// Events per second per core of HeavyHitters on a Zipf-distributed stream,
+// the cost of merging per-thread trackers, and how many of the true top-k
+// keys were reported.
+//
+// g++ -std=c++17 -O2 -pthread heavy_hitters_bench.cpp -o heavy_hitters_bench
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "heavy_hitters.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+static double seconds(Clock::time_point since)
+{
+    return std::chrono::duration<double>(Clock::now() - since).count();
+}
+
+// Zipf(s) over keys 0..n-1 by inverting the cumulative distribution
+static std::vector<uint64_t> zipfStream(size_t length, size_t n, double s, unsigned seed)
+{
+    std::vector<double> cumulative(n);
+    double sum = 0;
+    for (size_t i = 0; i < n; i++)
+        cumulative[i] = sum += 1 / std::pow(i + 1, s);
+
+    std::mt19937_64 rng(seed);
+    std::uniform_real_distribution<double> uniform(0, sum);
+    std::vector<uint64_t> stream(length);
+    for (uint64_t &key : stream)
+        key = std::lower_bound(cumulative.begin(), cumulative.end(), uniform(rng)) - cumulative.begin();
+    return stream;
+}
+
+int main()
+{
+    const size_t EVENTS = 20000000, KEYS = 10000000, K = 100;
+    const unsigned THREADS = 4;
+
+    for (double s : {0.8, 1.0, 1.2})
+    {
+        std::vector<uint64_t> stream = zipfStream(EVENTS, KEYS, s, 1);
+
+        ds::HeavyHitters<uint64_t> single(K);
+        auto start = Clock::now();
+        for (uint64_t key : stream)
+            single.add(key);
+        double perCore = EVENTS / seconds(start);
+
+        // Sharded: every thread counts a slice, then the trackers are merged
+        std::vector<ds::HeavyHitters<uint64_t>> shards(THREADS, ds::HeavyHitters<uint64_t>(K));
+        std::vector<std::thread> threads;
+        for (unsigned t = 0; t < THREADS; t++)
+            threads.emplace_back([&, t]
+                                 {
+                                     for (size_t i = t; i < EVENTS; i += THREADS)
+                                         shards[t].add(stream[i]); });
+        for (std::thread &thread : threads)
+            thread.join();
+
+        start = Clock::now();
+        for (unsigned t = 1; t < THREADS; t++)
+            shards[0].merge(shards[t]);
+        double merge = seconds(start);
+
+        // Recall against the exact top-k
+        std::unordered_map<uint64_t, uint64_t> exact;
+        for (uint64_t key : stream)
+            exact[key]++;
+        std::vector<std::pair<uint64_t, uint64_t>> sorted(exact.begin(), exact.end());
+        std::partial_sort(sorted.begin(), sorted.begin() + K, sorted.end(),
+                          [](const std::pair<uint64_t, uint64_t> &a, const std::pair<uint64_t, uint64_t> &b)
+                          { return a.second > b.second; });
+
+        auto recall = [&](const ds::HeavyHitters<uint64_t> &hitters)
+        {
+            auto top = hitters.top();
+            size_t hits = 0;
+            for (size_t i = 0; i < K; i++)
+                hits += std::any_of(top.begin(), top.end(), [&](const std::pair<uint64_t, uint64_t> &leader)
+                                    { return leader.first == sorted[i].first; });
+            return hits;
+        };
+
+        std::cout << "zipf s=" << s
+                  << "\t" << perCore / 1e6 << " M events/s per core"
+                  << "\tmerge of " << THREADS << " shards: " << merge * 1e3 << " ms"
+                  << "\ttop-" << K << " recall: " << recall(single) << " single, " << recall(shards[0]) << " merged"
+                  << "\t(sketch " << single.counts().columns() << "x" << single.counts().rows() << ")" << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,129 @@
+#define CATCH_CONFIG_MAIN
+#include "../Catch2/catch.hpp"
+#include "heavy_hitters.hpp"
+
+#include <algorithm>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+using namespace ds;
+
+// Skewed stream: key i has weight 1 / (i + 1)
+static std::vector<int> zipfStream(size_t length, int keys, unsigned seed)
+{
+    std::vector<double> weights(keys);
+    for (int i = 0; i < keys; i++)
+        weights[i] = 1.0 / (i + 1);
+
+    std::mt19937 rng(seed);
+    std::discrete_distribution<int> pick(weights.begin(), weights.end());
+    std::vector<int> stream(length);
+    for (int &key : stream)
+        key = pick(rng);
+    return stream;
+}
+
+TEST_CASE("COUNT-MIN SKETCH", "[ADD][ESTIMATE][MERGE]")
+{
+    REQUIRE_THROWS_AS(CountMinSketch<int>(0, 4), std::invalid_argument);
+    REQUIRE_THROWS_AS(CountMinSketch<int>::forError(0.01, 1.5), std::invalid_argument);
+
+    CountMinSketch<int> sketch = CountMinSketch<int>::forError(0.001, 0.01);
+    REQUIRE(sketch.columns() == 2719);
+    REQUIRE(sketch.rows() == 5);
+
+    std::vector<int> stream = zipfStream(200000, 50000, 1);
+    std::unordered_map<int, uint64_t> exact;
+    for (int key : stream)
+    {
+        sketch.add(key);
+        exact[key]++;
+    }
+    REQUIRE(sketch.totalCount() == stream.size());
+
+    SECTION("NEVER UNDERCOUNTS, RARELY OVER THE BOUND")
+    {
+        const double bound = sketch.epsilon() * sketch.totalCount();
+        int over = 0;
+        for (int key = 0; key < 50000; key++)
+        {
+            uint64_t estimate = sketch.estimate(key);
+            REQUIRE(estimate >= exact[key]);
+            over += estimate > exact[key] + bound;
+        }
+        REQUIRE(over <= 50000 * 0.01);
+    }
+
+    SECTION("MERGE")
+    {
+        CountMinSketch<int> other = CountMinSketch<int>::forError(0.001, 0.01);
+        other.add(7, 1000);
+        sketch.merge(other);
+
+        REQUIRE(sketch.estimate(7) >= exact[7] + 1000);
+        REQUIRE(sketch.totalCount() == stream.size() + 1000);
+        REQUIRE_THROWS_AS(sketch.merge(CountMinSketch<int>(10, 5)), std::invalid_argument);
+    }
+}
+
+TEST_CASE("HEAVY HITTERS", "[ADD][TOP][MERGE]")
+{
+    REQUIRE_THROWS_AS(HeavyHitters<int>(0), std::invalid_argument);
+
+    const size_t K = 20;
+    std::vector<int> stream = zipfStream(300000, 100000, 2);
+    std::unordered_map<int, uint64_t> exact;
+    for (int key : stream)
+        exact[key]++;
+
+    // The keys of the weights 1, 1/2, ... are the most frequent
+    auto requireLeaders = [&](const HeavyHitters<int> &hitters)
+    {
+        auto top = hitters.top();
+        REQUIRE(top.size() == K);
+
+        for (size_t i = 0; i < top.size(); i++)
+        {
+            if (i > 0)
+                REQUIRE(top[i - 1].second >= top[i].second);
+            REQUIRE(top[i].second >= exact[top[i].first]);
+            REQUIRE(top[i].second <= exact[top[i].first] + hitters.errorBound());
+        }
+
+        // Everything above N / k + epsilon * N is reported
+        double threshold = (double)hitters.totalCount() / K + hitters.errorBound();
+        for (const auto &counted : exact)
+        {
+            if (counted.second > threshold)
+                REQUIRE(std::find_if(top.begin(), top.end(), [&counted](const std::pair<int, uint64_t> &leader)
+                                     { return leader.first == counted.first; }) != top.end());
+        }
+
+        // The ten heaviest keys are clear of the noise
+        for (int key = 0; key < 10; key++)
+            REQUIRE(std::find_if(top.begin(), top.end(), [key](const std::pair<int, uint64_t> &leader)
+                                 { return leader.first == key; }) != top.end());
+    };
+
+    SECTION("SINGLE STREAM")
+    {
+        HeavyHitters<int> hitters(K, 0.0005, 0.001);
+        for (int key : stream)
+            hitters.add(key);
+        requireLeaders(hitters);
+    }
+
+    SECTION("MERGED SHARDS")
+    {
+        std::vector<HeavyHitters<int>> shards(4, HeavyHitters<int>(K, 0.0005, 0.001));
+        for (size_t i = 0; i < stream.size(); i++)
+            shards[i % 4].add(stream[i]);
+
+        for (size_t s = 1; s < shards.size(); s++)
+            shards[0].merge(shards[s]);
+
+        REQUIRE(shards[0].totalCount() == stream.size());
+        requireLeaders(shards[0]);
+    }
+}
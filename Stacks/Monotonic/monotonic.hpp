@@ -0,0 +1,254 @@
+/**
+ * @file monotonic.hpp
+ * @author Ivan Penev
+ * @brief Monotonic stack and monotonic deque
+ * @date 2026-10-18
+ *
+ * Both containers keep their elements ordered by the comparator: a new element
+ * evicts every element on its side which compares less than it (cmp(old, new)),
+ * so with the default `less` the elements decrease from the oldest to the
+ * newest and the oldest is the largest. Each element is pushed and evicted at
+ * most once, which turns the classic scan-back kernels into single passes:
+ *
+ *  - next greater element: an element evicted from a MonotonicStack was
+ *    evicted by its next greater element;
+ *  - sliding-window maximum: the front of a MonotonicDeque is the maximum of
+ *    the elements pushed since the front was last popped.
+ *
+ * Equal elements do not evict each other. The push functions can report every
+ * evicted element together with the element which evicted it; push_range
+ * feeds a whole sequence this way.
+ */
+
+#ifndef MONOTONIC_HPP_GUARD_
+#define MONOTONIC_HPP_GUARD_
+
+#include <cstddef>
+#include <stdexcept> // Exception handling
+#include <vector>
+
+namespace ds
+{
+    template <typename DataType, typename Compare = bool (*)(const DataType &, const DataType &)>
+    class MonotonicStack
+    {
+    private:
+        std::vector<DataType> container; // bottom first
+        Compare cmp;
+
+    public:
+        static bool less(const DataType &lhs, const DataType &rhs) { return lhs < rhs; }
+
+        static bool greater(const DataType &lhs, const DataType &rhs) { return lhs > rhs; }
+
+        /**
+         * @brief Constructs an empty stack
+         *
+         * @param cmp - elements x with cmp(x, new) are evicted by new; the
+         * default keeps the stack decreasing from the bottom
+         */
+        MonotonicStack(Compare cmp = less) : cmp(cmp) {}
+
+        /**
+         * @brief Evicts the elements less than data and puts data on top
+         * @note Time complexity: O(1) amortized
+         */
+        void push(const DataType &data)
+        {
+            push(data, [](const DataType &, const DataType &) {});
+        }
+
+        /**
+         * @brief Like push(data), calling onEvict(evicted, data) for every
+         * evicted element, the nearest first
+         */
+        template <typename Callback>
+        void push(const DataType &data, Callback onEvict)
+        {
+            while (!container.empty() && cmp(container.back(), data))
+            {
+                onEvict(container.back(), data);
+                container.pop_back();
+            }
+            container.push_back(data);
+        }
+
+        /**
+         * @brief Pushes every element of [first, last) in order
+         * @note Time complexity: O(N)
+         */
+        template <typename Iterator, typename Callback>
+        void push_range(Iterator first, Iterator last, Callback onEvict)
+        {
+            for (; first != last; ++first)
+                push(*first, onEvict);
+        }
+
+        /**
+         * @brief Removes the top element
+         * @throws std::underflow_error when the stack is empty
+         */
+        void pop()
+        {
+            if (container.empty())
+            {
+                throw std::underflow_error("MonotonicStack: Stack is empty!");
+            }
+
+            container.pop_back();
+        }
+
+        /**
+         * @brief Returns the newest, smallest element
+         * @throws std::underflow_error when the stack is empty
+         */
+        const DataType &top() const
+        {
+            if (container.empty())
+            {
+                throw std::underflow_error("MonotonicStack: Stack is empty!");
+            }
+
+            return container.back();
+        }
+
+        /**
+         * @brief Returns an element by its position, 0 being the bottom
+         */
+        const DataType &operator[](size_t index) const { return container[index]; }
+
+        size_t size() const { return container.size(); }
+
+        bool isEmpty() const { return container.empty(); }
+
+        void clear() { container.clear(); }
+    };
+
+    template <typename DataType, typename Compare = bool (*)(const DataType &, const DataType &)>
+    class MonotonicDeque
+    {
+    private:
+        // Elements [head, size()) are in the deque; the popped prefix is cut
+        // off once it is half of the buffer
+        std::vector<DataType> container;
+        size_t head = 0;
+        Compare cmp;
+
+    public:
+        static bool less(const DataType &lhs, const DataType &rhs) { return lhs < rhs; }
+
+        static bool greater(const DataType &lhs, const DataType &rhs) { return lhs > rhs; }
+
+        /**
+         * @brief Constructs an empty deque
+         *
+         * @param cmp - elements x with cmp(x, new) are evicted by new; the
+         * default keeps the largest element at the front
+         */
+        MonotonicDeque(Compare cmp = less) : cmp(cmp) {}
+
+        /**
+         * @brief Evicts the elements at the back less than data and appends data
+         * @note Time complexity: O(1) amortized
+         */
+        void push_back(const DataType &data)
+        {
+            push_back(data, [](const DataType &, const DataType &) {});
+        }
+
+        /**
+         * @brief Like push_back(data), calling onEvict(evicted, data) for every
+         * evicted element, the newest first
+         */
+        template <typename Callback>
+        void push_back(const DataType &data, Callback onEvict)
+        {
+            while (container.size() > head && cmp(container.back(), data))
+            {
+                onEvict(container.back(), data);
+                container.pop_back();
+            }
+            container.push_back(data);
+        }
+
+        /**
+         * @brief Appends every element of [first, last) in order
+         * @note Time complexity: O(N)
+         */
+        template <typename Iterator, typename Callback>
+        void push_range(Iterator first, Iterator last, Callback onEvict)
+        {
+            for (; first != last; ++first)
+                push_back(*first, onEvict);
+        }
+
+        /**
+         * @brief Removes the oldest element
+         * @note Time complexity: O(1) amortized
+         * @throws std::underflow_error when the deque is empty
+         */
+        void pop_front()
+        {
+            if (isEmpty())
+            {
+                throw std::underflow_error("MonotonicDeque: Deque is empty!");
+            }
+
+            if (++head == container.size())
+            {
+                container.clear();
+                head = 0;
+            }
+            else if (head >= container.size() / 2 && head >= 32)
+            {
+                container.erase(container.begin(), container.begin() + head);
+                head = 0;
+            }
+        }
+
+        /**
+         * @brief Returns the oldest, largest element
+         * @throws std::underflow_error when the deque is empty
+         */
+        const DataType &front() const
+        {
+            if (isEmpty())
+            {
+                throw std::underflow_error("MonotonicDeque: Deque is empty!");
+            }
+
+            return container[head];
+        }
+
+        /**
+         * @brief Returns the newest, smallest element
+         * @throws std::underflow_error when the deque is empty
+         */
+        const DataType &back() const
+        {
+            if (isEmpty())
+            {
+                throw std::underflow_error("MonotonicDeque: Deque is empty!");
+            }
+
+            return container.back();
+        }
+
+        /**
+         * @brief Returns an element by its position, 0 being the front
+         */
+        const DataType &operator[](size_t index) const { return container[head + index]; }
+
+        size_t size() const { return container.size() - head; }
+
+        bool isEmpty() const { return container.size() == head; }
+
+        void clear()
+        {
+            container.clear();
+            head = 0;
+        }
+    };
+} // namespace ds
+
+#endif // MONOTONIC_HPP_GUARD_
@@ -0,0 +1,86 @@
+// Single-pass kernels on monotonic containers against the scan-back versions:
+// sliding-window maximum (rescan of the window per sample vs MonotonicDeque)
+// and next greater element (scan forward per element vs MonotonicStack).
+//
+// g++ -std=c++17 -O2 monotonic_bench.cpp -o monotonic_bench
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "monotonic.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+static long long checksum = 0;
+
+template <typename Kernel>
+static void measure(const char *name, size_t n, Kernel kernel)
+{
+    auto start = Clock::now();
+    kernel();
+    double total = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    std::cout << "  " << name << ": " << total / n << " ns/element\n";
+}
+
+int main()
+{
+    const size_t N = 1 << 20;
+    std::mt19937 rng(7);
+    std::vector<int> values(N);
+    for (int &value : values)
+        value = (int)(rng() >> 1);
+
+    for (size_t window : {8, 64, 1024})
+    {
+        std::cout << "sliding maximum, W = " << window << "\n";
+
+        measure("rescan        ", N, [&]
+                {
+                    for (size_t i = window; i <= N; i++)
+                        checksum += *std::max_element(values.begin() + (i - window), values.begin() + i); });
+
+        measure("MonotonicDeque", N, [&]
+                {
+                    ds::MonotonicDeque<int> deq;
+                    for (size_t i = 0; i < N; i++)
+                    {
+                        deq.push_back(values[i]);
+                        if (i >= window && deq.front() == values[i - window])
+                            deq.pop_front();
+                        if (i + 1 >= window)
+                            checksum += deq.front();
+                    } });
+    }
+
+    // Slowly decreasing input keeps the forward scans long
+    std::vector<int> trend(N);
+    for (size_t i = 0; i < N; i++)
+        trend[i] = (int)(N - i) * 4 + (int)(rng() % 1024);
+
+    std::cout << "next greater element, drifting input\n";
+    measure("scan forward  ", N, [&]
+            {
+                for (size_t i = 0; i < N; i++)
+                {
+                    size_t j = i + 1;
+                    while (j < N && trend[j] <= trend[i])
+                        ++j;
+                    checksum += j;
+                } });
+
+    measure("MonotonicStack", N, [&]
+            {
+                auto byValue = [&](const size_t &lhs, const size_t &rhs)
+                { return trend[lhs] < trend[rhs]; };
+                ds::MonotonicStack<size_t, decltype(byValue)> stk(byValue);
+                for (size_t i = 0; i < N; i++)
+                    stk.push(i, [&](size_t, size_t by)
+                             { checksum += by; });
+                checksum += stk.size() * N; });
+
+    std::cout << "(checksum " << checksum << ")\n";
+    return 0;
+}
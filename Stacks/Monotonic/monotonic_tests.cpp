@@ -0,0 +1,158 @@
+#define CATCH_CONFIG_MAIN
+#include "../../Catch2/catch.hpp"
+#include "monotonic.hpp"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace ds;
+
+static std::vector<int> randomValues(size_t n, unsigned seed)
+{
+    std::mt19937 rng(seed);
+    std::vector<int> values(n);
+    for (int &value : values)
+        value = (int)(rng() % 50); // plenty of duplicates
+    return values;
+}
+
+TEST_CASE("MONOTONIC STACK", "[PUSH][POP][TOP]")
+{
+    SECTION("ORDER")
+    {
+        MonotonicStack<int> stk;
+        for (int value : {5, 3, 4, 4, 1, 2})
+            stk.push(value);
+
+        // 3 was evicted by 4, 1 by 2; equal elements stay
+        REQUIRE(stk.size() == 4);
+        REQUIRE(stk[0] == 5);
+        REQUIRE(stk[1] == 4);
+        REQUIRE(stk[2] == 4);
+        REQUIRE(stk.top() == 2);
+
+        stk.pop();
+        REQUIRE(stk.top() == 4);
+    }
+
+    SECTION("EMPTY")
+    {
+        MonotonicStack<int> stk;
+        REQUIRE(stk.isEmpty());
+        REQUIRE_THROWS_AS(stk.pop(), std::underflow_error);
+        REQUIRE_THROWS_AS(stk.top(), std::underflow_error);
+    }
+
+    SECTION("NEXT GREATER ELEMENT")
+    {
+        std::vector<int> values = randomValues(2000, 1);
+
+        // Indices compared by their values
+        auto byValue = [&](const size_t &lhs, const size_t &rhs)
+        { return values[lhs] < values[rhs]; };
+        MonotonicStack<size_t, decltype(byValue)> stk(byValue);
+
+        std::vector<int> next(values.size(), -1);
+        std::vector<size_t> indices(values.size());
+        for (size_t i = 0; i < indices.size(); i++)
+            indices[i] = i;
+
+        stk.push_range(indices.begin(), indices.end(), [&](size_t evicted, size_t by)
+                       { next[evicted] = (int)by; });
+
+        for (size_t i = 0; i < values.size(); i++)
+        {
+            int expected = -1;
+            for (size_t j = i + 1; j < values.size() && expected < 0; j++)
+            {
+                if (values[j] > values[i])
+                    expected = (int)j;
+            }
+            REQUIRE(next[i] == expected);
+        }
+    }
+
+    SECTION("GREATER")
+    {
+        MonotonicStack<int> stk(MonotonicStack<int>::greater);
+        std::vector<int> evicted;
+        for (int value : {1, 3, 5, 2})
+            stk.push(value, [&](int element, int)
+                     { evicted.push_back(element); });
+
+        REQUIRE(evicted == std::vector<int>{5, 3});
+        REQUIRE(stk.size() == 2);
+        REQUIRE(stk.top() == 2);
+    }
+}
+
+TEST_CASE("MONOTONIC DEQUE", "[PUSH][POP][FRONT]")
+{
+    SECTION("EMPTY")
+    {
+        MonotonicDeque<int> deq;
+        REQUIRE(deq.isEmpty());
+        REQUIRE_THROWS_AS(deq.pop_front(), std::underflow_error);
+        REQUIRE_THROWS_AS(deq.front(), std::underflow_error);
+        REQUIRE_THROWS_AS(deq.back(), std::underflow_error);
+    }
+
+    SECTION("SLIDING WINDOW MAXIMUM")
+    {
+        std::vector<int> values = randomValues(5000, 2);
+
+        for (size_t window : {1, 3, 17, 200})
+        {
+            MonotonicDeque<int> deq;
+            for (size_t i = 0; i < values.size(); i++)
+            {
+                deq.push_back(values[i]);
+                // The leaving value is still there unless something larger evicted it
+                if (i >= window && deq.front() == values[i - window])
+                    deq.pop_front();
+
+                size_t first = i + 1 >= window ? i + 1 - window : 0;
+                int expected = *std::max_element(values.begin() + first, values.begin() + i + 1);
+                REQUIRE(deq.front() == expected);
+            }
+        }
+    }
+
+    SECTION("SLIDING WINDOW MINIMUM OF INDICES")
+    {
+        std::vector<int> values = randomValues(3000, 3);
+        auto byValue = [&](const size_t &lhs, const size_t &rhs)
+        { return values[lhs] > values[rhs]; };
+        MonotonicDeque<size_t, decltype(byValue)> deq(byValue);
+
+        const size_t window = 50;
+        for (size_t i = 0; i < values.size(); i++)
+        {
+            deq.push_back(i);
+            while (deq.front() + window <= i)
+                deq.pop_front();
+
+            size_t first = i + 1 >= window ? i + 1 - window : 0;
+            int expected = *std::min_element(values.begin() + first, values.begin() + i + 1);
+            REQUIRE(values[deq.front()] == expected);
+            REQUIRE(deq.size() <= window);
+        }
+    }
+
+    SECTION("PUSH RANGE")
+    {
+        std::vector<int> values = {4, 2, 12, 3, 8};
+        std::vector<std::pair<int, int>> evictions;
+
+        MonotonicDeque<int> deq;
+        deq.push_range(values.begin(), values.end(), [&](int evicted, int by)
+                       { evictions.push_back({evicted, by}); });
+
+        REQUIRE(evictions == std::vector<std::pair<int, int>>{{2, 12}, {4, 12}, {3, 8}});
+        REQUIRE(deq.size() == 2);
+        REQUIRE(deq.front() == 12);
+        REQUIRE(deq.back() == 8);
+        REQUIRE(deq[1] == 8);
+    }
+}
@@ -0,0 +1,297 @@
+/**
+ * @file sliding_window.hpp
+ * @author Ivan Penev
+ * @brief Sliding-window aggregation over an associative combine function
+ * @date 2026-10-18
+ *
+ * A window is a FIFO queue of values whose aggregate - combine of all of them
+ * from the oldest to the newest - is available at any time. The combine
+ * function only has to be associative and to have an identity (a monoid):
+ * sum, min, max, gcd, matrix product, string concatenation... it need not be
+ * commutative or invertible, so nothing is ever "subtracted" from the result.
+ *
+ *     ds::TwoStacksAggregator<int> window(combineMax, INT_MIN);
+ *     window.push(sample);
+ *     if (window.size() > W) window.pop();
+ *     int maxOfLastW = window.query();
+ *
+ * TwoStacksAggregator is amortized O(1); DabaAggregator spreads the same
+ * work evenly and is O(1) in the worst case.
+ */
+
+#ifndef SLIDING_WINDOW_HPP_GUARD_
+#define SLIDING_WINDOW_HPP_GUARD_
+
+#include <cstddef>
+#include <deque>     // Storage of DabaAggregator
+#include <stdexcept> // Exception handling
+
+#include "../StackLinked/stack_linked.hpp"
+
+namespace ds
+{
+    /**
+     * @brief The classic queue of two stacks. New values go on the back stack
+     * which only keeps the aggregate of its values. The oldest value is popped
+     * from the front stack, every entry of which stores the aggregate of itself
+     * and everything newer in that stack. When the front stack runs out, the
+     * back stack is moved over and the aggregates are computed on the way.
+     */
+    template <typename DataType, typename Combine = DataType (*)(const DataType &, const DataType &)>
+    class TwoStacksAggregator
+    {
+    private:
+        struct Entry
+        {
+            DataType value;
+            DataType aggregate; // of value and all newer values in the front stack
+        };
+
+        Stack<Entry> front;
+        Stack<DataType> back;
+        DataType backAggregate;
+
+        Combine combine;
+        const DataType identity;
+
+    public:
+        /**
+         * @brief Constructs an empty window
+         *
+         * @param combine - associative function, called as combine(older, newer)
+         * @param identity - combine(identity, x) == combine(x, identity) == x
+         */
+        TwoStacksAggregator(Combine combine, const DataType &identity)
+            : backAggregate(identity), combine(combine), identity(identity) {}
+
+        /**
+         * @brief Adds the newest value
+         * @note Time complexity: O(1)
+         */
+        void push(const DataType &value)
+        {
+            back.push(value);
+            backAggregate = combine(backAggregate, value);
+        }
+
+        /**
+         * @brief Removes the oldest value
+         * @note Time complexity: amortized O(1)
+         * @throws std::underflow_error - when the window is empty
+         */
+        void pop()
+        {
+            if (front.empty())
+            {
+                if (back.empty())
+                {
+                    throw std::underflow_error("TwoStacksAggregator: Window is empty!");
+                }
+
+                // Newest first, so the oldest value ends up on top
+                while (!back.empty())
+                {
+                    DataType value = back.pop();
+                    front.push(Entry{value, front.empty() ? value : combine(value, front.top().aggregate)});
+                }
+                backAggregate = identity;
+            }
+
+            front.pop();
+        }
+
+        /**
+         * @brief Returns the aggregate of the whole window (identity when empty)
+         * @note Time complexity: O(1)
+         */
+        DataType query() const
+        {
+            return front.empty() ? backAggregate : combine(front.top().aggregate, backAggregate);
+        }
+
+        /**
+         * @brief Returns the number of values in the window
+         */
+        size_t size() const { return front.size() + back.size(); }
+
+        /**
+         * @brief Checks if the window is empty
+         */
+        bool isEmpty() const { return front.empty() && back.empty(); }
+    };
+
+    /**
+     * @brief Worst-case O(1) window in the spirit of DABA (De-Amortized Bankers
+     * Aggregator). The values live in one deque split into a front part, whose
+     * entries hold the aggregate up to the end of the front, and a back part
+     * summarized by a single aggregate. Instead of converting the back part in
+     * one go when the front runs out, the conversion starts as soon as the back
+     * is as long as the front and advances by one entry with every operation:
+     *  - first the old back part, right to left, so each entry gets the
+     *    aggregate of itself and the newer ones - this finishes before the
+     *    evictions reach it;
+     *  - then the remaining old front entries, each extended with the total
+     *    of the old back (no dependency between them).
+     * The next conversion cannot be due before this one is finished.
+     */
+    template <typename DataType, typename Combine = DataType (*)(const DataType &, const DataType &)>
+    class DabaAggregator
+    {
+    private:
+        struct Entry
+        {
+            DataType value;
+            DataType aggregate;
+        };
+
+        // Positions are counted from the first value ever pushed, so evictions
+        // do not move them; entries[p - evicted] holds position p
+        std::deque<Entry> entries;
+        size_t evicted = 0; // F - the oldest value
+        size_t frontEnd = 0; // B - the front part is [F, B)
+        DataType backAggregate;
+
+        // Conversion of the old back part [B, E0) into front entries
+        bool converting = false;
+        size_t convertEnd = 0;    // E0 - the new back part is [E0, end)
+        size_t backPass = 0;      // [backPass, E0) have their new aggregates
+        size_t frontPass = 0;     // [F, frontPass) include the old back total
+        DataType oldBackTotal;
+
+        Combine combine;
+        const DataType identity;
+
+    public:
+        /**
+         * @brief Constructs an empty window
+         *
+         * @param combine - associative function, called as combine(older, newer)
+         * @param identity - combine(identity, x) == combine(x, identity) == x
+         */
+        DabaAggregator(Combine combine, const DataType &identity)
+            : backAggregate(identity), oldBackTotal(identity), combine(combine), identity(identity) {}
+
+        /**
+         * @brief Adds the newest value
+         * @note Time complexity: O(1)
+         */
+        void push(const DataType &value)
+        {
+            entries.push_back(Entry{value, identity});
+            backAggregate = combine(backAggregate, value);
+            rebalance();
+        }
+
+        /**
+         * @brief Removes the oldest value
+         * @note Time complexity: O(1)
+         * @throws std::underflow_error - when the window is empty
+         */
+        void pop()
+        {
+            if (entries.empty())
+            {
+                throw std::underflow_error("DabaAggregator: Window is empty!");
+            }
+
+            entries.pop_front();
+            ++evicted;
+            rebalance();
+        }
+
+        /**
+         * @brief Returns the aggregate of the whole window (identity when empty)
+         * @note Time complexity: O(1)
+         */
+        DataType query() const
+        {
+            if (evicted == end())
+                return identity;
+
+            const size_t back = converting ? convertEnd : frontEnd;
+            if (evicted == back)
+                return backAggregate; // no front part
+
+            const DataType &aggregate = at(evicted).aggregate;
+            if (!converting || evicted >= frontEnd || evicted < frontPass)
+                return combine(aggregate, backAggregate);
+
+            // An old front entry which does not include the old back yet
+            return combine(combine(aggregate, oldBackTotal), backAggregate);
+        }
+
+        /**
+         * @brief Returns the number of values in the window
+         */
+        size_t size() const { return entries.size(); }
+
+        /**
+         * @brief Checks if the window is empty
+         */
+        bool isEmpty() const { return entries.empty(); }
+
+        //
+        /* Helpers */
+    private:
+        size_t end() const { return evicted + entries.size(); }
+
+        Entry &at(size_t position) { return entries[position - evicted]; }
+
+        const Entry &at(size_t position) const { return entries[position - evicted]; }
+
+        void rebalance()
+        {
+            if (evicted > frontEnd)
+                frontEnd = evicted; // the front part was emptied
+
+            if (!converting)
+            {
+                size_t frontSize = frontEnd - evicted, backSize = end() - frontEnd;
+                if (backSize == 0 || backSize < frontSize)
+                    return;
+
+                converting = true;
+                convertEnd = backPass = end();
+                frontPass = evicted;
+                oldBackTotal = backAggregate;
+                backAggregate = identity;
+            }
+
+            step();
+
+            // Cannot happen while the sizes stay balanced - kept as a safety net
+            while (converting && evicted >= frontEnd && evicted < backPass)
+                step();
+        }
+
+        // One unit of conversion work
+        void step()
+        {
+            if (frontPass < evicted)
+                frontPass = evicted; // evicted entries need no update
+
+            if (backPass > frontEnd && backPass > evicted)
+            {
+                --backPass;
+                Entry &entry = at(backPass);
+                entry.aggregate = backPass + 1 == convertEnd ? entry.value
+                                                            : combine(entry.value, at(backPass + 1).aggregate);
+            }
+            else if (frontPass < frontEnd)
+            {
+                Entry &entry = at(frontPass);
+                entry.aggregate = combine(entry.aggregate, oldBackTotal);
+                ++frontPass;
+            }
+
+            if ((backPass <= frontEnd || backPass <= evicted) && frontPass >= frontEnd)
+            {
+                // [F, E0) is one front part again
+                converting = false;
+                frontEnd = convertEnd;
+            }
+        }
+    };
+} // namespace ds
+
+#endif // SLIDING_WINDOW_HPP_GUARD_
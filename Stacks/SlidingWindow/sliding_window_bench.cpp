@@ -0,0 +1,82 @@
+// Rolling maximum over the last W samples of a stream: recomputing the window
+// on every sample against TwoStacksAggregator and DabaAggregator. Reports the
+// mean cost per sample and the slowest single sample.
+//
+// g++ -std=c++17 -O2 sliding_window_bench.cpp -o sliding_window_bench
+
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <deque>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "sliding_window.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+static int maximum(const int &lhs, const int &rhs) { return std::max(lhs, rhs); }
+
+static long long checksum = 0;
+
+template <typename Step>
+static void measure(const char *name, const std::vector<int> &samples, Step step)
+{
+    double slowest = 0;
+    auto start = Clock::now();
+    for (int sample : samples)
+    {
+        auto before = Clock::now();
+        checksum += step(sample);
+        slowest = std::max(slowest, std::chrono::duration<double, std::nano>(Clock::now() - before).count());
+    }
+    double total = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+
+    std::cout << "  " << name << ": " << total / samples.size() << " ns/sample, slowest "
+              << slowest / 1000 << " us\n";
+}
+
+int main()
+{
+    const size_t N = 2000000;
+    std::mt19937 rng(42);
+    std::vector<int> samples(N);
+    for (int &sample : samples)
+        sample = (int)(rng() >> 1);
+
+    for (size_t window : {16, 256, 4096, 65536})
+    {
+        std::cout << "W = " << window << "\n";
+
+        if (window <= 4096)
+        {
+            std::deque<int> recent;
+            measure("recompute", samples, [&](int sample)
+                    {
+                        recent.push_back(sample);
+                        if (recent.size() > window)
+                            recent.pop_front();
+                        return *std::max_element(recent.begin(), recent.end()); });
+        }
+
+        ds::TwoStacksAggregator<int> twoStacks(maximum, INT_MIN);
+        measure("two stacks", samples, [&](int sample)
+                {
+                    twoStacks.push(sample);
+                    if (twoStacks.size() > window)
+                        twoStacks.pop();
+                    return twoStacks.query(); });
+
+        ds::DabaAggregator<int> daba(maximum, INT_MIN);
+        measure("daba", samples, [&](int sample)
+                {
+                    daba.push(sample);
+                    if (daba.size() > window)
+                        daba.pop();
+                    return daba.query(); });
+    }
+
+    std::cout << "(checksum " << checksum << ")\n";
+    return 0;
+}
@@ -0,0 +1,136 @@
+#define CATCH_CONFIG_MAIN
+#include "../../Catch2/catch.hpp"
+#include "sliding_window.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <deque>
+#include <random>
+#include <string>
+
+using namespace ds;
+
+static int sum(const int &lhs, const int &rhs) { return lhs + rhs; }
+
+static int maximum(const int &lhs, const int &rhs) { return std::max(lhs, rhs); }
+
+// Not commutative - catches combining in the wrong order
+static std::string concat(const std::string &lhs, const std::string &rhs) { return lhs + rhs; }
+
+template <typename Window>
+static void checkAgainstRecomputation(Window &window, unsigned seed)
+{
+    std::mt19937 rng(seed);
+    std::deque<std::string> expected;
+
+    for (int op = 0; op < 20000; op++)
+    {
+        // Drifting push probability, so the window grows, shrinks and empties
+        int pushPercent = (op / 1000) % 2 ? 35 : 65;
+        if (expected.empty() || (int)(rng() % 100) < pushPercent)
+        {
+            std::string value(1, (char)('a' + rng() % 26));
+            window.push(value);
+            expected.push_back(value);
+        }
+        else
+        {
+            window.pop();
+            expected.pop_front();
+        }
+
+        std::string all;
+        for (const std::string &value : expected)
+            all += value;
+
+        REQUIRE(window.size() == expected.size());
+        REQUIRE(window.query() == all);
+    }
+}
+
+TEST_CASE("TWO STACKS AGGREGATOR", "[PUSH][POP][QUERY]")
+{
+    SECTION("EMPTY")
+    {
+        TwoStacksAggregator<int> window(sum, 0);
+
+        REQUIRE(window.isEmpty());
+        REQUIRE(window.size() == 0);
+        REQUIRE(window.query() == 0);
+        REQUIRE_THROWS_AS(window.pop(), std::underflow_error);
+    }
+
+    SECTION("FIXED WINDOW")
+    {
+        TwoStacksAggregator<int> window(maximum, INT_MIN);
+        int values[] = {3, 1, 4, 1, 5, 9, 2, 6, 5, 3, 5};
+        int expected[] = {3, 3, 4, 4, 5, 9, 9, 9, 6, 6, 5};
+
+        for (int i = 0; i < 11; i++)
+        {
+            window.push(values[i]);
+            if (window.size() > 3)
+                window.pop();
+            REQUIRE(window.query() == expected[i]);
+        }
+    }
+
+    SECTION("ORDER")
+    {
+        TwoStacksAggregator<std::string> window(concat, "");
+        checkAgainstRecomputation(window, 1);
+    }
+}
+
+TEST_CASE("DABA AGGREGATOR", "[PUSH][POP][QUERY]")
+{
+    SECTION("EMPTY")
+    {
+        DabaAggregator<int> window(sum, 0);
+
+        REQUIRE(window.isEmpty());
+        REQUIRE(window.query() == 0);
+        REQUIRE_THROWS_AS(window.pop(), std::underflow_error);
+
+        window.push(7);
+        window.pop();
+        REQUIRE(window.isEmpty());
+        REQUIRE(window.query() == 0);
+    }
+
+    SECTION("FIXED WINDOW")
+    {
+        DabaAggregator<int> window(sum, 0);
+
+        for (int i = 1; i <= 1000; i++)
+        {
+            window.push(i);
+            if (window.size() > 10)
+                window.pop();
+
+            int first = std::max(1, i - 9);
+            REQUIRE(window.query() == (first + i) * (i - first + 1) / 2);
+        }
+    }
+
+    SECTION("ORDER")
+    {
+        DabaAggregator<std::string> window(concat, "");
+        checkAgainstRecomputation(window, 2);
+    }
+
+    SECTION("FUNCTION OBJECT")
+    {
+        auto minimum = [](const int &lhs, const int &rhs) { return std::min(lhs, rhs); };
+        DabaAggregator<int, decltype(minimum)> window(minimum, INT_MAX);
+
+        window.push(5);
+        window.push(2);
+        window.push(8);
+        REQUIRE(window.query() == 2);
+
+        window.pop();
+        window.pop();
+        REQUIRE(window.query() == 8);
+    }
+}
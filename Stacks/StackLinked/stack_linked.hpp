@@ -3,6 +3,10 @@
 
 #include <stdexcept>
 
+#include "../../Common/allocation_seal.hpp"
+#include "../../Common/expected.hpp"
+#include "../../Common/latency_histogram.hpp"
+
 /* Basic LIFO - last-in first-out - linked stack */
 
 namespace ds
@@ -48,6 +52,29 @@ namespace ds
         // Complexity: O(1) Constant
         const DataType &top() const;
 
+        // Non-throwing pop(): an empty stack gives Errc::empty
+        // Complexity: O(1) Constant
+        Expected<DataType> try_pop();
+
+        // Non-throwing top(): an empty stack gives Errc::empty
+        // Complexity: O(1) Constant
+        Expected<DataType &> try_top();
+        Expected<const DataType &> try_top() const;
+
+        // Keep spare nodes, so that count elements fit without allocating
+        // Complexity: O(count)
+        void reserve(unsigned int count);
+
+        // Report every following allocation to the seal hook
+        // (see Common/allocation_seal.hpp)
+        void seal();
+        void unseal();
+        bool isSealed() const;
+
+        // Time push and pop into recorder (see Common/latency_histogram.hpp);
+        // nullptr turns it off
+        void setLatencyRecorder(LatencyRecorder *recorder);
+
     private:
         struct Node
         {
@@ -61,6 +88,10 @@ namespace ds
         Node *tos = nullptr;     // top of stack
         unsigned int m_size = 0; // size of stack
 
+        NodePool<Node> pool{"Stack"}; // spare nodes
+
+        LatencyRecorder *latency = nullptr;
+
         ///
         // Helpers
     private:
@@ -85,7 +116,7 @@ namespace ds
         // Check if tos is not pointing to nullptr
         if (srcTos)
         {
-            tos = new Node(srcTos->m_data);
+            tos = pool.create(srcTos->m_data);
             ++m_size;
             srcTos = srcTos->link;
 
@@ -94,7 +125,7 @@ namespace ds
             // srcTos != nullptr
             while (srcTos)
             {
-                prev->link = new Node(srcTos->m_data);
+                prev->link = pool.create(srcTos->m_data);
                 ++m_size;
 
                 prev = prev->link;
@@ -118,21 +149,30 @@ namespace ds
     template <class DataType>
     inline Stack<DataType>::~Stack()
     {
+        latency = nullptr; // the recorder may already be gone
         clear();
     }
 
     template <class DataType>
     inline void Stack<DataType>::clear()
     {
-        while (!this->empty())
-            this->pop();
+        // Frees the nodes directly, so that no pops are timed
+        while (tos)
+        {
+            Node *toRemove = tos;
+            tos = toRemove->link;
+            pool.destroy(toRemove);
+        }
+        m_size = 0;
     }
 
     template <class DataType>
     inline void Stack<DataType>::push(const DataType &element)
     {
+        LatencyScope timer(latency, LatencyOp::push);
+
         /* throws bad_alloc if allocation functions report failure to allocate storage. */
-        Node *newNode = new Node(element, tos);
+        Node *newNode = pool.create(element, tos);
         tos = newNode;
         ++m_size;
     }
@@ -140,15 +180,17 @@ namespace ds
     template <class DataType>
     inline DataType Stack<DataType>::pop()
     {
+        LatencyScope timer(latency, LatencyOp::pop);
+
         if (this->empty())
         {
-            throw std::underflow_error("Invalid Operation: Cannot pop from empty stack!");
+            DS_THROW(std::underflow_error, "Invalid Operation: Cannot pop from empty stack!");
         }
 
         Node *toRemove = tos;
         tos = toRemove->link;
         DataType dataCopy = toRemove->m_data;
-        delete toRemove;
+        pool.destroy(toRemove);
         --m_size;
 
         return dataCopy;
@@ -171,7 +213,7 @@ namespace ds
     {
         if (this->empty())
         {
-            throw std::underflow_error("Invalid Operation: Cannot pop from empty stack!");
+            DS_THROW(std::underflow_error, "Invalid Operation: Cannot pop from empty stack!");
         }
 
         return tos->m_data;
@@ -182,6 +224,69 @@ namespace ds
     {
         return const_cast<Stack &>(*this).top();
     }
+
+    template <class DataType>
+    inline void Stack<DataType>::reserve(unsigned int count)
+    {
+        pool.reserve(count);
+    }
+
+    template <class DataType>
+    inline void Stack<DataType>::seal()
+    {
+        pool.seal();
+    }
+
+    template <class DataType>
+    inline void Stack<DataType>::unseal()
+    {
+        pool.unseal();
+    }
+
+    template <class DataType>
+    inline bool Stack<DataType>::isSealed() const
+    {
+        return pool.isSealed();
+    }
+
+    template <class DataType>
+    inline void Stack<DataType>::setLatencyRecorder(LatencyRecorder *recorder)
+    {
+        latency = recorder;
+    }
+
+    template <class DataType>
+    inline Expected<DataType> Stack<DataType>::try_pop()
+    {
+        if (this->empty())
+        {
+            return Unexpected(Errc::empty);
+        }
+
+        return pop();
+    }
+
+    template <class DataType>
+    inline Expected<DataType &> Stack<DataType>::try_top()
+    {
+        if (this->empty())
+        {
+            return Unexpected(Errc::empty);
+        }
+
+        return tos->m_data;
+    }
+
+    template <class DataType>
+    inline Expected<const DataType &> Stack<DataType>::try_top() const
+    {
+        if (this->empty())
+        {
+            return Unexpected(Errc::empty);
+        }
+
+        return tos->m_data;
+    }
 }
 
 #endif // STACK_LINKED_GUARD
\ No newline at end of file
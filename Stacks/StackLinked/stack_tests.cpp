@@ -1,5 +1,6 @@
 #define CATCH_CONFIG_MAIN
 #include "../../Catch2/catch.hpp"
+#include "../../Common/catch_no_exceptions.hpp"
 #include "stack_linked.hpp"
 
 using namespace ds;
@@ -99,4 +100,26 @@ TEST_CASE("ABSTRACT OPERATIONS", "[PUSH][POP][INFORMATION]")
 
         REQUIRE_THROWS(stk.top());
     }
-}
\ No newline at end of file
+}
+
+TEST_CASE("TRY API", "[NOEXCEPT]")
+{
+    Stack<int> stk;
+
+    REQUIRE(stk.try_pop().error() == Errc::empty);
+    REQUIRE(stk.try_top().error() == Errc::empty);
+
+    stk.push(1);
+    stk.push(2);
+    *stk.try_top() = 5;
+
+    const Stack<int> &view = stk;
+    REQUIRE(*view.try_top() == 5);
+
+    Expected<int> popped = stk.try_pop();
+    REQUIRE(popped);
+    REQUIRE(*popped == 5);
+    REQUIRE(stk.try_pop().value() == 1);
+    REQUIRE(stk.try_pop().value_or(-1) == -1);
+    REQUIRE(stk.empty());
+}
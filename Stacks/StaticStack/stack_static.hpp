@@ -11,6 +11,8 @@
 
 #include <stdexcept>
 
+#include "../../Common/expected.hpp"
+
 /**
  * @brief An implementation of stack with fixed size
  * @param ValueType The type of the elements in the stack
@@ -35,7 +37,7 @@ public:
     {
         if (tos >= MAX_SIZE - 1)
         {
-            throw std::overflow_error("StaticStack: Stack overflow!");
+            DS_THROW(std::overflow_error, "StaticStack: Stack overflow!");
         }
 
         stack[++tos] = val;
@@ -50,7 +52,7 @@ public:
     {
         if (isEmpty())
         {
-            throw std::underflow_error("StaticStack: Stack is empty!");
+            DS_THROW(std::underflow_error, "StaticStack: Stack is empty!");
         }
 
         --tos;
@@ -66,7 +68,55 @@ public:
     {
         if (isEmpty())
         {
-            throw std::underflow_error("StaticStack: Stack is empty!");
+            DS_THROW(std::underflow_error, "StaticStack: Stack is empty!");
+        }
+
+        return stack[tos];
+    }
+
+    /**
+     * @brief Non-throwing push
+     * 
+     * @param val The element to be inserted at the top
+     * @return Errc::full when the stack is full
+     */
+    ds::Expected<void> try_push(const ValueType &val)
+    {
+        if (tos >= MAX_SIZE - 1)
+        {
+            return ds::Unexpected(ds::Errc::full);
+        }
+
+        stack[++tos] = val;
+        return ds::Expected<void>();
+    }
+
+    /**
+     * @brief Non-throwing pop
+     * 
+     * @return Errc::empty when container is empty
+     */
+    ds::Expected<void> try_pop()
+    {
+        if (isEmpty())
+        {
+            return ds::Unexpected(ds::Errc::empty);
+        }
+
+        --tos;
+        return ds::Expected<void>();
+    }
+
+    /**
+     * @brief Non-throwing top
+     * 
+     * @return The element at the top of container or Errc::empty
+     */
+    ds::Expected<ValueType> try_top() const
+    {
+        if (isEmpty())
+        {
+            return ds::Unexpected(ds::Errc::empty);
         }
 
         return stack[tos];
@@ -1,5 +1,6 @@
 #define CATCH_CONFIG_MAIN
 #include "../../Catch2/catch.hpp"
+#include "../../Common/catch_no_exceptions.hpp"
 #include "./stack_static.hpp"
 
 TEST_CASE("CONSTRUCTORS", "[DEFAULT]")
@@ -69,3 +70,20 @@ TEST_CASE("ABSTRACT OPERATIONS", "[PUSH][POP][TOP]")
         REQUIRE_THROWS(stk.top());
     }
 }
+
+TEST_CASE("TRY API", "[NOEXCEPT]")
+{
+    StaticStack<int, 2> stk;
+
+    REQUIRE(stk.try_pop().error() == ds::Errc::empty);
+    REQUIRE(stk.try_top().error() == ds::Errc::empty);
+
+    REQUIRE(stk.try_push(1));
+    REQUIRE(stk.try_push(2));
+    REQUIRE(stk.try_push(3).error() == ds::Errc::full);
+    REQUIRE(stk.size() == 2);
+
+    REQUIRE(stk.try_top().value() == 2);
+    REQUIRE(stk.try_pop());
+    REQUIRE(*stk.try_top() == 1);
+}
@@ -0,0 +1,194 @@
+/**
+ * @file trail_stack.hpp
+ * @author Ivan Penev
+ * @brief Stack with checkpoints for backtracking search
+ * @date 2026-10-18
+ *
+ * A backtracking solver records every change on a trail and, when a branch
+ * fails, undoes the changes made since the branch was entered. With ds::Stack
+ * that means one pop - and one node freed - per entry. Here the entries live
+ * in one contiguous buffer: mark() remembers the current size, rollback(mark)
+ * cuts the buffer back to it in one step. Marks nest like the search tree:
+ *
+ *     auto level = trail.mark();
+ *     assign(x, 1);                  // pushes the old value of x
+ *     if (!propagate())
+ *         trail.rollback(level, undo); // undo visits the entries newest first
+ *
+ * The buffer keeps its capacity, so a search which keeps going up and down
+ * allocates only while it reaches new depths.
+ */
+
+#ifndef TRAIL_STACK_HPP_GUARD_
+#define TRAIL_STACK_HPP_GUARD_
+
+#include <cstddef>
+#include <stdexcept> // Exception handling
+#include <vector>
+
+namespace ds
+{
+    template <typename DataType>
+    class TrailStack
+    {
+    public:
+        /**
+         * @brief A checkpoint; valid until it is rolled back past or released
+         */
+        class Mark
+        {
+        private:
+            friend TrailStack;
+
+            Mark(size_t level, size_t size) : level(level), size(size) {}
+
+            size_t level; // index in marks
+            size_t size;  // entries below the mark
+        };
+
+    private:
+        std::vector<DataType> entries;
+        std::vector<size_t> marks; // sizes, in increasing order
+
+    public:
+        /**
+         * @brief Adds an element on top
+         * @note Time complexity: O(1) amortized
+         */
+        void push(const DataType &data) { entries.push_back(data); }
+
+        /**
+         * @brief Removes the top element
+         * @note Time complexity: O(1)
+         * @throws std::underflow_error when the stack is empty
+         * @throws std::logic_error when the top is below the newest mark
+         */
+        void pop()
+        {
+            if (entries.empty())
+            {
+                throw std::underflow_error("TrailStack: Stack is empty!");
+            }
+            if (!marks.empty() && marks.back() == entries.size())
+            {
+                throw std::logic_error("TrailStack: Cannot pop below a mark!");
+            }
+
+            entries.pop_back();
+        }
+
+        /**
+         * @brief Returns the top element
+         * @throws std::underflow_error when the stack is empty
+         */
+        const DataType &top() const
+        {
+            if (entries.empty())
+            {
+                throw std::underflow_error("TrailStack: Stack is empty!");
+            }
+
+            return entries.back();
+        }
+
+        /**
+         * @brief Remembers the current top; marks taken later are nested in it
+         * @note Time complexity: O(1) amortized
+         */
+        Mark mark()
+        {
+            marks.push_back(entries.size());
+            return Mark(marks.size() - 1, entries.size());
+        }
+
+        /**
+         * @brief Drops every element pushed after the mark and every mark
+         * nested in it. The mark stays valid, so the next branch can be tried
+         * and rolled back to it again.
+         * @note Time complexity: O(1) amortized - each element is destroyed once
+         * (nothing to do for trivially destructible types)
+         * @throws std::logic_error for a mark which is no longer valid
+         */
+        void rollback(const Mark &mark)
+        {
+            validate(mark);
+            marks.resize(mark.level + 1);
+            entries.erase(entries.begin() + mark.size, entries.end());
+        }
+
+        /**
+         * @brief Like rollback(mark), but first hands every dropped element to
+         * undo, newest first
+         * @note Time complexity: O(dropped elements)
+         */
+        template <typename Visitor>
+        void rollback(const Mark &mark, Visitor undo)
+        {
+            validate(mark);
+            for (size_t i = entries.size(); i > mark.size; i--)
+                undo(entries[i - 1]);
+
+            marks.resize(mark.level + 1);
+            entries.erase(entries.begin() + mark.size, entries.end());
+        }
+
+        /**
+         * @brief Forgets the mark and the marks nested in it, keeping the
+         * elements - the branch was committed
+         * @note Time complexity: O(1)
+         * @throws std::logic_error for a mark which is no longer valid
+         */
+        void release(const Mark &mark)
+        {
+            validate(mark);
+            marks.resize(mark.level);
+        }
+
+        /**
+         * @brief Returns the number of elements pushed after the mark
+         * @throws std::logic_error for a mark which is no longer valid
+         */
+        size_t sizeAbove(const Mark &mark) const
+        {
+            validate(mark);
+            return entries.size() - mark.size;
+        }
+
+        /**
+         * @brief Returns the number of marks in effect
+         */
+        size_t depth() const { return marks.size(); }
+
+        /**
+         * @brief Returns the number of elements
+         */
+        size_t size() const { return entries.size(); }
+
+        /**
+         * @brief Checks if the stack is empty
+         */
+        bool isEmpty() const { return entries.empty(); }
+
+        /**
+         * @brief Removes every element and every mark, keeping the buffer
+         */
+        void clear()
+        {
+            entries.clear();
+            marks.clear();
+        }
+
+        //
+        /* Helpers */
+    private:
+        void validate(const Mark &mark) const
+        {
+            if (mark.level >= marks.size() || marks[mark.level] != mark.size)
+            {
+                throw std::logic_error("TrailStack: The mark is no longer valid!");
+            }
+        }
+    };
+} // namespace ds
+
+#endif // TRAIL_STACK_HPP_GUARD_
@@ -0,0 +1,82 @@
+// Depth-first search over a complete binary tree, as a backtracking solver
+// would do it: every node records a few trail entries, leaving a node undoes
+// them. ds::Stack pops the entries one by one against TrailStack rolling back
+// to a mark, with and without an undo visitor.
+//
+// g++ -std=c++17 -O2 trail_stack_bench.cpp -o trail_stack_bench
+
+#include <chrono>
+#include <iostream>
+
+#include "../StackLinked/stack_linked.hpp"
+#include "trail_stack.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+static const int DEPTH = 20;
+static const int ENTRIES_PER_NODE = 8;
+
+static long long checksum = 0;
+
+static void searchStack(ds::Stack<long long> &trail, int depth)
+{
+    unsigned int entered = trail.size();
+    for (int i = 0; i < ENTRIES_PER_NODE; i++)
+        trail.push(depth * 31 + i);
+
+    if (depth < DEPTH)
+    {
+        searchStack(trail, depth + 1);
+        searchStack(trail, depth + 1);
+    }
+
+    while (trail.size() > entered)
+        checksum += trail.pop();
+}
+
+template <bool UNDO>
+static void searchTrail(ds::TrailStack<long long> &trail, int depth)
+{
+    auto mark = trail.mark();
+    for (int i = 0; i < ENTRIES_PER_NODE; i++)
+        trail.push(depth * 31 + i);
+
+    if (depth < DEPTH)
+    {
+        searchTrail<UNDO>(trail, depth + 1);
+        searchTrail<UNDO>(trail, depth + 1);
+    }
+
+    if (UNDO)
+        trail.rollback(mark, [](long long entry)
+                       { checksum += entry; });
+    else
+        trail.rollback(mark);
+    trail.release(mark);
+}
+
+template <typename Search>
+static void measure(const char *name, Search search)
+{
+    auto start = Clock::now();
+    search();
+    double total = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+
+    double entries = (double)((2 << DEPTH) - 1) * ENTRIES_PER_NODE;
+    std::cout << name << ": " << total / 1e6 << " ms, " << total / entries << " ns/entry\n";
+}
+
+int main()
+{
+    std::cout << "DFS of depth " << DEPTH << ", " << ENTRIES_PER_NODE << " trail entries per node\n";
+
+    measure("ds::Stack, pop per entry ", []
+            { ds::Stack<long long> trail; searchStack(trail, 0); });
+    measure("TrailStack, rollback     ", []
+            { ds::TrailStack<long long> trail; searchTrail<false>(trail, 0); });
+    measure("TrailStack, rollback+undo", []
+            { ds::TrailStack<long long> trail; searchTrail<true>(trail, 0); });
+
+    std::cout << "(checksum " << checksum << ")\n";
+    return 0;
+}
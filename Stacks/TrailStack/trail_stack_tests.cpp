@@ -0,0 +1,171 @@
+#define CATCH_CONFIG_MAIN
+#include "../../Catch2/catch.hpp"
+#include "trail_stack.hpp"
+
+#include <string>
+#include <vector>
+
+using namespace ds;
+
+TEST_CASE("PUSH AND POP", "[PUSH][POP][TOP]")
+{
+    TrailStack<int> trail;
+
+    REQUIRE(trail.isEmpty());
+    REQUIRE_THROWS_AS(trail.pop(), std::underflow_error);
+    REQUIRE_THROWS_AS(trail.top(), std::underflow_error);
+
+    for (int i = 0; i < 100; i++)
+        trail.push(i);
+
+    REQUIRE(trail.size() == 100);
+    REQUIRE(trail.top() == 99);
+
+    trail.pop();
+    REQUIRE(trail.top() == 98);
+
+    SECTION("NOT BELOW A MARK")
+    {
+        auto mark = trail.mark();
+        REQUIRE_THROWS_AS(trail.pop(), std::logic_error);
+
+        trail.push(1);
+        trail.pop();
+        REQUIRE(trail.size() == 99);
+
+        trail.release(mark);
+        trail.pop();
+        REQUIRE(trail.size() == 98);
+    }
+}
+
+TEST_CASE("MARKS", "[MARK][ROLLBACK][RELEASE]")
+{
+    TrailStack<std::string> trail;
+    trail.push("base");
+
+    SECTION("ROLLBACK")
+    {
+        auto mark = trail.mark();
+        trail.push("a");
+        trail.push("b");
+        REQUIRE(trail.sizeAbove(mark) == 2);
+
+        trail.rollback(mark);
+        REQUIRE(trail.size() == 1);
+        REQUIRE(trail.top() == "base");
+
+        // Still valid - try another branch
+        trail.push("c");
+        trail.rollback(mark);
+        REQUIRE(trail.size() == 1);
+        REQUIRE(trail.depth() == 1);
+    }
+
+    SECTION("NESTED")
+    {
+        auto outer = trail.mark();
+        trail.push("a");
+        auto inner = trail.mark();
+        trail.push("b");
+        auto innermost = trail.mark();
+        trail.push("c");
+        REQUIRE(trail.depth() == 3);
+
+        trail.rollback(inner);
+        REQUIRE(trail.size() == 2);
+        REQUIRE(trail.top() == "a");
+        REQUIRE(trail.depth() == 2);
+        REQUIRE_THROWS_AS(trail.rollback(innermost), std::logic_error);
+
+        trail.rollback(outer);
+        REQUIRE(trail.size() == 1);
+        REQUIRE_THROWS_AS(trail.rollback(inner), std::logic_error);
+    }
+
+    SECTION("RELEASE")
+    {
+        auto outer = trail.mark();
+        trail.push("a");
+        auto inner = trail.mark();
+        trail.push("b");
+
+        trail.release(inner);
+        REQUIRE(trail.depth() == 1);
+        REQUIRE(trail.size() == 3);
+        REQUIRE_THROWS_AS(trail.rollback(inner), std::logic_error);
+
+        trail.rollback(outer);
+        REQUIRE(trail.size() == 1);
+    }
+
+    SECTION("STALE MARK AT THE SAME LEVEL")
+    {
+        auto first = trail.mark();
+        trail.push("a");
+        trail.release(first);
+
+        auto second = trail.mark();
+        REQUIRE_THROWS_AS(trail.rollback(first), std::logic_error);
+        REQUIRE_NOTHROW(trail.rollback(second));
+    }
+}
+
+TEST_CASE("UNDO", "[ROLLBACK]")
+{
+    // Trail of (variable, old value) pairs, as a solver would keep it
+    std::vector<int> values(4, 0);
+    TrailStack<std::pair<int, int>> trail;
+
+    auto assign = [&](int variable, int value)
+    {
+        trail.push({variable, values[variable]});
+        values[variable] = value;
+    };
+    auto undo = [&](const std::pair<int, int> &entry)
+    { values[entry.first] = entry.second; };
+
+    assign(0, 5);
+    auto root = trail.mark();
+    assign(1, 7);
+    assign(1, 8); // assigned twice - the first old value must win
+    auto branch = trail.mark();
+    assign(2, 9);
+    assign(0, 6);
+
+    trail.rollback(branch, undo);
+    REQUIRE(values == std::vector<int>{5, 8, 0, 0});
+
+    trail.rollback(root, undo);
+    REQUIRE(values == std::vector<int>{5, 0, 0, 0});
+    REQUIRE(trail.size() == 1);
+}
+
+TEST_CASE("NOT DEFAULT CONSTRUCTIBLE", "[ROLLBACK]")
+{
+    // An undo record is made from the variable it restores
+    struct Assignment
+    {
+        explicit Assignment(int &variable) : variable(&variable), old(variable) {}
+
+        int *variable;
+        int old;
+    };
+
+    int x = 1, y = 2;
+    TrailStack<Assignment> trail;
+    auto root = trail.mark();
+    trail.push(Assignment(x));
+    x = 10;
+    auto branch = trail.mark();
+    trail.push(Assignment(y));
+    y = 20;
+
+    trail.rollback(branch, [](const Assignment &entry)
+                   { *entry.variable = entry.old; });
+    REQUIRE(y == 2);
+    REQUIRE(x == 10);
+
+    trail.rollback(root);
+    REQUIRE(trail.size() == 0);
+}
@@ -0,0 +1,307 @@
+/**
+ * @file timing_wheel.hpp
+ * @author Ivan Penev
+ * @brief Hierarchical timing wheel - timer queue with O(1) schedule/cancel
+ * @date 2026-10-18
+ *
+ * Level 0 has one slot per tick, every slot of level L covers the whole
+ * level L - 1 (slots^L ticks). A timer goes to the lowest level whose range
+ * covers its deadline. When the lower level wraps around, the next slot of
+ * the level above is cascaded: its timers are re-inserted closer to the
+ * bottom. A timer is therefore moved at most `levels` times, and a timer which
+ * is cancelled before it fires (the common case for timeouts) costs two list
+ * operations.
+ *
+ * Timers are intrusive - the caller owns them, usually as a member or a base
+ * of its connection/request object:
+ *
+ *     struct Connection : ds::Timer { ... };
+ *
+ *     ds::TimingWheel wheel(1'000'000); // 1 ms ticks, time in ns
+ *     wheel.schedule(conn, now + timeout);
+ *     wheel.cancel(conn);
+ *     wheel.advance(now, expired);      // expired timers are appended
+ */
+
+#ifndef TIMING_WHEEL_HPP_GUARD_
+#define TIMING_WHEEL_HPP_GUARD_
+
+#include <cassert>   // Used to validate invariants
+#include <cstdint>
+#include <stdexcept> // Exception handling
+#include <vector>
+
+namespace ds
+{
+    class TimingWheel;
+
+    /**
+     * @brief Intrusive doubly linked list hook
+     */
+    struct TimerLink
+    {
+        TimerLink *prev = this;
+        TimerLink *next = this;
+
+        void unlink()
+        {
+            prev->next = next;
+            next->prev = prev;
+            prev = next = this;
+        }
+
+        void pushBack(TimerLink *node)
+        {
+            node->prev = prev;
+            node->next = this;
+            prev->next = node;
+            prev = node;
+        }
+
+        bool empty() const { return next == this; }
+    };
+
+    /**
+     * @brief A timer owned by the caller. Destroying an armed timer cancels it.
+     */
+    class Timer : private TimerLink
+    {
+    public:
+        Timer() = default;
+        Timer(const Timer &) = delete;
+        Timer &operator=(const Timer &) = delete;
+
+        inline ~Timer();
+
+        /**
+         * @brief Checks whether the timer is scheduled
+         */
+        bool armed() const { return wheel != nullptr; }
+
+        /**
+         * @brief Returns the deadline the timer was scheduled for
+         */
+        uint64_t deadline() const { return when; }
+
+    private:
+        friend TimingWheel;
+
+        static Timer *from(TimerLink *link) { return static_cast<Timer *>(link); }
+
+        TimingWheel *wheel = nullptr;
+        uint64_t when = 0;     // deadline in time units
+        uint64_t whenTick = 0; // deadline in ticks
+    };
+
+    class TimingWheel
+    {
+    public:
+        /**
+         * @brief Constructs a new timing wheel
+         *
+         * @param tick - time units per tick (timers fire with this resolution, never early)
+         * @param levels - number of wheels
+         * @param slotBits - log2 of the slots per wheel. The wheels cover
+         * 2^(levels * slotBits) ticks; later deadlines wait in the top level.
+         * @param start - the current time
+         * @throws std::invalid_argument for an invalid configuration
+         */
+        explicit TimingWheel(uint64_t tick, unsigned levels = 4, unsigned slotBits = 8, uint64_t start = 0)
+            : tick(tick), levels(levels), bits(slotBits), mask((1u << slotBits) - 1)
+        {
+            if (tick == 0 || levels == 0 || slotBits == 0 || slotBits > 16 || levels * slotBits > 63)
+            {
+                throw std::invalid_argument("TimingWheel: Invalid configuration!");
+            }
+
+            slots = std::vector<TimerLink>((size_t)levels << slotBits);
+            current = start / tick;
+        }
+
+        TimingWheel(const TimingWheel &) = delete;
+        TimingWheel &operator=(const TimingWheel &) = delete;
+
+        /**
+         * @brief Disarms the remaining timers
+         */
+        ~TimingWheel()
+        {
+            for (TimerLink &head : slots)
+            {
+                while (!head.empty())
+                {
+                    Timer *timer = Timer::from(head.next);
+                    head.next->unlink();
+                    timer->wheel = nullptr;
+                }
+            }
+        }
+
+        /**
+         * @brief Arms (or re-arms) a timer
+         * @note Time complexity: O(1)
+         *
+         * @param deadline - absolute time in the same units as advance();
+         * deadlines in the past fire on the next tick
+         */
+        void schedule(Timer &timer, uint64_t deadline)
+        {
+            if (timer.wheel)
+                timer.wheel->cancel(timer); // possibly armed in another wheel
+
+            timer.wheel = this;
+            timer.when = deadline;
+            timer.whenTick = (deadline + tick - 1) / tick; // round up - never fire early
+            if (timer.whenTick <= current)
+                timer.whenTick = current + 1;
+
+            place(timer);
+            ++count;
+        }
+
+        /**
+         * @brief Disarms a timer. Does nothing if it is not armed.
+         * @note Time complexity: O(1)
+         */
+        void cancel(Timer &timer)
+        {
+            if (timer.wheel != this)
+                return;
+
+            timer.unlink();
+            timer.wheel = nullptr;
+            --count;
+        }
+
+        /**
+         * @brief Moves the time forward and collects the timers whose
+         * deadline has passed, in deadline order (by tick)
+         * @note Time complexity: O(ticks passed + timers moved); a jump over
+         * an empty wheel is O(1)
+         *
+         * @param now - the current time, must not go backwards
+         * @param expired - the expired (now disarmed) timers are appended here
+         * @return size_t - number of expired timers
+         */
+        size_t advance(uint64_t now, std::vector<Timer *> &expired)
+        {
+            const uint64_t target = now / tick;
+            const size_t before = expired.size();
+
+            while (current < target)
+            {
+                if (count == 0)
+                {
+                    current = target;
+                    break;
+                }
+
+                ++current;
+                cascade(1);
+
+                TimerLink &due = slot(0, current & mask);
+                while (!due.empty())
+                {
+                    Timer *timer = Timer::from(due.next);
+                    assert(timer->whenTick == current);
+
+                    timer->unlink();
+                    timer->wheel = nullptr;
+                    --count;
+                    expired.push_back(timer);
+                }
+            }
+
+            return expired.size() - before;
+        }
+
+        /**
+         * @brief Returns the number of armed timers
+         */
+        size_t size() const { return count; }
+
+        /**
+         * @brief Checks if no timer is armed
+         */
+        bool isEmpty() const { return count == 0; }
+
+        /**
+         * @brief Returns the current time rounded down to a tick
+         */
+        uint64_t now() const { return current * tick; }
+
+        //
+        /* Helpers */
+    private:
+        TimerLink &slot(unsigned level, uint64_t index)
+        {
+            return slots[((size_t)level << bits) + index];
+        }
+
+        /**
+         * @brief Puts a timer in the lowest level whose range covers it
+         */
+        void place(Timer &timer)
+        {
+            uint64_t delta = timer.whenTick - current;
+
+            unsigned level = 0;
+            while (level + 1 < levels && delta >> (bits * (level + 1)))
+                ++level;
+
+            uint64_t at = timer.whenTick;
+            if (delta >> (bits * (level + 1)))
+            {
+                // Too far even for the top level - park it in the furthest
+                // slot, it is re-placed when that slot is cascaded
+                at = current + ((uint64_t)mask << (bits * level));
+            }
+
+            slot(level, (at >> (bits * level)) & mask).pushBack(&timer);
+        }
+
+        /**
+         * @brief When the levels below wrapped around, re-places the timers of
+         * the slot of the given level which has just become current
+         */
+        void cascade(unsigned level)
+        {
+            if (level >= levels || (current & (((uint64_t)1 << (bits * level)) - 1)) != 0)
+                return;
+
+            // Upper levels first - they may drop timers into this one
+            cascade(level + 1);
+
+            TimerLink &head = slot(level, (current >> (bits * level)) & mask);
+            TimerLink moved;
+            while (!head.empty())
+            {
+                TimerLink *node = head.next;
+                node->unlink();
+                moved.pushBack(node);
+            }
+
+            while (!moved.empty())
+            {
+                Timer *timer = Timer::from(moved.next);
+                timer->unlink();
+                place(*timer);
+            }
+        }
+
+        const uint64_t tick;
+        const unsigned levels, bits, mask;
+
+        std::vector<TimerLink> slots; // levels x (mask + 1) list heads
+        uint64_t current;             // the current tick
+        size_t count = 0;
+    };
+
+    inline Timer::~Timer()
+    {
+        if (wheel)
+            wheel->cancel(*this);
+    }
+} // namespace ds
+
+#endif // TIMING_WHEEL_HPP_GUARD_
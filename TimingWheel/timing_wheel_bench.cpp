@@ -0,0 +1,90 @@
+// Timer queue workload: arm N timeouts, cancel most of them before they fire,
+// then let time run until the rest expires. Compares TimingWheel with a
+// BinaryHeap keyed by deadline where cancellation is lazy (the entry stays
+// in the heap and is skipped when it reaches the top).
+//
+// g++ -std=c++17 -O2 timing_wheel_bench.cpp -o timing_wheel_bench
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "../Heap/binary_heap.hpp"
+#include "timing_wheel.hpp"
+
+using Entry = std::pair<uint64_t, unsigned>; // (deadline, timer id)
+
+template <typename Work>
+double nsPerTimer(size_t timers, Work work)
+{
+    auto start = std::chrono::steady_clock::now();
+    work();
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / timers;
+}
+
+int main()
+{
+    const size_t N = 2000000;
+    const uint64_t TICK = 1000000; // 1 ms in ns
+    const uint64_t HORIZON = 30ull * 1000 * TICK;
+
+    for (int cancelPercent : {0, 50, 90, 99})
+    {
+        std::mt19937_64 rng(cancelPercent);
+        std::vector<uint64_t> deadlines(N);
+        std::vector<bool> cancelled(N);
+        for (size_t i = 0; i < N; i++)
+        {
+            deadlines[i] = rng() % HORIZON;
+            cancelled[i] = (int)(rng() % 100) < cancelPercent;
+        }
+
+        size_t firedWheel = 0, firedHeap = 0;
+
+        double wheelNs = nsPerTimer(N, [&]
+                                    {
+                                        ds::TimingWheel wheel(TICK, 4, 8);
+                                        std::vector<ds::Timer> timers(N);
+                                        for (size_t i = 0; i < N; i++)
+                                            wheel.schedule(timers[i], deadlines[i]);
+                                        for (size_t i = 0; i < N; i++)
+                                            if (cancelled[i])
+                                                wheel.cancel(timers[i]);
+
+                                        std::vector<ds::Timer *> expired;
+                                        for (uint64_t now = 0; !wheel.isEmpty(); now += 10 * TICK)
+                                        {
+                                            expired.clear();
+                                            firedWheel += wheel.advance(now, expired);
+                                        } });
+
+        double heapNs = nsPerTimer(N, [&]
+                                   {
+                                       ds::BinaryHeap<Entry> heap(ds::BinaryHeap<Entry>::less);
+                                       std::vector<bool> dead(N);
+                                       for (size_t i = 0; i < N; i++)
+                                           heap.push({deadlines[i], (unsigned)i});
+                                       for (size_t i = 0; i < N; i++)
+                                           if (cancelled[i])
+                                               dead[i] = true;
+
+                                       for (uint64_t now = 0; heap.size() > 0; now += 10 * TICK)
+                                       {
+                                           while (heap.size() > 0 && heap.top().first <= now)
+                                           {
+                                               firedHeap += !dead[heap.top().second];
+                                               heap.pop();
+                                           }
+                                       } });
+
+        std::cout << "cancelled " << cancelPercent << "%"
+                  << "\tTimingWheel: " << wheelNs << " ns/timer"
+                  << "\tBinaryHeap: " << heapNs << " ns/timer"
+                  << "\t(fired " << firedWheel << " / " << firedHeap << ")" << std::endl;
+    }
+
+    return 0;
+}
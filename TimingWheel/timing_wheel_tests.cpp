@@ -0,0 +1,152 @@
+#define CATCH_CONFIG_MAIN
+#include "../Catch2/catch.hpp"
+#include "timing_wheel.hpp"
+
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace ds;
+
+struct Connection : Timer
+{
+    int id = 0;
+};
+
+TEST_CASE("CONSTRUCTOR", "[DEFAULT]")
+{
+    TimingWheel wheel(10);
+
+    REQUIRE(wheel.isEmpty());
+    REQUIRE(wheel.now() == 0);
+    REQUIRE_THROWS(TimingWheel(0));
+    REQUIRE_THROWS(TimingWheel(1, 8, 9)); // 72 bits
+}
+
+TEST_CASE("ABSTRACT OPERATIONS", "[SCHEDULE][CANCEL][ADVANCE]")
+{
+    TimingWheel wheel(10, 3, 4); // 16 slots per level, 4096 ticks range
+    std::vector<Timer *> expired;
+
+    SECTION("FIRES ON TIME, NEVER EARLY")
+    {
+        Connection a, b;
+        wheel.schedule(a, 95); // rounds up to tick 10
+        wheel.schedule(b, 30);
+        REQUIRE(wheel.size() == 2);
+        REQUIRE(a.armed());
+
+        REQUIRE(wheel.advance(29, expired) == 0);
+        REQUIRE(wheel.advance(30, expired) == 1);
+        REQUIRE(expired.back() == &b);
+        REQUIRE_FALSE(b.armed());
+
+        REQUIRE(wheel.advance(99, expired) == 0);
+        REQUIRE(wheel.advance(100, expired) == 1);
+        REQUIRE(expired.back() == &a);
+        REQUIRE(wheel.isEmpty());
+    }
+
+    SECTION("CANCEL")
+    {
+        Connection a;
+        wheel.schedule(a, 500);
+        wheel.cancel(a);
+
+        REQUIRE_FALSE(a.armed());
+        REQUIRE(wheel.isEmpty());
+        REQUIRE(wheel.advance(1000, expired) == 0);
+
+        // Cancelling twice is harmless
+        wheel.cancel(a);
+    }
+
+    SECTION("DESTROYED TIMER IS CANCELLED")
+    {
+        {
+            Connection a;
+            wheel.schedule(a, 500);
+        }
+        REQUIRE(wheel.isEmpty());
+    }
+
+    SECTION("RESCHEDULE AND PAST DEADLINES")
+    {
+        Connection a;
+        wheel.advance(100, expired);
+
+        wheel.schedule(a, 1000);
+        wheel.schedule(a, 50); // in the past - next tick
+        REQUIRE(wheel.size() == 1);
+
+        REQUIRE(wheel.advance(110, expired) == 1);
+    }
+
+    SECTION("RESCHEDULE FROM ANOTHER WHEEL")
+    {
+        TimingWheel other(10, 3, 4);
+        Connection a, b;
+        other.schedule(a, 200);
+        other.schedule(b, 300);
+
+        wheel.schedule(a, 100); // moves a out of the other wheel
+        REQUIRE(other.size() == 1);
+        REQUIRE(wheel.size() == 1);
+
+        REQUIRE(other.advance(1000, expired) == 1);
+        REQUIRE(expired.back() == &b);
+        REQUIRE(wheel.advance(100, expired) == 1);
+        REQUIRE(expired.back() == &a);
+        REQUIRE(wheel.isEmpty());
+        REQUIRE(other.isEmpty());
+    }
+
+    SECTION("BEYOND THE RANGE OF THE WHEELS")
+    {
+        Connection a;
+        wheel.schedule(a, 10 * 100000); // far past 4096 ticks
+
+        REQUIRE(wheel.advance(10 * 99999, expired) == 0);
+        REQUIRE(wheel.advance(10 * 100000, expired) == 1);
+    }
+}
+
+TEST_CASE("MATCHES BRUTE FORCE", "[ADVANCE]")
+{
+    const int N = 5000;
+    std::mt19937 rng(9);
+    std::uniform_int_distribution<uint64_t> delay(0, 200000);
+
+    TimingWheel wheel(7, 3, 5);
+    std::vector<std::unique_ptr<Connection>> timers;
+    std::vector<Timer *> expired;
+
+    for (int i = 0; i < N; i++)
+    {
+        timers.emplace_back(new Connection);
+        timers.back()->id = i;
+        wheel.schedule(*timers.back(), delay(rng));
+    }
+    for (int i = 0; i < N; i += 3)
+        wheel.cancel(*timers[i]);
+
+    uint64_t now = 0, previousTick = 0;
+    while (!wheel.isEmpty())
+    {
+        now += 1 + delay(rng) % 500;
+        expired.clear();
+        wheel.advance(now, expired);
+
+        for (Timer *t : expired)
+        {
+            Connection *c = static_cast<Connection *>(t);
+            REQUIRE(c->id % 3 != 0);
+            REQUIRE(c->deadline() <= now);
+            REQUIRE(c->deadline() + 7 > previousTick * 7); // not overdue by more than a tick
+        }
+        previousTick = now / 7;
+    }
+
+    for (auto &t : timers)
+        REQUIRE_FALSE(t->armed());
+}